@@ -3,8 +3,12 @@ import { writable } from 'svelte/store';
 const socketEvents = ['open', 'close', 'error', 'message', 'unresponsive'] as const;
 type SocketEvent = (typeof socketEvents)[number];
 
+// Rate limit requested from the device, newer frames replace held back ones
+export type SubscribeOptions = { interval?: number; max_rate?: number };
+
 function createWebSocket() {
 	let listeners = new Map<string, Set<(data?: unknown) => void>>();
+	let subscribeOptions = new Map<string, SubscribeOptions>();
 	const { subscribe, set } = writable(false);
 	const reconnectTimeoutTime = 5000;
 	let unresponsiveTimeoutId: number;
@@ -44,6 +48,10 @@ function createWebSocket() {
 				listeners.get('binary')?.forEach((listener) => listener(data));
 				return;
 			}
+			if (data === '3') {
+				ws.send('4'); // answer the device's keepalive ping
+				return;
+			}
 			data = data.substring(1);
 
 			if (!data) return;
@@ -71,6 +79,7 @@ function createWebSocket() {
 			eventListeners?.delete(listener);
 		} else {
 			listeners.delete(event);
+			subscribeOptions.delete(event);
 		}
 	}
 
@@ -91,21 +100,29 @@ function createWebSocket() {
 
 	function subscribeToEvent(event: string) {
 		if (!ws || ws.readyState !== WebSocket.OPEN) return;
-		ws.send('0/' + event);
+		const options = subscribeOptions.get(event);
+		ws.send('0/' + event + (options ? `[${JSON.stringify(options)}]` : ''));
 	}
 
 	return {
 		subscribe,
 		sendEvent,
 		init,
-		on: <T>(event: string, listener: (data: T) => void): (() => void) => {
+		on: <T>(
+			event: string,
+			listener: (data: T) => void,
+			options?: SubscribeOptions
+		): (() => void) => {
 			let eventListeners = listeners.get(event);
+			if (options) subscribeOptions.set(event, options);
 			if (!eventListeners) {
 				if (!socketEvents.includes(event as SocketEvent)) {
 					subscribeToEvent(event);
 				}
 				eventListeners = new Set();
 				listeners.set(event, eventListeners);
+			} else if (options) {
+				subscribeToEvent(event); // the device updates the rate of an existing subscription
 			}
 			eventListeners.add(listener as (data: any) => void);
 
@@ -7,6 +7,18 @@ export type Session = {
 
 export type Sessions = Session[];
 
+// [start, distance m, time in wheel s, max speed m/s, average speed m/s], empty buckets are left out
+export type StepBucket = [number, number, number, number, number];
+
+export type StepAggregate = {
+	bucket: number;
+	from: number;
+	to: number;
+	utc_offset: number; // s, buckets start at local time
+	source: 'rollup' | 'raw';
+	buckets: StepBucket[];
+};
+
 export type WifiStatus = {
 	status: number;
 	local_ip: string;
@@ -101,6 +113,14 @@ export type Analytics = {
 	fs_total: number;
 	fs_used: number;
 	uptime: number;
+	event_socket?: Record<string, EventSocketMetrics>;
+};
+
+export type EventSocketMetrics = {
+	emits: number;
+	recipients: number;
+	failed: number;
+	p99_us: number;
 };
 
 export type RSSI = {
@@ -0,0 +1,31 @@
+// Extra GET routes fetched together with the features on startup, per page
+const pageRoutes: Record<string, string[]> = {
+	'/pedometer': ['/api/v1/steps']
+};
+
+const prefetched = new Map<string, unknown>();
+
+// Fetches the features and the routes of the first page in one /api/v1/batch request. Returns what was
+// prefetched, an empty map if the request failed, in which case every route is fetched on its own.
+export const prefetch = async (fetch: typeof window.fetch, pathname: string) => {
+	const paths = ['/api/v1/features', ...(pageRoutes[pathname] ?? [])];
+	try {
+		const response = await fetch(`/api/v1/batch?paths=${paths.join(',')}`);
+		if (!response.ok) throw new Error(`${response.status} ${response.statusText}`);
+		const results: Record<string, unknown> = await response.json();
+		for (const path of paths) {
+			if (results[path] != null) prefetched.set(path, results[path]);
+		}
+	} catch (error) {
+		console.warn('Batch prefetch failed', error);
+		return new Map<string, unknown>();
+	}
+	return prefetched;
+};
+
+// Returns a prefetched result only once, later calls have to fetch fresh data
+export const takePrefetched = <T>(path: string): T | undefined => {
+	const result = prefetched.get(path) as T | undefined;
+	prefetched.delete(path);
+	return result;
+};
@@ -1,11 +1,13 @@
 import type { LayoutLoad } from './$types';
+import { prefetch, takePrefetched } from '$lib/utilities/prefetch';
 
 export const prerender = false;
 export const ssr = false;
 
 export const load = (async ({ fetch }) => {
-	const result = await fetch('/api/v1/features');
-	const item = await result.json();
+	await prefetch(fetch, location.pathname);
+	const item =
+		takePrefetched('/api/v1/features') ?? (await (await fetch('/api/v1/features')).json());
 	return {
 		features: item,
 		title: 'Hammie tracker',
@@ -8,7 +8,7 @@ APSettingsService::APSettingsService()
       _dnsServer(nullptr),
       _lastManaged(0),
       _reconfigureAp(false) {
-    addUpdateHandler([&](const String &originId) { reconfigureAP(); }, false);
+    addUpdateHandler([&](origin_id_t originId) { reconfigureAP(); }, false);
 }
 
 void APSettingsService::begin() {}
@@ -6,7 +6,7 @@
 #include <WiFi.h>
 #include <timing.h>
 
-#define MAX_ESP_ANALYTICS_SIZE 1024
+#define MAX_ESP_ANALYTICS_SIZE 2048
 #define EVENT_ANALYTICS "analytics"
 #define ANALYTICS_INTERVAL 2000
 
@@ -31,8 +31,10 @@ class AnalyticsService {
         doc["fs_used"] = ESPFS.usedBytes();
         doc["fs_total"] = ESPFS.totalBytes();
         doc["core_temp"] = temperatureRead();
+        JsonObject eventSocket = doc["event_socket"].to<JsonObject>();
+        socket.metrics(eventSocket, true);
 
-        serializeJson(doc, message);
+        serializeJson(doc, message, sizeof(message));
         socket.emit(EVENT_ANALYTICS, message);
     }
 };
@@ -19,101 +19,116 @@ void ESP32SvelteKit::begin() {
 
 void ESP32SvelteKit::setupServer() {
     _server->config.max_uri_handlers = _numberEndpoints;
+    connection_manager::begin(_server);
     _server->maxUploadSize = _maxFileUpload;
     _server->listen(_port);
 
-    // Serve static resources from PROGMEM
-    ESP_LOGV(TAG, "Registering routes from PROGMEM static resources");
-    WWWData::registerRoutes([&](const String &uri, const String &contentType, const uint8_t *content, size_t len) {
-        PsychicHttpRequestCallback requestHandler = [contentType, content, len](PsychicRequest *request) {
-            PsychicResponse response(request);
-            response.setCode(200);
-            response.setContentType(contentType.c_str());
-            response.addHeader("Content-Encoding", "gzip");
-            response.addHeader("Cache-Control", "public, immutable, max-age=31536000");
-            response.setContent(content, len);
+    // Serve static resources from PROGMEM through the default end-point, which handles every request no route
+    // matches. Assets are found in the generated perfect hash table, anything else gets index.html for the SPA.
+    ESP_LOGV(TAG, "Serving %u static resources from PROGMEM", WWWData::assetCount);
+    _server->defaultEndpoint->setHandler(&_staticHandler);
+    _staticHandler.onRequest(connection_manager::timed("/*", HTTP_GET, [](PsychicRequest *request) {
+        const String &uri = request->uri();
+        int query = uri.indexOf('?');
+        const WWWAsset *asset = WWWData::find(uri.c_str(), query < 0 ? uri.length() : query);
+        if (!asset) asset = WWWData::find("/index.html", strlen("/index.html"));
+        if (!asset) return request->reply(404);
+
+        // the app's file names carry no content hash, so every file is revalidated and costs a 304 when unchanged
+        bool brotli = asset->brotli && request->header("Accept-Encoding").indexOf("br") >= 0;
+        const char *etag = brotli ? asset->brotliEtag : asset->etag;
+        PsychicResponse response(request);
+        response.addHeader("ETag", etag);
+        response.addHeader("Cache-Control", "no-cache");
+        response.addHeader("Vary", "Accept-Encoding");
+        if (request->hasHeader("If-None-Match") && request->header("If-None-Match").indexOf(etag) >= 0) {
+            response.setCode(304);
             return response.send();
-        };
-        PsychicWebHandler *handler = new PsychicWebHandler();
-        handler->onRequest(requestHandler);
-        _server->on(uri.c_str(), HTTP_GET, handler);
-
-        // Set default end-point for all non matching requests
-        // this is easier than using webServer.onNotFound()
-        if (uri.equals("/index.html")) {
-            _server->defaultEndpoint->setHandler(handler);
         }
-    });
+
+        response.setCode(200);
+        response.setContentType(asset->contentType);
+        response.addHeader("Content-Encoding", brotli ? "br" : "gzip");
+        response.setContent(brotli ? asset->brotli : asset->content, brotli ? asset->brotliLen : asset->len);
+        return response.send();
+    }));
 
     // SYSTEM
-    _server->on("/api/v1/system/reset", HTTP_POST, system_service::handleReset);
-    _server->on("/api/v1/system/restart", HTTP_POST, system_service::handleRestart);
-    _server->on("/api/v1/system/sleep", HTTP_POST, system_service::handleSleep);
-    _server->on("/api/v1/system/status", HTTP_GET, system_service::getStatus);
-    _server->on("/api/v1/system/metrics", HTTP_GET, system_service::getMetrics);
+    on("/api/v1/system/reset", HTTP_POST, system_service::handleReset);
+    on("/api/v1/system/restart", HTTP_POST, system_service::handleRestart);
+    on("/api/v1/system/sleep", HTTP_POST, system_service::handleSleep);
+    onRead("/api/v1/system/status", system_service::status);
+    onRead("/api/v1/system/metrics", system_service::metrics);
 
     // WIFI
-    _server->on("/api/v1/wifi/scan", HTTP_POST, wifi_sta::handleScan);
-    _server->on("/api/v1/wifi/networks", HTTP_GET, wifi_sta::getNetworks);
-    _server->on("/api/v1/wifi/sta/status", HTTP_GET, wifi_sta::getNetworkStatus);
-    _server->on("/api/v1/wifi/sta/settings", HTTP_GET,
-                [this](PsychicRequest *request) { return _wifiSettingsService.endpoint.getState(request); });
-    _server->on("/api/v1/wifi/sta/settings", HTTP_POST, [this](PsychicRequest *request, JsonVariant &json) {
-        return _wifiSettingsService.endpoint.handleStateUpdate(request, json);
+    on("/api/v1/wifi/scan", HTTP_POST, wifi_sta::handleScan);
+    on("/api/v1/wifi/networks", HTTP_GET, wifi_sta::getNetworks);
+    onRead("/api/v1/wifi/sta/status", wifi_sta::networkStatus);
+    on("/api/v1/wifi/sta/settings", HTTP_GET,
+       [this](PsychicRequest *request) { return _wifiSettingsService.endpoint.getState(request); });
+    onBody("/api/v1/wifi/sta/settings", HTTP_POST, [this](PsychicRequest *r, const uint8_t *body, size_t len) {
+        return _wifiSettingsService.endpoint.handleStateUpdate(r, body, len);
     });
 
     // AP
-    _server->on("/api/v1/wifi/ap/status", HTTP_GET,
-                [this](PsychicRequest *r) { return _apSettingsService.getStatus(r); });
-    _server->on("/api/v1/wifi/ap/settings", HTTP_GET,
-                [this](PsychicRequest *request) { return _apSettingsService.endpoint.getState(request); });
-    _server->on("/api/v1/wifi/ap/settings", HTTP_POST, [this](PsychicRequest *request, JsonVariant &json) {
-        return _apSettingsService.endpoint.handleStateUpdate(request, json);
+    on("/api/v1/wifi/ap/status", HTTP_GET, [this](PsychicRequest *r) { return _apSettingsService.getStatus(r); });
+    on("/api/v1/wifi/ap/settings", HTTP_GET,
+       [this](PsychicRequest *request) { return _apSettingsService.endpoint.getState(request); });
+    onBody("/api/v1/wifi/ap/settings", HTTP_POST, [this](PsychicRequest *r, const uint8_t *body, size_t len) {
+        return _apSettingsService.endpoint.handleStateUpdate(r, body, len);
     });
 
 // NTP
 #if FT_ENABLED(USE_NTP)
-    _server->on("/api/v1/ntp/status", HTTP_GET, [this](PsychicRequest *r) { return _ntpSettingsService.getStatus(r); });
-    _server->on("/api/v1/ntp/time", HTTP_POST,
-                [this](PsychicRequest *r, JsonVariant &json) { return _ntpSettingsService.handleTime(r, json); });
-    _server->on("/api/v1/ntp/settings", HTTP_GET,
-                [this](PsychicRequest *request) { return _ntpSettingsService.endpoint.getState(request); });
-    _server->on("/api/v1/ntp/settings", HTTP_POST, [this](PsychicRequest *request, JsonVariant &json) {
-        return _ntpSettingsService.endpoint.handleStateUpdate(request, json);
+    on("/api/v1/ntp/status", HTTP_GET, [this](PsychicRequest *r) { return _ntpSettingsService.getStatus(r); });
+    on("/api/v1/ntp/time", HTTP_POST,
+       [this](PsychicRequest *r, JsonVariant &json) { return _ntpSettingsService.handleTime(r, json); });
+    on("/api/v1/ntp/settings", HTTP_GET,
+       [this](PsychicRequest *request) { return _ntpSettingsService.endpoint.getState(request); });
+    onBody("/api/v1/ntp/settings", HTTP_POST, [this](PsychicRequest *r, const uint8_t *body, size_t len) {
+        return _ntpSettingsService.endpoint.handleStateUpdate(r, body, len);
     });
 #endif
 
     // FILESYSTEM
-    _server->on("/api/files", HTTP_GET, FileSystem::getFiles);
-    _server->on("/api/files/delete", HTTP_POST, FileSystem::handleDelete);
+    on("/api/files", HTTP_GET, FileSystem::getFiles);
+    on("/api/files/delete", HTTP_POST, FileSystem::handleDelete);
     _server->on("/api/files/upload/*", HTTP_POST, FileSystem::uploadHandler);
-    _server->on("/api/files/edit", HTTP_POST, FileSystem::handleEdit);
+    on("/api/files/edit", HTTP_POST, FileSystem::handleEdit);
 
     // MISC
-    _server->on("/api/v1/features", HTTP_GET, feature_service::getFeatures);
+    onRead("/api/v1/features", feature_service::features);
+    on("/api/v1/batch", HTTP_GET, batch_service::handleBatch);
     _server->on("/api/v1/ws/events", socket.getHandler());
+    _server->on("/api/v1/events", HTTP_GET, socket.getEventSourceHandler());
     _server->on("/api/v1/firmware", HTTP_POST, _uploadFirmwareService.getHandler());
 
     // FIRMWARE
 #if FT_ENABLED(USE_DOWNLOAD_FIRMWARE)
-    _server->on("/api/v1/firmware/download", HTTP_POST, [this](PsychicRequest *r, JsonVariant &json) {
+    on("/api/v1/firmware/download", HTTP_POST, [this](PsychicRequest *r, JsonVariant &json) {
         return _downloadFirmwareService.handleDownloadUpdate(r, json);
     });
 #endif
 
     // MQTT
 #if FT_ENABLED(USE_MQTT)
-    _server->on("/api/v1/mqtt/status", HTTP_GET,
-                [this](PsychicRequest *r) { return _mqttSettingsService.getStatus(r); });
-    _server->on("/api/v1/mqtt/settings", HTTP_GET,
-                [this](PsychicRequest *r) { return _mqttSettingsService.endpoint.getState(r); });
-    _server->on("/api/v1/mqtt/settings", HTTP_POST, [this](PsychicRequest *r, JsonVariant &json) {
-        return _mqttSettingsService.endpoint.handleStateUpdate(r, json);
+    on("/api/v1/mqtt/status", HTTP_GET, [this](PsychicRequest *r) { return _mqttSettingsService.getStatus(r); });
+    on("/api/v1/mqtt/settings", HTTP_GET,
+       [this](PsychicRequest *r) { return _mqttSettingsService.endpoint.getState(r); });
+    onBody("/api/v1/mqtt/settings", HTTP_POST, [this](PsychicRequest *r, const uint8_t *body, size_t len) {
+        return _mqttSettingsService.endpoint.handleStateUpdate(r, body, len);
     });
 #endif
 
     // PEDOMETER
-    _server->on("/api/v1/steps", HTTP_GET, [this](PsychicRequest *r) { return _pedoMeter.endpoint.getState(r); });
+    on("/api/v1/steps", HTTP_GET, [this](PsychicRequest *r) { return _pedoMeter.endpoint.getState(r); });
+    on("/api/v1/steps/aggregate", HTTP_GET, [this](PsychicRequest *r) { return _pedoMeter.getAggregate(r); });
+    on("/api/v1/steps/export", HTTP_GET, [this](PsychicRequest *r) { return _pedoMeter.getExport(r); });
+    on("/api/v1/steps/series", HTTP_GET, [this](PsychicRequest *r) { return _pedoMeter.getSeries(r); });
+    // the reader gets a copy of the totals, so they are written without holding a lock
+    onRead("/api/v1/steps/totals", [this](JsonStreamWriter &json) {
+        _pedoMeter.totals.read([&](PedoMeterTotals &totals) { field_table::streamValue(totals, json); });
+    });
 
     // STATIC CONFIG
 #if SERVE_CONFIG_FILES
@@ -127,6 +142,26 @@ void ESP32SvelteKit::setupServer() {
     DefaultHeaders::Instance().addHeader("Access-Control-Allow-Credentials", "true");
 #endif
     DefaultHeaders::Instance().addHeader("Server", APP_NAME);
+
+    setupBatch();
+}
+
+// Settings which can also be fetched together in one request through /api/v1/batch, they share
+// HttpEndpoint::write with their routes. Routes registered with onRead() are in the batch already.
+void ESP32SvelteKit::setupBatch() {
+    batch_service::add("/api/v1/wifi/sta/settings",
+                       [this](JsonStreamWriter &json) { _wifiSettingsService.endpoint.write(json); });
+    batch_service::add("/api/v1/wifi/ap/settings",
+                       [this](JsonStreamWriter &json) { _apSettingsService.endpoint.write(json); });
+#if FT_ENABLED(USE_NTP)
+    batch_service::add("/api/v1/ntp/settings",
+                       [this](JsonStreamWriter &json) { _ntpSettingsService.endpoint.write(json); });
+#endif
+#if FT_ENABLED(USE_MQTT)
+    batch_service::add("/api/v1/mqtt/settings",
+                       [this](JsonStreamWriter &json) { _mqttSettingsService.endpoint.write(json); });
+#endif
+    batch_service::add("/api/v1/steps", [this](JsonStreamWriter &json) { _pedoMeter.endpoint.write(json); });
 }
 
 void ESP32SvelteKit::setupMDNS() {
@@ -139,6 +174,17 @@ void ESP32SvelteKit::setupMDNS() {
 }
 
 void ESP32SvelteKit::startServices() {
+    // settings handlers persist to the FS and reconfigure the radio, keep that out of the http task
+    update_dispatcher::begin();
+    _apSettingsService.deferUpdateHandlers();
+    _wifiSettingsService.deferUpdateHandlers();
+#if FT_ENABLED(USE_NTP)
+    _ntpSettingsService.deferUpdateHandlers();
+#endif
+#if FT_ENABLED(USE_MQTT)
+    _mqttSettingsService.deferUpdateHandlers();
+#endif
+
     _apSettingsService.begin();
     _wifiSettingsService.begin();
 
@@ -150,6 +196,8 @@ void ESP32SvelteKit::startServices() {
 #endif
 #if FT_ENABLED(USE_MQTT)
     _mqttSettingsService.begin();
+    mqtt_spool::begin(_mqttSettingsService.getMqttClient());
+    _pedoMeter.telemetry.begin(_mqttSettingsService.getMqttClient());
 #endif
     _pedoMeter.begin();
 
@@ -158,14 +206,18 @@ void ESP32SvelteKit::startServices() {
 
 void ESP32SvelteKit::_loop() {
     while (1) {
+        uint32_t start = micros();
         _wifiSettingsService.loop(); // 30 seconds
         _apSettingsService.loop();   // 10 seconds
 #if FT_ENABLED(USE_MQTT)
         _mqttSettingsService.loop(); // 5 seconds
+        mqtt_spool::loop();
 #endif
 #if FT_ENABLED(USE_ANALYTICS)
         _analyticsService.loop();
 #endif
+        socket.loop();
+        system_service::recordLoop(micros() - start);
         vTaskDelay(20 / portTICK_PERIOD_MS);
     }
 }
@@ -8,6 +8,8 @@
 #include <ESPFS.h>
 #include <ESPmDNS.h>
 #include <EventSocket.h>
+#include <batch_service.h>
+#include <connection_manager.h>
 #include <features_service.h>
 #include <MqttSettingsService.h>
 #include <NTPSettingsService.h>
@@ -82,7 +84,9 @@ class ESP32SvelteKit {
 
     String _appName = APP_NAME;
 
-    const u_int16_t _numberEndpoints = 115;
+    PsychicWebHandler _staticHandler;
+
+    const u_int16_t _numberEndpoints = 48;
     const u_int32_t _maxFileUpload = 2300000; // 2.3 MB
     const uint16_t _port = 80;
 
@@ -90,6 +94,22 @@ class ESP32SvelteKit {
     static void _loopImpl(void *_this) { static_cast<ESP32SvelteKit *>(_this)->_loop(); }
     void _loop();
     void setupServer();
+    // Registers a route whose callback is timed by the connection manager
+    template <typename Callback>
+    PsychicEndpoint *on(const char *uri, http_method method, Callback callback) {
+        return _server->on(uri, method, connection_manager::timed(uri, method, callback));
+    }
+    // Registers a timed route whose callback gets the raw body, for requests which may be MessagePack
+    PsychicEndpoint *onBody(const char *uri, http_method method, RawBodyCallback callback) {
+        return _server->on(uri, method, new RawBodyHandler(connection_manager::timed(uri, method, callback)));
+    }
+    // Registers a GET route and its /api/v1/batch entry, both served by the same writer
+    template <typename Reader>
+    PsychicEndpoint *onRead(const char *uri, Reader reader) {
+        batch_service::StreamReader writer = batch_service::add(uri, reader);
+        return on(uri, HTTP_GET, [writer](PsychicRequest *request) { return batch_service::send(request, writer); });
+    }
+    void setupBatch();
     void setupMDNS();
     void startServices();
 };
@@ -13,4 +13,7 @@
 #define MQTT_SETTINGS_FILE "/config/mqttSettings.json"
 #define AP_SETTINGS_FILE "/config/apSettings.json"
 
+// Outside of the config directory, so a factory reset leaves it alone
+#define MQTT_SPOOL_FILE "/mqtt_spool.bin"
+
 #endif
\ No newline at end of file
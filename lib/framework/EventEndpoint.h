@@ -4,6 +4,7 @@
 #include <EventSocket.h>
 #include <PsychicHttp.h>
 #include <StatefulService.h>
+#include <json_pool.h>
 
 template <class T>
 class EventEndpoint {
@@ -11,13 +12,20 @@ class EventEndpoint {
     EventEndpoint(JsonStateReader<T> stateReader, JsonStateUpdater<T> stateUpdater, StatefulService<T> *statefulService,
                   const char *event)
         : _stateReader(stateReader), _stateUpdater(stateUpdater), _statefulService(statefulService), _event(event) {
-        _statefulService->addUpdateHandler([&](const String &originId) { syncState(originId); }, false);
+        _statefulService->addUpdateHandler(
+            [&](origin_id_t originId, field_mask_t fields) {
+                if (fields & _fields) syncState(originId);
+            },
+            false);
     }
 
+    // Only changes to these fields are sent to the clients
+    void setFields(field_mask_t fields) { _fields = fields; }
+
     void begin() {
         socket.onEvent(_event,
                        std::bind(&EventEndpoint::updateState, this, std::placeholders::_1, std::placeholders::_2));
-        socket.onSubscribe(_event, [&](const String &originId) { syncState(originId, true); });
+        socket.onSubscribe(_event, [&](origin_id_t originId, bool sync) { syncState(originId, sync); });
     }
 
   private:
@@ -25,17 +33,18 @@ class EventEndpoint {
     JsonStateUpdater<T> _stateUpdater;
     StatefulService<T> *_statefulService;
     const char *_event;
+    field_mask_t _fields {ALL_FIELDS};
 
-    void updateState(JsonObject &root, int originId) {
-        _statefulService->update(root, _stateUpdater, String(originId));
+    void updateState(JsonObject &root, origin_id_t originId) {
+        _statefulService->update(root, _stateUpdater, originId);
     }
 
-    void syncState(const String &originId, bool sync = false) {
-        JsonDocument jsonDocument;
+    void syncState(origin_id_t originId, bool sync = false) {
+        JsonDocument jsonDocument(json_pool::allocator(json_pool::SITE_EVENT));
         JsonObject root = jsonDocument.to<JsonObject>();
         _statefulService->read(root, _stateReader);
-        JsonObject jsonObject = jsonDocument.as<JsonObject>();
-        socket.emitEvent(_event, jsonObject, originId.c_str(), sync);
+        json_pool::Serialized payload(jsonDocument, json_pool::SITE_EVENT);
+        socket.emit(_event, payload.c_str(), originId, sync);
     }
 };
 
@@ -1,5 +1,7 @@
 #include <EventSocket.h>
 
+#include <json_pool.h>
+
 SemaphoreHandle_t clientSubscriptionsMutex = xSemaphoreCreateMutex();
 
 message_type_t char_to_message_type(char c) {
@@ -14,18 +16,17 @@ message_type_t char_to_message_type(char c) {
     }
 }
 
-const char *getEventName(const char *msg) {
+// Copies the event name of a frame into name, false if it has none or the name doesn't fit
+bool getEventName(const char *msg, char *name, size_t size) {
     const char *start = strchr(msg, '/');
-    if (!start) return nullptr;
+    if (!start) return false;
     start++;
     const char *end = strchr(start, '[');
-    if (!end) return start;
-
-    static char eventName[32];
-    int len = end - start;
-    strncpy(eventName, start, len);
-    eventName[len] = '\0';
-    return eventName;
+    size_t len = end ? end - start : strlen(start);
+    if (len >= size) return false;
+    memcpy(name, start, len);
+    name[len] = '\0';
+    return true;
 }
 
 const char *getEventPayload(const char *msg) {
@@ -42,23 +43,131 @@ const char *getEventPayload(const char *msg) {
     return payload;
 }
 
+// Reads the optional rate limit of a subscription, e.g. 0/analytics[{"interval":5000}] or 0/rssi[{"max_rate":1}]
+uint32_t getSubscriptionInterval(const char *msg) {
+    if (!strchr(msg, '[')) return 0;
+    const char *payload = getEventPayload(msg);
+    if (!payload) return 0;
+
+    uint32_t interval = 0;
+    JsonDocument doc(json_pool::allocator(json_pool::SITE_SOCKET));
+    if (deserializeJson(doc, payload) == DeserializationError::Ok) {
+        if (doc["interval"].is<uint32_t>()) {
+            interval = doc["interval"];
+        } else if (doc["max_rate"].is<float>() && doc["max_rate"].as<float>() > 0) {
+            interval = 1000 / doc["max_rate"].as<float>();
+        }
+    }
+    delete[] payload;
+    return interval;
+}
+
+// Reads a parameter from the query of an uri, e.g. "step,analytics" from /api/v1/events?events=step,analytics
+String getQueryValue(const String &uri, const char *key) {
+    int index = uri.indexOf('?');
+    String prefix = String(key) + "=";
+    while (index >= 0) {
+        if (uri.startsWith(prefix, index + 1)) {
+            int end = uri.indexOf('&', index + 1);
+            return uri.substring(index + 1 + prefix.length(), end < 0 ? uri.length() : end);
+        }
+        index = uri.indexOf('&', index + 1);
+    }
+    return String();
+}
+
 EventSocket::EventSocket() {
     _socket.onOpen((std::bind(&EventSocket::onWSOpen, this, std::placeholders::_1)));
     _socket.onClose(std::bind(&EventSocket::onWSClose, this, std::placeholders::_1));
     _socket.onFrame(std::bind(&EventSocket::onFrame, this, std::placeholders::_1, std::placeholders::_2));
+
+    _eventSource.setFilter(std::bind(&EventSocket::onEventSourceRequest, this, std::placeholders::_1));
+    _eventSource.onOpen(std::bind(&EventSocket::onEventSourceOpen, this, std::placeholders::_1));
+    _eventSource.onClose(std::bind(&EventSocket::onEventSourceClose, this, std::placeholders::_1));
 }
 
 void EventSocket::onWSOpen(PsychicWebSocketClient *client) {
+    xSemaphoreTake(clientSubscriptionsMutex, portMAX_DELAY);
+    _wsClients[client->socket()] = {millis(), false};
+    xSemaphoreGive(clientSubscriptionsMutex);
     ESP_LOGI("EventSocket", "ws[%s][%u] connect", client->remoteIP().toString().c_str(), client->socket());
 }
 
 void EventSocket::onWSClose(PsychicWebSocketClient *client) {
+    removeClient(client->socket());
+    ESP_LOGI("EventSocket", "ws[%s][%u] disconnect", client->remoteIP().toString().c_str(), client->socket());
+}
+
+void EventSocket::removeClient(int socket) {
     xSemaphoreTake(clientSubscriptionsMutex, portMAX_DELAY);
+    _wsClients.erase(socket);
     for (auto &event_subscriptions : client_subscriptions) {
-        event_subscriptions.second.remove(client->socket());
+        event_subscriptions.second.remove_if([socket](const EventSubscription &sub) { return sub.socket == socket; });
     }
     xSemaphoreGive(clientSubscriptionsMutex);
-    ESP_LOGI("EventSocket", "ws[%s][%u] disconnect", client->remoteIP().toString().c_str(), client->socket());
+}
+
+// Runs before the Server-Sent Events stream is opened, this is the only place the query is available
+bool EventSocket::onEventSourceRequest(PsychicRequest *request) {
+    String events = getQueryValue(request->uri(), "events");
+    if (!events.length()) {
+        ESP_LOGW("EventSocket", "sse rejected, no events requested");
+        return false;
+    }
+    if (_eventSourceClients >= EVENT_SOURCE_MAX_CLIENTS) {
+        ESP_LOGW("EventSocket", "sse rejected, %u of %u clients connected", _eventSourceClients,
+                 EVENT_SOURCE_MAX_CLIENTS);
+        return false;
+    }
+    String interval = getQueryValue(request->uri(), "interval");
+    _pendingEventSources[request->client()->socket()] = interval.length() ? events + "@" + interval : events;
+    _eventSourceHeapMark = ESP.getFreeHeap();
+    return true;
+}
+
+void EventSocket::onEventSourceOpen(PsychicEventSourceClient *client) {
+    int socket = client->socket();
+    auto pending = _pendingEventSources.find(socket);
+    if (pending == _pendingEventSources.end()) {
+        client->close();
+        return;
+    }
+    String events = pending->second;
+    _pendingEventSources.erase(pending);
+
+    uint32_t interval = 0;
+    int separator = events.indexOf('@');
+    if (separator >= 0) {
+        interval = events.substring(separator + 1).toInt();
+        events.remove(separator);
+    }
+
+    unsigned int start = 0;
+    while (start < events.length()) {
+        int end = events.indexOf(',', start);
+        if (end < 0) end = events.length();
+        String event = events.substring(start, end);
+        if (event.length()) {
+            subscribe(event.c_str(), socket, interval, true);
+            handleSubscribeCallbacks(event.c_str(), socket);
+        }
+        start = end + 1;
+    }
+
+    // heap taken by the client and its subscriptions, measured on the httpd task between request and open
+    uint32_t freeHeap = ESP.getFreeHeap();
+    if (_eventSourceHeapMark > freeHeap) {
+        _eventSourceClientBytes = std::max(_eventSourceClientBytes, _eventSourceHeapMark - freeHeap);
+    }
+    _eventSourceClients++;
+    ESP_LOGI("EventSocket", "sse[%s][%u] connect: %s, ~%u bytes per client", client->remoteIP().toString().c_str(),
+             socket, events.c_str(), _eventSourceClientBytes);
+}
+
+void EventSocket::onEventSourceClose(PsychicEventSourceClient *client) {
+    removeClient(client->socket());
+    if (_eventSourceClients) _eventSourceClients--;
+    ESP_LOGI("EventSocket", "sse[%s][%u] disconnect", client->remoteIP().toString().c_str(), client->socket());
 }
 
 esp_err_t EventSocket::onFrame(PsychicWebSocketRequest *request, httpd_ws_frame *frame) {
@@ -75,37 +184,44 @@ esp_err_t EventSocket::onFrame(PsychicWebSocketRequest *request, httpd_ws_frame
 
     message_type_t message_type = char_to_message_type(msg[0]);
 
+    // any frame proves the client is alive, a pong also that it takes part in the keepalive
+    xSemaphoreTake(clientSubscriptionsMutex, portMAX_DELAY);
+    WsClient &wsClient = _wsClients[request->client()->socket()];
+    wsClient.lastSeen = millis();
+    if (message_type == PONG) wsClient.answersPings = true;
+    xSemaphoreGive(clientSubscriptionsMutex);
+
     if (message_type == PING) {
         ESP_LOGV("EventSocket", "Ping");
-        request->client()->sendMessage("3");
+        request->client()->sendMessage("4");
         return ESP_OK;
     } else if (message_type == PONG) {
         ESP_LOGV("EventSocket", "Pong");
         return ESP_OK;
     }
 
-    const char *event = getEventName(msg);
-
-    if (!event) {
+    char event[32];
+    if (!getEventName(msg, event, sizeof(event))) {
         ESP_LOGE("EventSocket", "Invalid event name");
         return ESP_OK;
     }
 
     if (message_type == CONNECT) {
         ESP_LOGV("EventSocket", "Connect: %s", event);
-        client_subscriptions[event].push_back(request->client()->socket());
-        handleSubscribeCallbacks(event, String(request->client()->socket()));
+        subscribe(event, request->client()->socket(), getSubscriptionInterval(msg));
+        handleSubscribeCallbacks(event, request->client()->socket());
     } else if (message_type == DISCONNECT) {
         ESP_LOGV("EventSocket", "Disconnect: %s", event);
-        client_subscriptions[event].remove(request->client()->socket());
+        unsubscribe(event, request->client()->socket());
     } else if (message_type == EVENT) {
         const char *payload = getEventPayload(msg);
         if (!payload) {
             ESP_LOGE("EventSocket", "Invalid event payload");
             return ESP_OK;
         }
-        JsonDocument doc;
+        JsonDocument doc(json_pool::allocator(json_pool::SITE_SOCKET));
         DeserializationError error = deserializeJson(doc, payload);
+        delete[] payload;
         if (error) {
             ESP_LOGE("EventSocket", "Failed to parse JSON payload");
             return ESP_OK;
@@ -117,51 +233,213 @@ esp_err_t EventSocket::onFrame(PsychicWebSocketRequest *request, httpd_ws_frame
     return ESP_OK;
 }
 
-bool EventSocket::hasSubscribers(const char *event) { return !client_subscriptions[event].empty(); }
-
-void EventSocket::emit(const char *event, const char *payload, const char *originId, bool onlyToSameOrigin) {
-    int originSubscriptionId = originId[0] ? atoi(originId) : -1;
+void EventSocket::subscribe(const char *event, int socket, uint32_t interval, bool eventSource) {
     xSemaphoreTake(clientSubscriptionsMutex, portMAX_DELAY);
     auto &subscriptions = client_subscriptions[event];
-    if (subscriptions.empty()) {
+    auto it = std::find_if(subscriptions.begin(), subscriptions.end(),
+                           [socket](const EventSubscription &sub) { return sub.socket == socket; });
+    if (it != subscriptions.end()) {
+        it->interval = interval;
+    } else {
+        subscriptions.push_back({.socket = socket, .eventSource = eventSource, .interval = interval, .lastSent = 0});
+    }
+    xSemaphoreGive(clientSubscriptionsMutex);
+}
+
+void EventSocket::unsubscribe(const char *event, int socket) {
+    xSemaphoreTake(clientSubscriptionsMutex, portMAX_DELAY);
+    client_subscriptions[event].remove_if([socket](const EventSubscription &sub) { return sub.socket == socket; });
+    xSemaphoreGive(clientSubscriptionsMutex);
+}
+
+bool EventSocket::hasSubscribers(const char *event) {
+    xSemaphoreTake(clientSubscriptionsMutex, portMAX_DELAY);
+    auto it = client_subscriptions.find(event);
+    bool subscribed = it != client_subscriptions.end() && !it->second.empty();
+    xSemaphoreGive(clientSubscriptionsMutex);
+    return subscribed;
+}
+
+size_t EventSocket::clientCount() {
+    xSemaphoreTake(clientSubscriptionsMutex, portMAX_DELAY);
+    size_t clients = _wsClients.size() + _eventSourceClients;
+    xSemaphoreGive(clientSubscriptionsMutex);
+    return clients;
+}
+
+void EventSocket::emit(const char *event, const char *payload, origin_id_t originId, bool onlyToSameOrigin) {
+    xSemaphoreTake(clientSubscriptionsMutex, portMAX_DELAY);
+    // only the first emit of an event allocates its entry
+    auto statsEntry = event_stats.find(event);
+    if (statsEntry == event_stats.end()) statsEntry = event_stats.emplace(event, EventStats()).first;
+    auto &stats = statsEntry->second;
+    stats.emits++;
+    auto subscriptionsEntry = client_subscriptions.find(event);
+    if (subscriptionsEntry == client_subscriptions.end() || subscriptionsEntry->second.empty()) {
         xSemaphoreGive(clientSubscriptionsMutex);
         return;
     }
+    auto &subscriptions = subscriptionsEntry->second;
     char msg[strlen(event) + strlen(payload) + 10];
     snprintf(msg, sizeof(msg), "2/%s[%s]", event, payload);
 
     // if onlyToSameOrigin == true, send the message back to the origin
-    if (onlyToSameOrigin && originSubscriptionId > 0) {
-        auto *client = _socket.getClient(originSubscriptionId);
-        if (client) {
-            ESP_LOGV("EventSocket", "Emitting event: %s to %s, Message: %s", event,
-                     client->remoteIP().toString().c_str(), msg);
-            client->sendMessage(msg);
+    if (onlyToSameOrigin && originId >= 0) {
+        auto it = std::find_if(subscriptions.begin(), subscriptions.end(),
+                               [originId](const EventSubscription &sub) { return sub.socket == originId; });
+        if (it != subscriptions.end()) {
+            send(*it, stats, event, payload, msg);
+        } else if (_socket.getClient(originId)) {
+            EventSubscription subscription {.socket = originId, .eventSource = false};
+            send(subscription, stats, event, payload, msg);
         }
     } else { // else send the message to all other clients
-
-        for (int subscription : client_subscriptions[event]) {
-            if (subscription == originSubscriptionId) continue;
-            auto *client = _socket.getClient(subscription);
-            if (!client) {
-                subscriptions.remove(subscription);
+        unsigned long now = millis();
+        for (auto it = subscriptions.begin(); it != subscriptions.end();) {
+            if (it->socket == originId) {
+                ++it;
+                continue;
+            }
+            if (it->interval && now - it->lastSent < it->interval) {
+                it->pending = payload; // latest value wins, sent by loop() once the interval has passed
+            } else if (!send(*it, stats, event, payload, msg)) {
+                it = subscriptions.erase(it);
+                stats.removed++;
                 continue;
+            } else {
+                it->lastSent = now;
+                it->pending = "";
             }
-            ESP_LOGV("EventSocket", "Emitting event: %s to %s, Message: %s", event,
-                     client->remoteIP().toString().c_str(), msg);
-            client->sendMessage(msg);
+            ++it;
+        }
+    }
+    xSemaphoreGive(clientSubscriptionsMutex);
+}
+
+// Returns false if the client is gone, a failed send to a connected client only counts as failed
+bool EventSocket::send(EventSubscription &subscription, EventStats &stats, const char *event, const char *payload,
+                       const char *msg) {
+    esp_err_t result = ESP_OK;
+    size_t bytes;
+    uint32_t start = micros();
+    if (subscription.eventSource) {
+        auto *client = _eventSource.getClient(subscription.socket);
+        if (!client) return false;
+        ESP_LOGV("EventSocket", "Emitting event: %s to sse %s", event, client->remoteIP().toString().c_str());
+        client->send(payload, event);
+        bytes = strlen(payload);
+    } else {
+        auto *client = _socket.getClient(subscription.socket);
+        if (!client) return false;
+        ESP_LOGV("EventSocket", "Emitting event: %s to %s, Message: %s", event,
+                 client->remoteIP().toString().c_str(), msg);
+        result = client->sendMessage(msg);
+        bytes = strlen(msg);
+    }
+    stats.latency.record(micros() - start);
+    if (result != ESP_OK) {
+        stats.failed++;
+        return true;
+    }
+    stats.recipients++;
+    stats.bytes += bytes;
+    return true;
+}
+
+void EventSocket::loop() {
+    unsigned long now = millis();
+    std::vector<int> evicted;
+    xSemaphoreTake(clientSubscriptionsMutex, portMAX_DELAY);
+    if (now - _lastPing >= EVENT_SOCKET_PING_INTERVAL) {
+        _lastPing = now;
+        checkClients(now, evicted);
+    }
+    for (auto &event_subscriptions : client_subscriptions) {
+        const char *event = event_subscriptions.first.c_str();
+        auto &stats = event_stats[event_subscriptions.first];
+        for (auto &subscription : event_subscriptions.second) {
+            if (!subscription.pending.length() || now - subscription.lastSent < subscription.interval) continue;
+            const char *payload = subscription.pending.c_str();
+            char msg[strlen(event) + strlen(payload) + 10];
+            snprintf(msg, sizeof(msg), "2/%s[%s]", event, payload);
+            send(subscription, stats, event, payload, msg);
+            subscription.lastSent = now;
+            subscription.pending = "";
+        }
+    }
+    xSemaphoreGive(clientSubscriptionsMutex);
+
+    for (int socket : evicted) {
+        auto *client = _socket.getClient(socket);
+        if (client) client->close();
+    }
+}
+
+// Called with the subscription mutex held. The evicted clients are closed by the caller once it released the mutex,
+// as their close handler takes it again.
+void EventSocket::checkClients(unsigned long now, std::vector<int> &evicted) {
+    for (auto it = _wsClients.begin(); it != _wsClients.end();) {
+        auto *client = _socket.getClient(it->first);
+        if (!client) {
+            it = _wsClients.erase(it); // closed without the close handler catching it
+            continue;
+        }
+        unsigned long idle = now - it->second.lastSeen;
+        bool dead = idle >= (it->second.answersPings ? EVENT_SOCKET_CLIENT_TIMEOUT : EVENT_SOCKET_CLIENT_IDLE_TIMEOUT);
+        if (!dead && idle >= EVENT_SOCKET_PING_INTERVAL) dead = client->sendMessage("3") != ESP_OK;
+        if (dead) {
+            ESP_LOGW("EventSocket", "ws[%s][%u] evicted after %lu ms without a frame",
+                     client->remoteIP().toString().c_str(), it->first, idle);
+            evicted.push_back(it->first);
+            _evictedClients++;
+            it = _wsClients.erase(it);
+            continue;
+        }
+        ++it;
+    }
+
+    // drop subscriptions of clients which are no longer connected and events nobody listens to
+    for (auto it = client_subscriptions.begin(); it != client_subscriptions.end();) {
+        auto &stats = event_stats[it->first];
+        it->second.remove_if([this, &stats](const EventSubscription &sub) {
+            bool connected = sub.eventSource ? _eventSource.getClient(sub.socket) != nullptr
+                                             : _wsClients.count(sub.socket) > 0;
+            if (!connected) stats.removed++;
+            return !connected;
+        });
+        it = it->second.empty() ? client_subscriptions.erase(it) : std::next(it);
+    }
+}
+
+void EventSocket::metrics(JsonObject &root, bool compact) {
+    xSemaphoreTake(clientSubscriptionsMutex, portMAX_DELAY);
+    for (auto &event : event_stats) {
+        const EventStats &stats = event.second;
+        JsonObject eventMetrics = root[event.first].to<JsonObject>();
+        eventMetrics["emits"] = stats.emits;
+        eventMetrics["recipients"] = stats.recipients;
+        eventMetrics["failed"] = stats.failed;
+        if (compact) {
+            eventMetrics["p99_us"] = stats.latency.percentile(99);
+            continue;
         }
+        eventMetrics["bytes"] = stats.bytes;
+        eventMetrics["removed"] = stats.removed;
+        auto subscriptions = client_subscriptions.find(event.first);
+        eventMetrics["subscribers"] = subscriptions != client_subscriptions.end() ? subscriptions->second.size() : 0;
+        JsonObject latency = eventMetrics["latency_us"].to<JsonObject>();
+        stats.latency.serialize(latency);
     }
     xSemaphoreGive(clientSubscriptionsMutex);
 }
 
-void EventSocket::handleEventCallbacks(String event, JsonObject &jsonObject, int originId) {
+void EventSocket::handleEventCallbacks(String event, JsonObject &jsonObject, origin_id_t originId) {
     for (auto &callback : event_callbacks[event]) {
         callback(jsonObject, originId);
     }
 }
 
-void EventSocket::handleSubscribeCallbacks(const char *event, const String &originId) {
+void EventSocket::handleSubscribeCallbacks(const char *event, origin_id_t originId) {
     for (auto &callback : subscribe_callbacks[event]) {
         callback(originId, true);
     }
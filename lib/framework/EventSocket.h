@@ -4,14 +4,62 @@
 #include <features.h>
 #include <PsychicHttp.h>
 #include <StatefulService.h>
+#include <histogram.h>
+#include <algorithm>
 #include <list>
 #include <map>
 #include <vector>
 
+// Server-Sent Event clients are read only, each one costs an open socket and its subscriptions
+#ifndef EVENT_SOURCE_MAX_CLIENTS
+#define EVENT_SOURCE_MAX_CLIENTS 2
+#endif
+
+// Idle websocket clients are pinged by the server, the web app considers the socket dead after 5s of silence
+#ifndef EVENT_SOCKET_PING_INTERVAL
+#define EVENT_SOCKET_PING_INTERVAL 2000
+#endif
+
+// Websocket clients which answered a ping once and then sent nothing for this long are closed
+#ifndef EVENT_SOCKET_CLIENT_TIMEOUT
+#define EVENT_SOCKET_CLIENT_TIMEOUT 10000
+#endif
+
+// Clients which never answered a ping, like pages loaded from older builds of the web app, are closed after this long
+// without a frame, or as soon as a ping can't be sent
+#ifndef EVENT_SOCKET_CLIENT_IDLE_TIMEOUT
+#define EVENT_SOCKET_CLIENT_IDLE_TIMEOUT 60000
+#endif
+
 enum message_type_t { CONNECT = 0, DISCONNECT = 1, EVENT = 2, PING = 3, PONG = 4, BINARY_EVENT = 5 };
 
-typedef std::function<void(JsonObject &root, int originId)> EventCallback;
-typedef std::function<void(const String &originId, bool sync)> SubscribeCallback;
+typedef std::function<void(JsonObject &root, origin_id_t originId)> EventCallback;
+typedef std::function<void(origin_id_t originId, bool sync)> SubscribeCallback;
+
+struct EventSubscription {
+    int socket;
+    bool eventSource;       // subscribed over the Server-Sent Events stream instead of the websocket
+    uint32_t interval;      // minimum ms between frames to this client, 0 = unlimited
+    unsigned long lastSent; // millis() of the last frame sent
+    String pending;         // newest payload held back by the rate limit
+};
+
+// Orders the maps by event name and lets emit() look them up by a C string without building a String
+struct EventNameLess {
+    using is_transparent = void;
+    bool operator()(const String &a, const String &b) const { return strcmp(a.c_str(), b.c_str()) < 0; }
+    bool operator()(const String &a, const char *b) const { return strcmp(a.c_str(), b) < 0; }
+    bool operator()(const char *a, const String &b) const { return strcmp(a, b.c_str()) < 0; }
+};
+
+struct EventStats {
+    uint32_t emits {0};        // calls to emit, including those without subscribers
+    uint64_t bytes {0};        // bytes handed to clients
+    uint32_t recipients {0};   // frames sent, one per client
+    uint32_t failed {0};       // sends the client rejected
+    uint32_t removed {0};      // subscriptions dropped because the client was gone
+    Log2Histogram<16> latency; // us per send
+};
 
 class EventSocket {
   public:
@@ -19,27 +67,70 @@ class EventSocket {
 
     PsychicWebSocketHandler *getHandler() { return &_socket; }
 
+    PsychicEventSource *getEventSourceHandler() { return &_eventSource; }
+
     bool hasSubscribers(const char *event);
 
+    // connected websocket and Server-Sent Event clients
+    size_t clientCount();
+
+    // true if the socket belongs to a websocket or Server-Sent Event client
+    bool hasClient(int socket) { return _socket.getClient(socket) || _eventSource.getClient(socket); }
+
+    // websocket clients closed by the server for not answering pings
+    uint32_t evictedClients() { return _evictedClients; }
+
     void onEvent(String event, EventCallback callback);
 
     void onSubscribe(String event, SubscribeCallback callback);
 
-    void emit(const char *event, const char *payload, const char *originId = "", bool onlyToSameOrigin = false);
+    void emit(const char *event, const char *payload, origin_id_t originId = ORIGIN_NONE,
+              bool onlyToSameOrigin = false);
     // if onlyToSameOrigin == true, the message will be sent to the originId only,
     // otherwise it will be broadcasted to all clients except the originId
 
+    // flushes frames held back by rate limited subscriptions, pings idle clients and evicts dead ones
+    void loop();
+
+    // per event counters and send latency, compact leaves out the histogram buckets
+    void metrics(JsonObject &root, bool compact = false);
+
   private:
     PsychicWebSocketHandler _socket;
+    PsychicEventSource _eventSource;
+
+    // subscriptions requested in the query of Server-Sent Event requests, until the stream is opened
+    std::map<int, String> _pendingEventSources;
+    uint32_t _eventSourceHeapMark {0};
+    uint32_t _eventSourceClientBytes {0};
+    size_t _eventSourceClients {0};
+
+    struct WsClient {
+        unsigned long lastSeen; // millis() of the last frame received
+        bool answersPings;
+    };
+    std::map<int, WsClient> _wsClients;
+    unsigned long _lastPing {0};
+    uint32_t _evictedClients {0};
 
-    std::map<String, std::list<int>> client_subscriptions;
-    std::map<String, std::list<EventCallback>> event_callbacks;
-    std::map<String, std::list<SubscribeCallback>> subscribe_callbacks;
-    void handleEventCallbacks(String event, JsonObject &jsonObject, int originId);
-    void handleSubscribeCallbacks(const char *event, const String &originId);
+    std::map<String, std::list<EventSubscription>, EventNameLess> client_subscriptions;
+    std::map<String, std::list<EventCallback>, EventNameLess> event_callbacks;
+    std::map<String, std::list<SubscribeCallback>, EventNameLess> subscribe_callbacks;
+    std::map<String, EventStats, EventNameLess> event_stats;
+    void handleEventCallbacks(String event, JsonObject &jsonObject, origin_id_t originId);
+    void handleSubscribeCallbacks(const char *event, origin_id_t originId);
+    void subscribe(const char *event, int socket, uint32_t interval, bool eventSource = false);
+    void unsubscribe(const char *event, int socket);
+    void removeClient(int socket);
+    void checkClients(unsigned long now, std::vector<int> &evicted);
+    bool send(EventSubscription &subscription, EventStats &stats, const char *event, const char *payload,
+              const char *msg);
 
     void onWSOpen(PsychicWebSocketClient *client);
     void onWSClose(PsychicWebSocketClient *client);
+    bool onEventSourceRequest(PsychicRequest *request);
+    void onEventSourceOpen(PsychicEventSourceClient *client);
+    void onEventSourceClose(PsychicEventSourceClient *client);
     esp_err_t onFrame(PsychicWebSocketRequest *request, httpd_ws_frame *frame);
 };
 
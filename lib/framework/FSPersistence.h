@@ -18,6 +18,7 @@
 #include <ESPFS.h>
 #include <FS.h>
 #include <StatefulService.h>
+#include <json_pool.h>
 
 template <class T>
 class FSPersistence {
@@ -37,7 +38,7 @@ class FSPersistence {
         File settingsFile = _fs->open(_filePath, "r");
 
         if (settingsFile) {
-            JsonDocument jsonDocument;
+            JsonDocument jsonDocument(json_pool::allocator(json_pool::SITE_PERSISTENCE));
             DeserializationError error = deserializeJson(jsonDocument, settingsFile);
             if (error == DeserializationError::Ok && jsonDocument.is<JsonObject>()) {
                 JsonObject jsonObject = jsonDocument.as<JsonObject>();
@@ -59,7 +60,7 @@ class FSPersistence {
 
     bool writeToFS() {
         // create and populate a new json object
-        JsonDocument jsonDocument;
+        JsonDocument jsonDocument(json_pool::allocator(json_pool::SITE_PERSISTENCE));
         JsonObject jsonObject = jsonDocument.to<JsonObject>();
         _statefulService->read(jsonObject, _stateReader);
 
@@ -89,7 +90,7 @@ class FSPersistence {
 
     void enableUpdateHandler() {
         if (!_updateHandlerId) {
-            _updateHandlerId = _statefulService->addUpdateHandler([&](const String &originId) { writeToFS(); });
+            _updateHandlerId = _statefulService->addUpdateHandler([&](origin_id_t originId) { writeToFS(); });
         }
     }
 
@@ -118,7 +119,7 @@ class FSPersistence {
     // We assume the updater supplies sensible defaults if an empty object
     // is supplied, this virtual function allows that to be changed.
     virtual void applyDefaults() {
-        JsonDocument jsonDocument;
+        JsonDocument jsonDocument(json_pool::allocator(json_pool::SITE_PERSISTENCE));
         JsonObject jsonObject = jsonDocument.as<JsonObject>();
         _statefulService->updateWithoutPropagation(jsonObject, _stateUpdater);
     }
@@ -17,8 +17,10 @@
 
 #include <StatefulService.h>
 #include <PsychicMqttClient.h>
+#include <json_pool.h>
+#include <mqtt_scheduler.h>
 
-#define MQTT_ORIGIN_ID "mqtt"
+#define MQTT_ORIGIN_ID ORIGIN_MQTT
 
 template <class T>
 class MqttEndpoint {
@@ -35,7 +37,11 @@ class MqttEndpoint {
           _retain(retain)
 
     {
-        _statefulService->addUpdateHandler([&](const String &originId) { publish(); }, false);
+        _statefulService->addUpdateHandler(
+            [&](origin_id_t originId, field_mask_t fields) {
+                if (fields & _fields) publish();
+            },
+            false);
 
         _mqttClient->onConnect(std::bind(&MqttEndpoint::onConnect, this));
 
@@ -72,19 +78,22 @@ class MqttEndpoint {
         publish();
     }
 
+    // Only changes to these fields are published
+    void setFields(field_mask_t fields) { _fields = fields; }
+
     void publish() {
         if (_pubTopic.length() > 0 && _mqttClient->connected()) {
             // serialize to json doc
-            JsonDocument json;
+            JsonDocument json(json_pool::allocator(json_pool::SITE_MQTT));
             JsonObject jsonObject = json.to<JsonObject>();
             _statefulService->read(jsonObject, _stateReader);
 
-            // serialize to string
-            String payload;
-            serializeJson(json, payload);
+            // serialize next to the document, the scheduler copies it into its slot
+            json_pool::Serialized payload(json, json_pool::SITE_MQTT);
 
-            // publish the payload
-            _mqttClient->publish(_pubTopic.c_str(), 0, _retain, payload.c_str());
+            // queue the payload, a newer state replaces it while it waits
+            mqtt_scheduler::publish(mqtt_scheduler::PRIORITY_STATE, _pubTopic.c_str(), 0, _retain, payload.c_str(),
+                                    payload.length());
         }
     }
 
@@ -98,6 +107,7 @@ class MqttEndpoint {
     String _subTopic;
     String _pubTopic;
     bool _retain;
+    field_mask_t _fields {ALL_FIELDS};
 
     void onMqttMessage(char *topic, char *payload, int retain, int qos, bool dup) {
         // we only care about the topic we are watching in this class
@@ -106,7 +116,7 @@ class MqttEndpoint {
         }
 
         // deserialize from string
-        JsonDocument json;
+        JsonDocument json(json_pool::allocator(json_pool::SITE_MQTT));
         DeserializationError error = deserializeJson(json, payload);
         if (!error && json.is<JsonObject>()) {
             JsonObject jsonObject = json.as<JsonObject>();
@@ -48,7 +48,7 @@ MqttSettingsService::MqttSettingsService()
       _reconfigureMqtt(false),
       _mqttClient(),
       _lastError("None") {
-    addUpdateHandler([&](const String &originId) { onConfigUpdated(); }, false);
+    addUpdateHandler([&](origin_id_t originId) { onConfigUpdated(); }, false);
 
     _mqttClient.setCACertBundle(rootca_crt_bundle_start);
 }
@@ -65,6 +65,7 @@ void MqttSettingsService::begin() {
     _mqttClient.onConnect(std::bind(&MqttSettingsService::onMqttConnect, this, std::placeholders::_1));
     _mqttClient.onDisconnect(std::bind(&MqttSettingsService::onMqttDisconnect, this, std::placeholders::_1));
     _mqttClient.onError(std::bind(&MqttSettingsService::onMqttError, this, std::placeholders::_1));
+    mqtt_scheduler::begin(&_mqttClient);
 }
 
 void MqttSettingsService::loop() {
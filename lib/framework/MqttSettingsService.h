@@ -20,6 +20,7 @@
 #include <PsychicMqttClient.h>
 #include <StatefulService.h>
 #include <WiFi.h>
+#include <mqtt_scheduler.h>
 #include <stateful_endpoint.h>
 #include <domain/mqtt_settings.h>
 
@@ -5,7 +5,7 @@ static const char *TAG = "NPT Service";
 NTPSettingsService::NTPSettingsService()
     : endpoint(NTPSettings::read, NTPSettings::update, this),
       _fsPersistence(NTPSettings::read, NTPSettings::update, this, NTP_SETTINGS_FILE) {
-    addUpdateHandler([&](const String &originId) { configureNTP(); }, false);
+    addUpdateHandler([&](origin_id_t originId) { configureNTP(); }, false);
 }
 
 void NTPSettingsService::begin() {
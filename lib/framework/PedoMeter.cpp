@@ -16,10 +16,10 @@ void IRAM_ATTR hallSensorInterrupt() {
 }
 
 void PedoMeter::begin() {
-    socket.onEvent("reset_pedometer", [&](JsonObject &root, int originId) {
-        _state.reset();
-        _fsPersistence.writeToFS();
-    });
+    socket.onEvent(EVENT_RESET_PEDOMETER, [&](JsonObject &root, origin_id_t originId) { reset(); });
+    socket.onEvent(EVENT_STEP_RESUME, [&](JsonObject &root, origin_id_t originId) { resume(root, originId); });
+
+    updateTotals(); // of the history read from the file system
 
     pinMode(HALL_SENSOR_PIN, INPUT_PULLUP);
     attachInterrupt(digitalPinToInterrupt(HALL_SENSOR_PIN), hallSensorInterrupt, FALLING);
@@ -27,11 +27,366 @@ void PedoMeter::begin() {
     xTaskCreatePinnedToCore(this->_loopImpl, "Pedometer", 5120, this, (tskIDLE_PRIORITY), NULL, 1);
 }
 
+void PedoMeter::readWithSequence(PedoMeterData &data, JsonObject &root) {
+    PedoMeterData::read(data, root);
+    // Step events are appended under the state lock, so this is the sequence number the sessions are current to
+    root["seq"] = _stepLog.head();
+    root["boot"] = bootNonce();
+}
+
+// The same as PedoMeterData::read with the sequence, copied in batches which are written with the state unlocked
+void PedoMeter::writeHistory(JsonStreamWriter &json) {
+    HistoryView view;
+    uint32_t seq;
+    read([&](PedoMeterData &data) {
+        view = data.view();
+        seq = _stepLog.head();
+    });
+
+    json.beginObject(5);
+    json.value("magnets", view.magnets);
+    json.value("diameter", view.diameter);
+    json.beginArray("sessions", view.sessions);
+    float times[STEPS_COPY_BATCH];
+    for (size_t i = 0; i < view.sessions; i++) {
+        SessionHeader session;
+        bool current;
+        read([&](PedoMeterData &data) { current = data.copySession(view, i, session); });
+        if (!current) return abortHistory(json);
+        json.beginObject(4);
+        json.value("start", session.start);
+        json.value("end", session.end);
+        json.value("steps", (long)session.steps);
+        json.beginArray("times", session.times);
+        for (size_t offset = 0; offset < session.times;) {
+            size_t count;
+            read([&](PedoMeterData &data) { count = data.copyTimes(view, i, offset, times, STEPS_COPY_BATCH); });
+            if (!count) return abortHistory(json);
+            for (size_t j = 0; j < count; j++) json.value(times[j]);
+            offset += count;
+        }
+        json.endArray();
+        json.endObject();
+    }
+    json.endArray();
+    json.value("seq", (unsigned long)seq);
+    json.value("boot", (unsigned long)bootNonce());
+    json.endObject();
+}
+
+// Recounts the totals after the history was read or replaced, under the state lock so no step is added meanwhile
+void PedoMeter::updateTotals() {
+    read([&](PedoMeterData &data) {
+        PedoMeterTotals current = data.totals();
+        totals.updateWithoutPropagation([&](PedoMeterTotals &state) {
+            state = current;
+            return StateUpdateResult::CHANGED;
+        });
+    });
+}
+
+// The history was reset or replaced while it was written, the sizes sent already can't be met any more. The
+// response is broken off and the client reads the history again after the resync event which follows the reset.
+void PedoMeter::abortHistory(JsonStreamWriter &json) {
+    ESP_LOGW("PedoMeter", "History reset while it was sent, response aborted after %u bytes", json.bytesWritten());
+    json.abort();
+}
+
+long parseBucketSize(const String &bucket) {
+    if (bucket == "1m") return 60;
+    if (bucket == "1h") return SECONDS_PER_HOUR;
+    if (bucket == "1d") return SECONDS_PER_DAY;
+    return 0;
+}
+
+// Offset of the local time set by the NTP settings from UTC at t, in s
+long utcOffset(time_t t) {
+    struct tm local, utc;
+    localtime_r(&t, &local);
+    gmtime_r(&t, &utc);
+    long days = local.tm_year != utc.tm_year ? local.tm_year - utc.tm_year : local.tm_yday - utc.tm_yday;
+    return days * SECONDS_PER_DAY + (local.tm_hour - utc.tm_hour) * SECONDS_PER_HOUR + (local.tm_min - utc.tm_min) * 60;
+}
+
+esp_err_t PedoMeter::getAggregate(PsychicRequest *request) {
+    long bucketSize = parseBucketSize(request->hasParam("bucket") ? request->getParam("bucket")->value() : "1h");
+    if (!bucketSize) return request->reply(400);
+
+    long to = request->hasParam("to") ? request->getParam("to")->value().toInt() : time(nullptr);
+    long from = request->hasParam("from") ? request->getParam("from")->value().toInt()
+                                          : to - (bucketSize == SECONDS_PER_DAY ? 30 : 1) * SECONDS_PER_DAY;
+    if (from < 0 || to <= from) return request->reply(400);
+    // buckets start at local time, the offset at from is used for the whole range
+    long offset = utcOffset(from);
+    from -= ((from % bucketSize) + (offset % bucketSize) + bucketSize) % bucketSize;
+    // the local bucket of a from close to the epoch can start below 0, there are no steps before it
+    if (from < 0) from = 0;
+    if (to - from > STEPS_AGGREGATE_MAX_BUCKETS * bucketSize) to = from + STEPS_AGGREGATE_MAX_BUCKETS * bucketSize;
+
+    bool fromRollups;
+    float circumference;
+    read([&](PedoMeterData &data) {
+        fromRollups = data.rollupsCover(from, bucketSize);
+        circumference = data.circumference();
+    });
+
+    PsychicStreamResponse response = PsychicStreamResponse(request, "application/json");
+    esp_err_t err = response.beginSend();
+    if (err != ESP_OK) return err;
+    JsonStreamWriter json(response);
+    json.beginObject();
+    json.value("bucket", bucketSize);
+    json.value("from", from);
+    json.value("to", to);
+    json.value("utc_offset", offset);
+
+    // copied in batches like the export, the buckets are written with the state unlocked
+    StepAggregator aggregator(from, to, bucketSize, circumference, json);
+    // sessions are in order, so the first step at or after until ends the scan
+    auto addSteps = [&](long since, long until) {
+        StepCursor cursor;
+        StepRecord records[STEPS_COPY_BATCH];
+        size_t count;
+        do {
+            read([&](PedoMeterData &data) { count = data.copySteps(cursor, since - 1, records, STEPS_COPY_BATCH); });
+            for (size_t i = 0; i < count; i++) {
+                long timestamp = (long)records[i].timestamp;
+                if (timestamp >= until) {
+                    count = 0;
+                    break;
+                }
+                if (timestamp >= since) aggregator.addStep(timestamp, records[i].interval);
+            }
+        } while (count);
+    };
+    json.beginArray("buckets");
+    if (fromRollups) {
+        // whole hours before to from the rollups, the rest of the last bucket is cut at to from the steps
+        StepBucket hours[STEPS_COPY_BATCH];
+        long lastHour = to / SECONDS_PER_HOUR;
+        for (long hour = from / SECONDS_PER_HOUR; hour < lastHour; hour += STEPS_COPY_BATCH) {
+            size_t count = std::min<long>(STEPS_COPY_BATCH, lastHour - hour);
+            read([&](PedoMeterData &data) { data.copyRollups(hour, count, hours); });
+            for (size_t i = 0; i < count; i++) {
+                if (!hours[i].empty()) aggregator.addBucket((hour + i) * SECONDS_PER_HOUR, hours[i]);
+            }
+        }
+        if (lastHour * SECONDS_PER_HOUR < to) addSteps(lastHour * SECONDS_PER_HOUR, to);
+    } else {
+        addSteps(from, to);
+    }
+    aggregator.finish();
+    json.endArray();
+    json.value("source", fromRollups ? "rollup" : "raw");
+    json.endObject();
+    return response.endSend();
+}
+
+esp_err_t PedoMeter::getExport(PsychicRequest *request) {
+    String format = request->hasParam("format") ? request->getParam("format")->value() : "ndjson";
+    bool csv = format == "csv";
+    if (!csv && format != "ndjson") return request->reply(400);
+    double since = request->hasParam("since") ? request->getParam("since")->value().toDouble() : 0;
+
+    // %.9g keeps every digit of the float interval, timestamps are resumable with millisecond precision
+    const char *line = csv ? "%ld,%.3f,%.9g\n" : "{\"session_start\":%ld,\"timestamp\":%.3f,\"interval\":%.9g}\n";
+
+    PsychicStreamResponse response = PsychicStreamResponse(request, csv ? "text/csv" : "application/x-ndjson",
+                                                           csv ? "steps.csv" : "steps.ndjson");
+    esp_err_t err = response.beginSend();
+    if (err != ESP_OK) return err;
+    if (csv) response.print("session_start,timestamp,interval\n");
+
+    StepCursor cursor;
+    StepRecord records[STEPS_COPY_BATCH];
+    size_t count;
+    do {
+        read([&](PedoMeterData &data) { count = data.copySteps(cursor, since, records, STEPS_COPY_BATCH); });
+        for (size_t i = 0; i < count; i++) {
+            response.printf(line, records[i].sessionStart, records[i].timestamp, records[i].interval);
+        }
+    } while (count);
+    return response.endSend();
+}
+
+esp_err_t PedoMeter::getSeries(PsychicRequest *request) {
+    long start = request->hasParam("session") ? request->getParam("session")->value().toInt() : 0;
+    long points = request->hasParam("points") ? request->getParam("points")->value().toInt()
+                                              : STEPS_SERIES_DEFAULT_POINTS;
+    String method = request->hasParam("method") ? request->getParam("method")->value() : "lttb";
+    if (points < 3 || points > STEPS_SERIES_MAX_POINTS || (method != "lttb" && method != "minmax")) {
+        return request->reply(400);
+    }
+
+    // downsampled into at most points, so the copy is bounded and written with the state unlocked
+    std::vector<SeriesPoint> series;
+    series.reserve(points);
+    SessionHeader session;
+    bool found = false;
+    read([&](PedoMeterData &data) { found = data.series(start, points, method == "minmax", session, series); });
+    if (!found) return request->reply(404);
+
+    PsychicStreamResponse response = PsychicStreamResponse(request, "application/json");
+    esp_err_t err = response.beginSend();
+    if (err != ESP_OK) return err;
+    JsonStreamWriter json(response);
+    json.beginObject(4);
+    json.value("method", method.c_str());
+    json.value("start", session.start);
+    json.value("steps", (unsigned long)session.times);
+    json.beginArray("points", series.size());
+    for (const SeriesPoint &point : series) {
+        json.beginArray(2);
+        json.value(point.x);
+        json.value(point.y);
+        json.endArray();
+    }
+    json.endArray();
+    json.endObject();
+    return response.endSend();
+}
+
+void PedoMeter::recordSessionStart() {
+    StepEvent event;
+    updateWithoutPropagation([&](PedoMeterData &state) {
+        state.startSession();
+        event = _stepLog.append(StepEventType::SESSION_START, time(nullptr));
+        totals.updateWithoutPropagation([&](PedoMeterTotals &current) {
+            current.sessions++;
+            return StateUpdateResult::CHANGED;
+        });
+        return StateUpdateResult::changed(PedoMeterData::FIELD_SESSIONS);
+    });
+    broadcast(event);
+}
+
+void PedoMeter::recordStep(float elapsed) {
+    StepEvent event;
+    updateWithoutPropagation([&](PedoMeterData &state) {
+        state.updateSession(elapsed);
+        event = _stepLog.append(StepEventType::STEP, time(nullptr), elapsed);
+        totals.updateWithoutPropagation([&](PedoMeterTotals &current) {
+            current.sessions = state.sessionCount(); // a step after a reset starts a session
+            current.addStep(elapsed, state.circumference());
+            return StateUpdateResult::CHANGED;
+        });
+        return StateUpdateResult::changed(PedoMeterData::FIELD_SESSIONS);
+    });
+    broadcast(event);
+}
+
+void PedoMeter::recordSessionEnd() {
+    StepEvent event;
+    updateWithoutPropagation([&](PedoMeterData &state) {
+        state.endSession();
+        event = _stepLog.append(StepEventType::SESSION_END, time(nullptr));
+        return StateUpdateResult::changed(PedoMeterData::FIELD_SESSIONS);
+    });
+    broadcast(event);
+}
+
+void PedoMeter::reset() {
+    updateWithoutPropagation([&](PedoMeterData &state) {
+        state.reset();
+        _stepLog.clear();
+        totals.updateWithoutPropagation([](PedoMeterTotals &current) {
+            current = PedoMeterTotals();
+            return StateUpdateResult::CHANGED;
+        });
+        return StateUpdateResult::changed(PedoMeterData::FIELD_SESSIONS);
+    });
+    _fsPersistence.writeToFS();
+    emitResync();
+}
+
+void PedoMeter::resume(JsonObject &root, origin_id_t originId) {
+    // sequence numbers start over on every boot, so a number from before a restart means nothing
+    if (!root["seq"].is<uint32_t>() || root["boot"] != bootNonce()) {
+        emitResync(originId);
+        return;
+    }
+    uint32_t since = root["seq"];
+    bool replayed = _stepLog.replay(since, [&](const StepEvent &event) { emitStepEvent(event, originId); });
+    ESP_LOGV("PedoMeter", "Resume from %lu for %d: %s", (unsigned long)since, originId,
+             replayed ? "replayed" : "resync");
+    if (!replayed) emitResync(originId);
+}
+
+// New events go to the Event Socket and MQTT, replays only to the client which resumed
+void PedoMeter::broadcast(const StepEvent &event) {
+    emitStepEvent(event);
+    telemetry.add(event);
+}
+
+void PedoMeter::emitStepEvent(const StepEvent &event, origin_id_t originId) {
+    char payload[64];
+    event.serialize(payload, sizeof(payload));
+    socket.emit(event.name(), payload, originId, originId >= 0);
+}
+
+void PedoMeter::emitResync(origin_id_t originId) {
+    char payload[40];
+    snprintf(payload, sizeof(payload), "{\"seq\":%lu,\"boot\":%lu}", (unsigned long)_stepLog.head(),
+             (unsigned long)bootNonce());
+    socket.emit(EVENT_STEP_RESYNC, payload, originId, originId >= 0);
+}
+
+// Publishes the next part of a requested snapshot. Only the part is copied under the lock, and a part the
+// scheduler had no room for is sent again in the next loop.
+void PedoMeter::publishSnapshot() {
+    SnapshotCursor &snapshot = _snapshot;
+    if (telemetry.snapshotRequested()) {
+        snapshot = SnapshotCursor();
+        read([&](PedoMeterData &data) {
+            snapshot.view = data.view();
+            snapshot.seq = _stepLog.head();
+            snapshot.parts = 1 + data.countBatches(snapshot.view, PEDOMETER_SNAPSHOT_BATCH);
+        });
+        snapshot.active = true;
+    }
+    if (!snapshot.active) return;
+
+    if (!snapshot.part) {
+        if (!telemetry.publishSnapshotHeader(snapshot.seq, snapshot.parts, snapshot.view.magnets,
+                                             snapshot.view.diameter)) {
+            return;
+        }
+        snapshot.part++;
+        snapshot.active = snapshot.view.sessions > 0;
+        return;
+    }
+
+    SessionHeader session;
+    float times[PEDOMETER_SNAPSHOT_BATCH];
+    size_t count = 0;
+    bool current = false;
+    read([&](PedoMeterData &data) {
+        current = data.copySession(snapshot.view, snapshot.session, session);
+        if (current) {
+            count = data.copyTimes(snapshot.view, snapshot.session, snapshot.offset, times, PEDOMETER_SNAPSHOT_BATCH);
+        }
+    });
+    // the subscriber sees the missing parts and has to request a new one
+    if (!current || (!count && snapshot.offset < session.times)) {
+        ESP_LOGW("PedoMeter", "History reset, snapshot ended after %lu of %lu parts", (unsigned long)snapshot.part,
+                 (unsigned long)snapshot.parts);
+        snapshot.active = false;
+        return;
+    }
+    if (!telemetry.publishSnapshotPart(snapshot.seq, snapshot.part, session, snapshot.offset, times, count)) return;
+
+    snapshot.part++;
+    snapshot.offset += count;
+    if (snapshot.offset >= session.times) {
+        snapshot.session++;
+        snapshot.offset = 0;
+    }
+    snapshot.active = snapshot.session < snapshot.view.sessions;
+}
+
 void PedoMeter::_loop() {
     TickType_t xLastWakeTime = xTaskGetTickCount();
-    JsonDocument doc;
     bool isInSession = false;
-    float lastTimeElapsed = 0;
 
     while (1) {
         unsigned long currentTime = millis();
@@ -40,23 +395,22 @@ void PedoMeter::_loop() {
 
             if (!isInSession) {
                 isInSession = true;
-                _state.startSession();
+                recordSessionStart();
             } else {
-                _state.updateSession(timeElapsed);
-                doc["time_elapsed"] = timeElapsed;
-
-                String output;
-                serializeJson(doc, output);
-                socket.emit(EVENT_STEP, output.c_str());
+                recordStep(timeElapsed);
             }
         }
 
+        telemetry.loop();
+        publishSnapshot();
+
         EXECUTE_EVERY_N_MS(30000,
                            _fsPersistence.writeToFS();); // Save every 30 seconds
 
-        if (currentTime - lastDebounceTime > SESSION_INACTIVITY_DELAY) {
-            _state.endSession();
+        // Only close the session once, otherwise the end time of the last session keeps moving
+        if (isInSession && currentTime - lastDebounceTime > SESSION_INACTIVITY_DELAY) {
             isInSession = false;
+            recordSessionEnd();
         }
 
         vTaskDelayUntil(&xLastWakeTime, STEP_INTERVAL / portTICK_PERIOD_MS);
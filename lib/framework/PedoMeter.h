@@ -18,34 +18,96 @@ Top stats:
 #include <EventSocket.h>
 #include <FSPersistence.h>
 #include <WiFi.h>
+#include <pedometer_telemetry.h>
 #include <stateful_endpoint.h>
+#include <step_event_log.h>
 #include <timing.h>
 #include <vector>
 #include <domain/pedometer_data.h>
 
-#define EVENT_STEP "step"
+#define EVENT_STEP_RESUME "step_resume"
+#define EVENT_STEP_RESYNC "step_resync"
+#define EVENT_RESET_PEDOMETER "reset_pedometer"
 #define STEP_INTERVAL 150
+#define STEP_EVENT_LOG_SIZE 256
 
 #define HALL_SENSOR_PIN 32
 #define DEBOUNCE_DELAY 150
 #define SESSION_INACTIVITY_DELAY 10000
 
+// Upper bound of buckets in one aggregate response
+#define STEPS_AGGREGATE_MAX_BUCKETS 1500
+#define SECONDS_PER_DAY 86400
+
+// Points in a downsampled speed series
+#define STEPS_SERIES_DEFAULT_POINTS 200
+#define STEPS_SERIES_MAX_POINTS 1000
+
+// Steps copied per lock while exporting or streaming the history, the state is unlocked while they are sent
+#define STEPS_COPY_BATCH 64
+
 class PedoMeter : public StatefulService<PedoMeterData> {
   public:
     PedoMeter()
-        : endpoint(PedoMeterData::read, PedoMeterData::update, this),
-          _fsPersistence(PedoMeterData::read, PedoMeterData::update, this, STEPS_FILE) {};
+        : endpoint([this](PedoMeterData &data, JsonObject &root) { readWithSequence(data, root); },
+                   PedoMeterData::update, this),
+          _fsPersistence(PedoMeterData::read, PedoMeterData::update, this, STEPS_FILE) {
+        endpoint.setStreamReader([this](JsonStreamWriter &json) { writeHistory(json); });
+        addUpdateHandler([this](origin_id_t originId) { updateTotals(); }, false);
+    };
 
     void begin();
 
+    // GET /api/v1/steps/aggregate?bucket=1m|1h|1d&from=&to=
+    esp_err_t getAggregate(PsychicRequest *request);
+
+    // GET /api/v1/steps/export?format=ndjson|csv&since=
+    esp_err_t getExport(PsychicRequest *request);
+
+    // GET /api/v1/steps/series?session=&points=&method=lttb|minmax
+    esp_err_t getSeries(PsychicRequest *request);
+
     HttpEndpoint<PedoMeterData> endpoint;
 
+    // GET /api/v1/steps/totals, updated with every step
+    StatefulService<PedoMeterTotals> totals;
+
+    // Started by the framework once the MQTT client exists
+    PedoMeterTelemetry telemetry;
+
   protected:
     FSPersistence<PedoMeterData> _fsPersistence;
 
+    StepEventLog<STEP_EVENT_LOG_SIZE> _stepLog;
+
     static void _loopImpl(void *_this) { static_cast<PedoMeter *>(_this)->_loop(); }
     void _loop();
 
+    void readWithSequence(PedoMeterData &data, JsonObject &root);
+    void writeHistory(JsonStreamWriter &json);
+    void abortHistory(JsonStreamWriter &json);
+    void updateTotals();
+    void recordSessionStart();
+    void recordStep(float elapsed);
+    void recordSessionEnd();
+    void reset();
+    void resume(JsonObject &root, origin_id_t originId);
+    void broadcast(const StepEvent &event);
+    void emitStepEvent(const StepEvent &event, origin_id_t originId = ORIGIN_NONE);
+    void emitResync(origin_id_t originId = ORIGIN_NONE);
+    void publishSnapshot();
+
+    // Progress of the snapshot being published, one part per loop
+    struct SnapshotCursor {
+        HistoryView view;
+        uint32_t seq {0};
+        uint32_t parts {0};
+        uint32_t part {0}; // the next one
+        size_t session {0};
+        size_t offset {0};
+        bool active {false};
+    } _snapshot;
+
     float totalDistance = 0.0;
     const float diameterOfHamsterWheel = 0.19; // cm
     const float pi = 3.14159;
@@ -21,154 +21,138 @@
 #include <freertos/FreeRTOS.h>
 #include <freertos/semphr.h>
 #include <functional>
-#include <list>
+#include <inline_function.h>
+#include <state_lock.h>
 #include <stateful_result.h>
+#include <update_dispatcher.h>
 
+// Capacity of the handler tables of every StatefulService
+#ifndef STATE_MAX_UPDATE_HANDLERS
+#define STATE_MAX_UPDATE_HANDLERS 6
+#endif
+
+#ifndef STATE_MAX_HOOK_HANDLERS
+#define STATE_MAX_HOOK_HANDLERS 4
+#endif
+
+// Usually the static read and update functions of the state type, stored without the heap like the handlers
 template <typename T>
-using JsonStateUpdater = std::function<StateUpdateResult(JsonObject &root, T &settings)>;
+using JsonStateUpdater = InlineFunction<StateUpdateResult(JsonObject &root, T &settings)>;
 
 template <typename T>
-using JsonStateReader = std::function<void(T &settings, JsonObject &root)>;
+using JsonStateReader = InlineFunction<void(T &settings, JsonObject &root)>;
 
 typedef size_t update_handler_id_t;
 typedef size_t hook_handler_id_t;
-typedef std::function<void(const String &originId)> StateUpdateCallback;
-typedef std::function<void(const String &originId, StateUpdateResult &result)> StateHookCallback;
-
-typedef struct StateUpdateHandlerInfo {
-    static inline update_handler_id_t currentUpdatedHandlerId = 0;
-    update_handler_id_t _id;
-    StateUpdateCallback _cb;
-    bool _allowRemove;
-    StateUpdateHandlerInfo(StateUpdateCallback cb, bool allowRemove)
-        : _id(++currentUpdatedHandlerId), _cb(cb), _allowRemove(allowRemove) {};
-} StateUpdateHandlerInfo_t;
-
-typedef struct StateHookHandlerInfo {
-    static inline hook_handler_id_t currentHookHandlerId = 0;
-    hook_handler_id_t _id;
-    StateHookCallback _cb;
-    bool _allowRemove;
-    StateHookHandlerInfo(StateHookCallback cb, bool allowRemove)
-        : _id(++currentHookHandlerId), _cb(cb), _allowRemove(allowRemove) {};
-} StateHookHandlerInfo_t;
-
-template <class T>
+typedef InlineFunction<void(origin_id_t originId, field_mask_t fields)> StateUpdateCallback;
+typedef InlineFunction<void(origin_id_t originId, StateUpdateResult &result)> StateHookCallback;
+
+// Lock is picked through StateLockPolicy<T>, see state_lock.h
+template <class T, class Lock = typename StateLockPolicy<T>::type>
 class StatefulService {
   public:
     template <typename... Args>
-    StatefulService(Args &&...args)
-        : _state(std::forward<Args>(args)...), _accessMutex(xSemaphoreCreateRecursiveMutex()) {}
+    StatefulService(Args &&...args) : _state(std::forward<Args>(args)...) {}
 
     update_handler_id_t addUpdateHandler(StateUpdateCallback cb, bool allowRemove = true) {
-        if (!cb) {
-            return 0;
-        }
-        StateUpdateHandlerInfo_t updateHandler(cb, allowRemove);
-        _updateHandlers.push_back(updateHandler);
-        return updateHandler._id;
+        if (!cb) return 0;
+        update_handler_id_t id = _updateHandlers.add(cb, allowRemove);
+        if (!id) ESP_LOGE("StatefulService", "No room for another update handler, raise STATE_MAX_UPDATE_HANDLERS");
+        return id;
     }
 
-    void removeUpdateHandler(update_handler_id_t id) {
-        for (auto i = _updateHandlers.begin(); i != _updateHandlers.end();) {
-            if ((*i)._allowRemove && (*i)._id == id) {
-                i = _updateHandlers.erase(i);
-            } else {
-                ++i;
-            }
-        }
+    // For handlers which don't care which fields changed
+    template <typename F, typename = std::enable_if_t<std::is_invocable<F &, origin_id_t>::value>>
+    update_handler_id_t addUpdateHandler(F cb, bool allowRemove = true) {
+        return addUpdateHandler([cb](origin_id_t originId, field_mask_t fields) mutable { cb(originId); },
+                                allowRemove);
     }
 
+    void removeUpdateHandler(update_handler_id_t id) { _updateHandlers.remove(id); }
+
     hook_handler_id_t addHookHandler(StateHookCallback cb, bool allowRemove = true) {
-        if (!cb) {
-            return 0;
-        }
-        StateHookHandlerInfo_t hookHandler(cb, allowRemove);
-        _hookHandlers.push_back(hookHandler);
-        return hookHandler._id;
+        if (!cb) return 0;
+        hook_handler_id_t id = _hookHandlers.add(cb, allowRemove);
+        if (!id) ESP_LOGE("StatefulService", "No room for another hook handler, raise STATE_MAX_HOOK_HANDLERS");
+        return id;
     }
 
-    void removeHookHandler(hook_handler_id_t id) {
-        for (auto i = _hookHandlers.begin(); i != _hookHandlers.end();) {
-            if ((*i)._allowRemove && (*i)._id == id) {
-                i = _hookHandlers.erase(i);
-            } else {
-                ++i;
-            }
-        }
-    }
+    void removeHookHandler(hook_handler_id_t id) { _hookHandlers.remove(id); }
 
-    StateUpdateResult update(std::function<StateUpdateResult(T &)> stateUpdater, const String &originId) {
+    template <typename Updater>
+    StateUpdateResult update(Updater &&stateUpdater, origin_id_t originId) {
         beginTransaction();
         StateUpdateResult result = stateUpdater(_state);
+        if (result == StateUpdateResult::CHANGED) _version++;
         endTransaction();
         callHookHandlers(originId, result);
         if (result == StateUpdateResult::CHANGED) {
-            callUpdateHandlers(originId);
+            dispatchUpdateHandlers(originId, result.fields());
         }
         return result;
     }
 
-    StateUpdateResult updateWithoutPropagation(std::function<StateUpdateResult(T &)> stateUpdater) {
+    template <typename Updater>
+    StateUpdateResult updateWithoutPropagation(Updater &&stateUpdater) {
         beginTransaction();
         StateUpdateResult result = stateUpdater(_state);
+        if (result == StateUpdateResult::CHANGED) _version++;
         endTransaction();
         return result;
     }
 
-    StateUpdateResult update(JsonObject &jsonObject, JsonStateUpdater<T> stateUpdater, const String &originId) {
-        beginTransaction();
-        StateUpdateResult result = stateUpdater(jsonObject, _state);
-        endTransaction();
-        callHookHandlers(originId, result);
-        if (result == StateUpdateResult::CHANGED) {
-            callUpdateHandlers(originId);
-        }
-        return result;
+    StateUpdateResult update(JsonObject &jsonObject, const JsonStateUpdater<T> &stateUpdater, origin_id_t originId) {
+        return update([&](T &state) { return stateUpdater(jsonObject, state); }, originId);
     }
 
-    StateUpdateResult updateWithoutPropagation(JsonObject &jsonObject, JsonStateUpdater<T> stateUpdater) {
-        beginTransaction();
-        StateUpdateResult result = stateUpdater(jsonObject, _state);
-        endTransaction();
-        return result;
+    StateUpdateResult updateWithoutPropagation(JsonObject &jsonObject, const JsonStateUpdater<T> &stateUpdater) {
+        return updateWithoutPropagation([&](T &state) { return stateUpdater(jsonObject, state); });
     }
 
-    void read(std::function<void(T &)> stateReader) {
-        beginTransaction();
-        stateReader(_state);
-        endTransaction();
+    template <typename Reader>
+    void read(Reader &&stateReader) {
+        _lock.read(_state, stateReader);
     }
 
-    void read(JsonObject &jsonObject, JsonStateReader<T> stateReader) {
-        beginTransaction();
-        stateReader(_state, jsonObject);
-        endTransaction();
+    void read(JsonObject &jsonObject, const JsonStateReader<T> &stateReader) {
+        _lock.read(_state, [&](T &state) { stateReader(state, jsonObject); });
     }
 
-    void callUpdateHandlers(const String &originId) {
-        for (const StateUpdateHandlerInfo_t &updateHandler : _updateHandlers) {
-            updateHandler._cb(originId);
-        }
+    // Incremented by every update which changed the state, a reader seeing the same version sees the same state
+    uint32_t version() { return _version; }
+
+    void callUpdateHandlers(origin_id_t originId, field_mask_t fields = ALL_FIELDS) {
+        _updateHandlers.call(originId, fields);
     }
 
-    void callHookHandlers(const String &originId, StateUpdateResult &result) {
-        for (const StateHookHandlerInfo_t &hookHandler : _hookHandlers) {
-            hookHandler._cb(originId, result);
-        }
+    // From now on update handlers run on the update_dispatcher task, coalesced, and update() returns once the
+    // state is committed. Hook handlers still run inline as they can change the result.
+    void deferUpdateHandlers() {
+        _pendingUpdate.dispatch = [this](origin_id_t originId, field_mask_t fields) {
+            callUpdateHandlers(originId, fields);
+        };
     }
 
+    void dispatchUpdateHandlers(origin_id_t originId, field_mask_t fields = ALL_FIELDS) {
+        if (_pendingUpdate.dispatch) return update_dispatcher::schedule(_pendingUpdate, originId, fields);
+        callUpdateHandlers(originId, fields);
+    }
+
+    void callHookHandlers(origin_id_t originId, StateUpdateResult &result) { _hookHandlers.call(originId, result); }
+
   protected:
     T _state;
 
-    inline void beginTransaction() { xSemaphoreTakeRecursive(_accessMutex, portMAX_DELAY); }
+    inline void beginTransaction() { _lock.lock(); }
 
-    inline void endTransaction() { xSemaphoreGiveRecursive(_accessMutex); }
+    inline void endTransaction() { _lock.unlock(); }
 
   private:
-    SemaphoreHandle_t _accessMutex;
-    std::list<StateUpdateHandlerInfo_t> _updateHandlers;
-    std::list<StateHookHandlerInfo_t> _hookHandlers;
+    Lock _lock;
+    volatile uint32_t _version {0};
+    CallbackTable<void(origin_id_t originId, field_mask_t fields), STATE_MAX_UPDATE_HANDLERS> _updateHandlers;
+    CallbackTable<void(origin_id_t originId, StateUpdateResult &result), STATE_MAX_HOOK_HANDLERS> _hookHandlers;
+    update_dispatcher::PendingUpdate _pendingUpdate;
 };
 
 #endif // end StatefulService_h
@@ -2,7 +2,7 @@
 #include <Arduino.h>
 // favicon.png
 const uint8_t ESP_SVELTEKIT_DATA_0[] = {
-	0x1F,0x8B,0x08,0x00,0xDF,0x71,0x1B,0x67,0x02,0xFF,0x01,0x23,0x06,0xDC,0xF9,0x89,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x01,0x23,0x06,0xDC,0xF9,0x89,
 	0x50,0x4E,0x47,0x0D,0x0A,0x1A,0x0A,0x00,0x00,0x00,0x0D,0x49,0x48,0x44,0x52,0x00,
 	0x00,0x00,0x80,0x00,0x00,0x00,0x80,0x08,0x04,0x00,0x00,0x00,0x69,0x37,0xA9,0x40,
 	0x00,0x00,0x00,0x01,0x73,0x52,0x47,0x42,0x00,0xAE,0xCE,0x1C,0xE9,0x00,0x00,0x05,
@@ -106,7 +106,7 @@ const uint8_t ESP_SVELTEKIT_DATA_0[] = {
 
 // index.html
 const uint8_t ESP_SVELTEKIT_DATA_1[] = {
-	0x1F,0x8B,0x08,0x00,0xDF,0x71,0x1B,0x67,0x02,0xFF,0xAD,0x54,0x3D,0x6F,0xDB,0x30,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xAD,0x54,0x3D,0x6F,0xDB,0x30,
 	0x10,0x9D,0x15,0xA0,0xFF,0x81,0xE5,0x24,0x01,0x96,0x88,0xB6,0x4B,0xE1,0x88,0x5E,
 	0xD2,0xCC,0x0D,0xD0,0x2E,0x45,0x10,0x18,0xB4,0x78,0xB6,0x18,0x93,0x94,0x40,0x9E,
 	0x94,0xBA,0x41,0xFE,0x7B,0x49,0x51,0x72,0xD1,0xA9,0x45,0x9C,0x45,0xBC,0xCF,0xF7,
@@ -139,7 +139,7 @@ const uint8_t ESP_SVELTEKIT_DATA_1[] = {
 
 // manifest.json
 const uint8_t ESP_SVELTEKIT_DATA_2[] = {
-	0x1F,0x8B,0x08,0x00,0xDF,0x71,0x1B,0x67,0x02,0xFF,0x25,0x8D,0xCD,0x0A,0xC2,0x30,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x25,0x8D,0xCD,0x0A,0xC2,0x30,
 	0x10,0x84,0xCF,0x15,0x7C,0x87,0xB0,0x67,0x51,0x8C,0xB5,0x3F,0xDE,0x3D,0x79,0x11,
 	0x7A,0x14,0x91,0x50,0xB7,0x12,0x48,0xB7,0x25,0x49,0x4B,0x6A,0xF1,0xDD,0xCD,0xB6,
 	0x87,0x19,0xD8,0xFD,0x66,0x67,0xE7,0xED,0x26,0x01,0x52,0x2D,0xC2,0x45,0xC0,0xB5,
@@ -155,14 +155,14 @@ const uint8_t ESP_SVELTEKIT_DATA_2[] = {
 
 // _app/version.json
 const uint8_t ESP_SVELTEKIT_DATA_3[] = {
-	0x1F,0x8B,0x08,0x00,0xDF,0x71,0x1B,0x67,0x02,0xFF,0xAB,0x56,0x2A,0x4B,0x2D,0x2A,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xAB,0x56,0x2A,0x4B,0x2D,0x2A,
 	0xCE,0xCC,0xCF,0x53,0xB2,0x52,0x32,0x34,0x37,0xB2,0xB4,0x30,0x35,0xB4,0x30,0xB5,
 	0xB0,0x30,0x30,0x52,0xAA,0x05,0x00,0xF4,0xA5,0x14,0xCD,0x1B,0x00,0x00,0x00,
 };
 
 // _app/immutable/assets/0.css
 const uint8_t ESP_SVELTEKIT_DATA_4[] = {
-	0x1F,0x8B,0x08,0x00,0xDF,0x71,0x1B,0x67,0x02,0xFF,0xED,0x7D,0x6B,0x8F,0xE3,0x38,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xED,0x7D,0x6B,0x8F,0xE3,0x38,
 	0x92,0xE0,0xF7,0xFB,0x15,0x42,0x0D,0x12,0x99,0xAE,0xB2,0x94,0x92,0x6C,0xF9,0x89,
 	0x2A,0xCC,0x6E,0xDF,0xEE,0xDD,0xE1,0x66,0x06,0x7B,0x3B,0x7B,0x8B,0xE9,0xED,0x2E,
 	0x1C,0x64,0x5B,0xB6,0xD5,0x25,0x3F,0x46,0x92,0xF3,0xD1,0x42,0xCE,0x6F,0xBF,0x08,
@@ -1195,7 +1195,7 @@ const uint8_t ESP_SVELTEKIT_DATA_4[] = {
 
 // _app/immutable/assets/14.css
 const uint8_t ESP_SVELTEKIT_DATA_5[] = {
-	0x1F,0x8B,0x08,0x00,0xDF,0x71,0x1B,0x67,0x02,0xFF,0xB5,0x94,0xC1,0x4E,0xC3,0x30,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xB5,0x94,0xC1,0x4E,0xC3,0x30,
 	0x0C,0x86,0xEF,0x3C,0x05,0x1C,0xB8,0x00,0x41,0xE5,0xC0,0x81,0xF4,0x51,0xA6,0x1E,
 	0xB2,0xC4,0x6D,0xAC,0xA5,0x49,0xE5,0xB8,0x2D,0x6C,0xDA,0xBB,0x13,0x5A,0x8D,0x51,
 	0x75,0x45,0x1B,0x1A,0xB7,0xD8,0x6D,0xFC,0x7F,0x7F,0x62,0xC7,0x60,0xB7,0x32,0x8A,
@@ -1220,7 +1220,7 @@ const uint8_t ESP_SVELTEKIT_DATA_5[] = {
 
 // _app/immutable/assets/6.css
 const uint8_t ESP_SVELTEKIT_DATA_6[] = {
-	0x1F,0x8B,0x08,0x00,0xDF,0x71,0x1B,0x67,0x02,0xFF,0xAD,0x57,0x4D,0x8F,0xB3,0x36,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xAD,0x57,0x4D,0x8F,0xB3,0x36,
 	0x10,0xBE,0xF7,0x57,0x20,0xBD,0x8A,0x94,0x48,0xD8,0x6B,0x43,0x08,0x1F,0xB9,0x54,
 	0x2B,0xB5,0xEA,0x61,0x4F,0x55,0x2F,0xED,0xE5,0x95,0x03,0x4E,0x82,0x96,0x40,0x0A,
 	0xDE,0x8F,0x34,0xCA,0x7F,0xEF,0xD8,0x86,0x04,0x16,0x76,0x63,0x36,0x39,0x38,0x80,
@@ -1295,7 +1295,7 @@ const uint8_t ESP_SVELTEKIT_DATA_6[] = {
 
 // _app/immutable/assets/logo.png
 const uint8_t ESP_SVELTEKIT_DATA_7[] = {
-	0x1F,0x8B,0x08,0x00,0xDF,0x71,0x1B,0x67,0x02,0xFF,0x9C,0x7B,0x53,0x74,0x65,0x4D,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x9C,0x7B,0x53,0x74,0x65,0x4D,
 	0xF0,0xEF,0x20,0x9A,0x60,0xE2,0x9C,0xD8,0x99,0x4C,0x6C,0x9D,0xD8,0xB6,0x4E,0x6C,
 	0x3B,0x39,0xB1,0x26,0x9E,0xD8,0xD6,0xC4,0xB6,0x6D,0xDB,0xB6,0x6D,0xEB,0xE6,0xBB,
 	0x6B,0xFD,0x9F,0xEE,0x7D,0xB8,0xEB,0x3E,0xEC,0xB5,0x6A,0xEF,0xAA,0xEE,0xAE,0xAE,
@@ -2497,7 +2497,7 @@ const uint8_t ESP_SVELTEKIT_DATA_7[] = {
 
 // _app/immutable/assets/_layout.css
 const uint8_t ESP_SVELTEKIT_DATA_8[] = {
-	0x1F,0x8B,0x08,0x00,0xDF,0x71,0x1B,0x67,0x02,0xFF,0xED,0x7D,0x6B,0x8F,0xE3,0x38,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xED,0x7D,0x6B,0x8F,0xE3,0x38,
 	0x92,0xE0,0xF7,0xFB,0x15,0x42,0x0D,0x12,0x99,0xAE,0xB2,0x94,0x92,0x6C,0xF9,0x89,
 	0x2A,0xCC,0x6E,0xDF,0xEE,0xDD,0xE1,0x66,0x06,0x7B,0x3B,0x7B,0x8B,0xE9,0xED,0x2E,
 	0x1C,0x64,0x5B,0xB6,0xD5,0x25,0x3F,0x46,0x92,0xF3,0xD1,0x42,0xCE,0x6F,0xBF,0x08,
@@ -3529,7 +3529,7 @@ const uint8_t ESP_SVELTEKIT_DATA_8[] = {
 
 // _app/immutable/assets/_page.css
 const uint8_t ESP_SVELTEKIT_DATA_9[] = {
-	0x1F,0x8B,0x08,0x00,0xDF,0x71,0x1B,0x67,0x02,0xFF,0xAD,0x57,0x4D,0x8F,0xB3,0x36,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xAD,0x57,0x4D,0x8F,0xB3,0x36,
 	0x10,0xBE,0xF7,0x57,0x20,0xBD,0x8A,0x94,0x48,0xD8,0x6B,0x43,0x08,0x1F,0xB9,0x54,
 	0x2B,0xB5,0xEA,0x61,0x4F,0x55,0x2F,0xED,0xE5,0x95,0x03,0x4E,0x82,0x96,0x40,0x0A,
 	0xDE,0x8F,0x34,0xCA,0x7F,0xEF,0xD8,0x86,0x04,0x16,0x76,0x63,0x36,0x39,0x38,0x80,
@@ -3604,7 +3604,7 @@ const uint8_t ESP_SVELTEKIT_DATA_9[] = {
 
 // _app/immutable/assets/_page2.css
 const uint8_t ESP_SVELTEKIT_DATA_10[] = {
-	0x1F,0x8B,0x08,0x00,0xDF,0x71,0x1B,0x67,0x02,0xFF,0xB5,0x94,0xC1,0x4E,0xC3,0x30,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xB5,0x94,0xC1,0x4E,0xC3,0x30,
 	0x0C,0x86,0xEF,0x3C,0x05,0x1C,0xB8,0x00,0x41,0xE5,0xC0,0x81,0xF4,0x51,0xA6,0x1E,
 	0xB2,0xC4,0x6D,0xAC,0xA5,0x49,0xE5,0xB8,0x2D,0x6C,0xDA,0xBB,0x13,0x5A,0x8D,0x51,
 	0x75,0x45,0x1B,0x1A,0xB7,0xD8,0x6D,0xFC,0x7F,0x7F,0x62,0xC7,0x60,0xB7,0x32,0x8A,
@@ -3629,7 +3629,7 @@ const uint8_t ESP_SVELTEKIT_DATA_10[] = {
 
 // _app/immutable/chunks/24-hours.js
 const uint8_t ESP_SVELTEKIT_DATA_11[] = {
-	0x1F,0x8B,0x08,0x00,0xDF,0x71,0x1B,0x67,0x02,0xFF,0x9D,0x53,0x5D,0x6F,0xDB,0x20,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x9D,0x53,0x5D,0x6F,0xDB,0x20,
 	0x14,0x7D,0xDF,0xAF,0xA0,0x56,0x95,0x82,0x76,0xED,0xDA,0x4E,0xD2,0x65,0x75,0xA9,
 	0xB4,0x4E,0x93,0xFA,0xB2,0xA7,0x3D,0x46,0x51,0xE5,0xDA,0xC4,0xD0,0xDA,0x90,0x02,
 	0x76,0x22,0x21,0xFF,0xF7,0x81,0xB3,0x7E,0xA4,0x8F,0x93,0x6D,0x0E,0x5C,0xCE,0x3D,
@@ -3673,7 +3673,7 @@ const uint8_t ESP_SVELTEKIT_DATA_11[] = {
 
 // _app/immutable/chunks/access-point.js
 const uint8_t ESP_SVELTEKIT_DATA_12[] = {
-	0x1F,0x8B,0x08,0x00,0xDF,0x71,0x1B,0x67,0x02,0xFF,0x9D,0x53,0xD1,0x6E,0xDB,0x20,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x9D,0x53,0xD1,0x6E,0xDB,0x20,
 	0x14,0x7D,0xDF,0x57,0x50,0x54,0xA5,0xA0,0xDD,0xB8,0xB6,0x9B,0x56,0x69,0x5D,0x2A,
 	0xAD,0xD3,0xA4,0xBE,0xEC,0x69,0x8F,0x51,0x54,0x51,0x9B,0xC4,0xB4,0x18,0x52,0xC0,
 	0x49,0x24,0xE4,0x7F,0x2F,0x38,0x6B,0x97,0x6E,0x6F,0x93,0x6D,0x0E,0xBE,0xF7,0xDC,
@@ -3715,7 +3715,7 @@ const uint8_t ESP_SVELTEKIT_DATA_12[] = {
 
 // _app/immutable/chunks/alert-triangle.js
 const uint8_t ESP_SVELTEKIT_DATA_13[] = {
-	0x1F,0x8B,0x08,0x00,0xDF,0x71,0x1B,0x67,0x02,0xFF,0x9D,0x53,0xD1,0x6E,0xDB,0x20,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x9D,0x53,0xD1,0x6E,0xDB,0x20,
 	0x14,0x7D,0xDF,0x57,0x50,0xAB,0xCA,0x40,0xBB,0xA1,0xC6,0x49,0x9B,0xA5,0x2E,0x95,
 	0xD6,0x69,0x52,0x1F,0xDA,0xA7,0x3D,0x46,0x51,0x65,0xD9,0x24,0xA6,0xC5,0x90,0x02,
 	0x4E,0xA2,0x21,0xFF,0xFB,0x20,0x59,0xBB,0x76,0xD3,0x5E,0x26,0xDB,0x1C,0x7C,0xEF,
@@ -3758,7 +3758,7 @@ const uint8_t ESP_SVELTEKIT_DATA_13[] = {
 
 // _app/immutable/chunks/await_block.js
 const uint8_t ESP_SVELTEKIT_DATA_14[] = {
-	0x1F,0x8B,0x08,0x00,0xDF,0x71,0x1B,0x67,0x02,0xFF,0x5D,0x53,0xCB,0x8E,0xDB,0x30,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x5D,0x53,0xCB,0x8E,0xDB,0x30,
 	0x0C,0xBC,0xF7,0x2B,0x9C,0x3D,0x18,0x12,0x40,0xA8,0x49,0x8F,0x6B,0xA8,0x3D,0x14,
 	0xBD,0xEE,0xF6,0x1E,0x04,0x81,0x23,0x33,0x91,0x1B,0x59,0x4A,0xF5,0x48,0x02,0x18,
 	0xFE,0xF7,0x52,0x7E,0x6C,0xDD,0xC2,0x07,0xCA,0xE4,0xCC,0x90,0x1E,0x53,0x6D,0x77,
@@ -3795,7 +3795,7 @@ const uint8_t ESP_SVELTEKIT_DATA_14[] = {
 
 // _app/immutable/chunks/chart.js
 const uint8_t ESP_SVELTEKIT_DATA_15[] = {
-	0x1F,0x8B,0x08,0x00,0xDF,0x71,0x1B,0x67,0x02,0xFF,0xD4,0xBD,0x7D,0x7F,0xDB,0x36,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xD4,0xBD,0x7D,0x7F,0xDB,0x36,
 	0xD2,0x28,0xFA,0xFF,0xFD,0x14,0x36,0x9F,0xC4,0x4B,0x5A,0x90,0x2C,0xC9,0x71,0xE2,
 	0x50,0xA6,0x75,0x92,0x26,0x69,0xD3,0xE6,0xAD,0x71,0xDA,0x6E,0xEA,0xD5,0x71,0x29,
 	0x12,0x92,0xD8,0xD0,0xA4,0x96,0xA0,0xFC,0x12,0x59,0xDF,0xFD,0xCC,0x0C,0x5E,0x29,
@@ -8178,7 +8178,7 @@ const uint8_t ESP_SVELTEKIT_DATA_15[] = {
 
 // _app/immutable/chunks/clock-check.js
 const uint8_t ESP_SVELTEKIT_DATA_16[] = {
-	0x1F,0x8B,0x08,0x00,0xDF,0x71,0x1B,0x67,0x02,0xFF,0x9D,0x53,0xC1,0x4E,0xE3,0x30,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x9D,0x53,0xC1,0x4E,0xE3,0x30,
 	0x10,0xBD,0xEF,0x57,0x18,0x0B,0x15,0x5B,0x3B,0x84,0x34,0x74,0xB7,0x2A,0xC1,0x1C,
 	0x40,0x2B,0x71,0xD9,0xD3,0x1E,0xAB,0x0A,0x85,0x64,0x9A,0x18,0x1C,0xBB,0x6B,0x3B,
 	0x6D,0x25,0x2B,0xFF,0x8E,0xDD,0x2E,0x6C,0xD9,0xE3,0x4A,0x49,0x9E,0x33,0xF3,0xFC,
@@ -8220,7 +8220,7 @@ const uint8_t ESP_SVELTEKIT_DATA_16[] = {
 
 // _app/immutable/chunks/Collapsible.js
 const uint8_t ESP_SVELTEKIT_DATA_17[] = {
-	0x1F,0x8B,0x08,0x00,0xDF,0x71,0x1B,0x67,0x02,0xFF,0xAD,0x56,0x59,0x6F,0xDB,0x38,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xAD,0x56,0x59,0x6F,0xDB,0x38,
 	0x10,0x7E,0xDF,0x5F,0xA1,0x08,0x81,0x40,0xA1,0x23,0xAF,0x73,0x6C,0x51,0xD8,0x50,
 	0x83,0x26,0xBD,0xD2,0x23,0x4D,0x9B,0xA3,0xDD,0x06,0x41,0x20,0x4B,0x94,0xCD,0x84,
 	0x3A,0x4A,0x52,0xB1,0x53,0x45,0xFF,0x7D,0x67,0x48,0x39,0x71,0xB6,0xED,0x62,0x1F,
@@ -8318,7 +8318,7 @@ const uint8_t ESP_SVELTEKIT_DATA_17[] = {
 
 // _app/immutable/chunks/compareVersions.js
 const uint8_t ESP_SVELTEKIT_DATA_18[] = {
-	0x1F,0x8B,0x08,0x00,0xDF,0x71,0x1B,0x67,0x02,0xFF,0xED,0x5A,0x79,0x73,0xDB,0xB8,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xED,0x5A,0x79,0x73,0xDB,0xB8,
 	0x0E,0xFF,0xFF,0x7D,0x0A,0x45,0xD3,0x71,0xA5,0x96,0xD2,0xDA,0xCE,0xD1,0xD6,0xAE,
 	0xEA,0xC9,0xD5,0x34,0x6D,0x73,0x34,0x49,0x4F,0xD7,0xDB,0x27,0x4B,0xB4,0xAD,0x46,
 	0x96,0x54,0x89,0xF2,0x51,0xC7,0xEF,0xB3,0xBF,0x1F,0x48,0xF9,0xCA,0xB5,0x6F,0xDF,
@@ -8527,7 +8527,7 @@ const uint8_t ESP_SVELTEKIT_DATA_18[] = {
 
 // _app/immutable/chunks/ConfirmDialog.js
 const uint8_t ESP_SVELTEKIT_DATA_19[] = {
-	0x1F,0x8B,0x08,0x00,0xDF,0x71,0x1B,0x67,0x02,0xFF,0xED,0x5B,0x79,0x73,0xDB,0xB8,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xED,0x5B,0x79,0x73,0xDB,0xB8,
 	0x92,0xFF,0x7F,0x3F,0x85,0xCC,0xCD,0x2A,0xE4,0x33,0xC4,0x48,0xCE,0x31,0x13,0x2A,
 	0x88,0xD7,0x71,0x94,0x63,0x7C,0x66,0xE2,0x78,0x32,0xA3,0xA7,0xE7,0x47,0x89,0x90,
 	0x44,0x9B,0x22,0x19,0x1E,0x3A,0x2C,0x69,0x3F,0xFB,0xFE,0x1A,0xE0,0x25,0x59,0x49,
@@ -8880,7 +8880,7 @@ const uint8_t ESP_SVELTEKIT_DATA_19[] = {
 
 // _app/immutable/chunks/each.js
 const uint8_t ESP_SVELTEKIT_DATA_20[] = {
-	0x1F,0x8B,0x08,0x00,0xDF,0x71,0x1B,0x67,0x02,0xFF,0x55,0x53,0x4B,0x6F,0xA3,0x30,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x55,0x53,0x4B,0x6F,0xA3,0x30,
 	0x10,0xBE,0xEF,0xAF,0xA0,0x3D,0x20,0x8F,0x34,0x78,0x37,0x57,0x90,0x1B,0xF5,0x21,
 	0xB5,0x3D,0xE4,0x94,0x23,0x8A,0x22,0x16,0xEC,0xE0,0x84,0xD8,0x14,0x9B,0x3C,0x4A,
 	0xF9,0xEF,0x6B,0xE3,0xA4,0xE9,0x8A,0xC3,0x3C,0xBF,0x99,0x6F,0x66,0xB0,0xDC,0xB7,
@@ -8918,7 +8918,7 @@ const uint8_t ESP_SVELTEKIT_DATA_20[] = {
 
 // _app/immutable/chunks/home.js
 const uint8_t ESP_SVELTEKIT_DATA_21[] = {
-	0x1F,0x8B,0x08,0x00,0xDF,0x71,0x1B,0x67,0x02,0xFF,0xED,0x55,0x5D,0x6B,0xDB,0x30,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xED,0x55,0x5D,0x6B,0xDB,0x30,
 	0x14,0x7D,0xDF,0xAF,0x50,0xCD,0xC8,0x24,0x76,0xED,0xDA,0xCA,0x77,0x53,0xF5,0xA1,
 	0xDD,0x20,0x2F,0x7D,0x1A,0xEC,0x25,0x84,0xE1,0xD9,0x8A,0xA5,0xD5,0x91,0x53,0x49,
 	0x76,0x02,0xC6,0xFF,0x7D,0x92,0xB3,0xB6,0xEE,0xDE,0x36,0x06,0x63,0x30,0x12,0x7C,
@@ -8969,7 +8969,7 @@ const uint8_t ESP_SVELTEKIT_DATA_21[] = {
 
 // _app/immutable/chunks/index.js
 const uint8_t ESP_SVELTEKIT_DATA_22[] = {
-	0x1F,0x8B,0x08,0x00,0xDF,0x71,0x1B,0x67,0x02,0xFF,0x7D,0x58,0x6B,0x73,0x9B,0xC8,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x7D,0x58,0x6B,0x73,0x9B,0xC8,
 	0x12,0xFD,0xBE,0xBF,0x42,0xA6,0xB4,0xAA,0x21,0x1A,0x11,0xA9,0xB2,0x9B,0xBA,0x05,
 	0x1E,0xEB,0x26,0x59,0x67,0x9F,0x59,0x7B,0xED,0x6C,0xF6,0xE1,0xF2,0x95,0x11,0x0C,
 	0x02,0x1B,0x81,0x16,0x06,0x4B,0x0A,0xE2,0xBF,0xDF,0xD3,0x03,0x08,0x9C,0xE4,0xDE,
@@ -9149,7 +9149,7 @@ const uint8_t ESP_SVELTEKIT_DATA_22[] = {
 
 // _app/immutable/chunks/index2.js
 const uint8_t ESP_SVELTEKIT_DATA_23[] = {
-	0x1F,0x8B,0x08,0x00,0xDF,0x71,0x1B,0x67,0x02,0xFF,0x8D,0x55,0xD1,0x8E,0x9B,0x3A,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x8D,0x55,0xD1,0x8E,0x9B,0x3A,
 	0x10,0x7D,0xDE,0x7E,0x05,0x45,0xA8,0xC2,0x59,0x87,0x1B,0xAA,0x3E,0x81,0xDC,0x3E,
 	0xAC,0xB4,0x6F,0x7D,0xAA,0xAE,0xEE,0x43,0x14,0x6D,0x1C,0x18,0xC0,0x2D,0xD8,0xC8,
 	0x1E,0x76,0x17,0x51,0xFF,0xFB,0xB5,0x43,0xC8,0x66,0xD3,0xAE,0xB4,0x8A,0xC4,0xE0,
@@ -9201,7 +9201,7 @@ const uint8_t ESP_SVELTEKIT_DATA_23[] = {
 
 // _app/immutable/chunks/index3.js
 const uint8_t ESP_SVELTEKIT_DATA_24[] = {
-	0x1F,0x8B,0x08,0x00,0xDF,0x71,0x1B,0x67,0x02,0xFF,0x55,0x91,0xC1,0x6E,0xC3,0x20,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x55,0x91,0xC1,0x6E,0xC3,0x20,
 	0x0C,0x86,0xEF,0x7B,0x0A,0xD6,0x43,0x84,0x55,0x94,0xA5,0x3B,0x96,0xB1,0x97,0xD8,
 	0x31,0xCA,0xA1,0x49,0xCC,0x42,0x95,0x42,0x84,0x41,0x9D,0x96,0xF2,0xEE,0x83,0xB5,
 	0x6B,0xB5,0x93,0x85,0xF9,0xFD,0xFB,0xFB,0x65,0x73,0x5A,0x9C,0x0F,0xAB,0x65,0x07,
@@ -9224,7 +9224,7 @@ const uint8_t ESP_SVELTEKIT_DATA_24[] = {
 
 // _app/immutable/chunks/InfoDialog.js
 const uint8_t ESP_SVELTEKIT_DATA_25[] = {
-	0x1F,0x8B,0x08,0x00,0xDF,0x71,0x1B,0x67,0x02,0xFF,0x7D,0x56,0x59,0x73,0xDB,0x38,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x7D,0x56,0x59,0x73,0xDB,0x38,
 	0x12,0x7E,0xDF,0x5F,0xC1,0xB0,0x52,0x2C,0xA0,0xB6,0xC9,0x95,0x14,0x3B,0x0F,0x52,
 	0x71,0x53,0x89,0xE5,0x49,0x9C,0xC3,0xF6,0x4C,0x12,0xCF,0x4C,0x52,0xAE,0x14,0x45,
 	0x36,0x25,0xC4,0xBC,0x42,0x82,0x96,0x64,0x46,0xFF,0x7D,0xBB,0x01,0xEA,0xB0,0x9D,
@@ -9330,7 +9330,7 @@ const uint8_t ESP_SVELTEKIT_DATA_25[] = {
 
 // _app/immutable/chunks/InputPassword.js
 const uint8_t ESP_SVELTEKIT_DATA_26[] = {
-	0x1F,0x8B,0x08,0x00,0xDF,0x71,0x1B,0x67,0x02,0xFF,0xCD,0x57,0xDF,0x73,0x9B,0x38,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xCD,0x57,0xDF,0x73,0x9B,0x38,
 	0x10,0x7E,0xBF,0xBF,0x42,0xD5,0x74,0x3C,0x30,0xB7,0x10,0xC0,0x8E,0xED,0xC4,0x43,
 	0x3B,0xD7,0x26,0x6D,0xF3,0x90,0xB6,0x33,0xFD,0xF1,0x92,0xC9,0x74,0x30,0xC8,0x46,
 	0x31,0x06,0x2A,0x84,0xB1,0x43,0xFD,0xBF,0xDF,0x4A,0xE0,0x18,0x27,0x6E,0x2F,0x8F,
@@ -9424,7 +9424,7 @@ const uint8_t ESP_SVELTEKIT_DATA_26[] = {
 
 // _app/immutable/chunks/logo.js
 const uint8_t ESP_SVELTEKIT_DATA_27[] = {
-	0x1F,0x8B,0x08,0x00,0xDF,0x71,0x1B,0x67,0x02,0xFF,0x4B,0xCE,0xCF,0x2B,0x2E,0x51,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x4B,0xCE,0xCF,0x2B,0x2E,0x51,
 	0xC8,0xB7,0x55,0x52,0xD2,0xCE,0x4B,0x2D,0x57,0x08,0x0D,0xF2,0xD1,0x50,0xD2,0xD3,
 	0xD3,0x4F,0x2C,0x2E,0x4E,0x2D,0x29,0xD6,0xCF,0xC9,0x4F,0xCF,0xD7,0x2B,0xC8,0x4B,
 	0x57,0xD2,0xC9,0xCC,0x2D,0xC8,0x2F,0x2A,0xD1,0xCB,0x4D,0x2D,0x49,0xD4,0x2B,0x2D,
@@ -9434,7 +9434,7 @@ const uint8_t ESP_SVELTEKIT_DATA_27[] = {
 
 // _app/immutable/chunks/navigation.js
 const uint8_t ESP_SVELTEKIT_DATA_28[] = {
-	0x1F,0x8B,0x08,0x00,0xDF,0x71,0x1B,0x67,0x02,0xFF,0xCB,0xCC,0x2D,0xC8,0x2F,0x2A,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xCB,0xCC,0x2D,0xC8,0x2F,0x2A,
 	0xA9,0xCE,0x52,0x48,0x2C,0x56,0xC8,0xAF,0x4D,0x2B,0xCA,0xCF,0x55,0xD2,0xD3,0x2F,
 	0xCE,0xCC,0x4B,0xCF,0x49,0x2D,0xC9,0xCF,0x2B,0xD6,0xCB,0x2A,0x56,0xB2,0x4E,0x06,
 	0x32,0x4A,0x14,0x52,0x6D,0xF3,0x35,0x94,0xD2,0xF3,0x4B,0xF2,0x95,0x34,0xAD,0x53,
@@ -9444,7 +9444,7 @@ const uint8_t ESP_SVELTEKIT_DATA_28[] = {
 
 // _app/immutable/chunks/notifications.js
 const uint8_t ESP_SVELTEKIT_DATA_29[] = {
-	0x1F,0x8B,0x08,0x00,0xDF,0x71,0x1B,0x67,0x02,0xFF,0x5D,0x52,0xC1,0x4E,0xE5,0x30,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x5D,0x52,0xC1,0x4E,0xE5,0x30,
 	0x0C,0xBC,0xF3,0x15,0xA5,0xA7,0x44,0x1B,0x85,0x15,0x48,0x48,0x9B,0xCA,0xE5,0xCC,
 	0x61,0x4F,0xCB,0x0D,0x21,0x14,0x12,0x17,0x82,0x5E,0x93,0x2A,0x71,0x16,0x50,0xC9,
 	0xBF,0x93,0xB6,0xEF,0xC1,0xD3,0xBB,0x45,0x93,0xB1,0x3D,0x33,0xB6,0x1B,0xA7,0x10,
@@ -9472,7 +9472,7 @@ const uint8_t ESP_SVELTEKIT_DATA_29[] = {
 
 // _app/immutable/chunks/pencil.js
 const uint8_t ESP_SVELTEKIT_DATA_30[] = {
-	0x1F,0x8B,0x08,0x00,0xDF,0x71,0x1B,0x67,0x02,0xFF,0xED,0x55,0x5D,0x6F,0x9B,0x30,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xED,0x55,0x5D,0x6F,0x9B,0x30,
 	0x14,0x7D,0xDF,0xAF,0x70,0x51,0x95,0xDA,0xDA,0x85,0x02,0x25,0x69,0x5A,0xEA,0x3E,
 	0xAC,0x9A,0xD4,0x87,0x44,0xAA,0xB4,0x6A,0x2F,0x51,0x54,0x21,0x70,0x82,0x5B,0x63,
 	0x32,0xDB,0x90,0x68,0x88,0xFF,0x3E,0x9B,0x2C,0x5D,0xBA,0xB7,0x4D,0x93,0xB6,0x87,
@@ -9519,7 +9519,7 @@ const uint8_t ESP_SVELTEKIT_DATA_30[] = {
 
 // _app/immutable/chunks/reload.js
 const uint8_t ESP_SVELTEKIT_DATA_31[] = {
-	0x1F,0x8B,0x08,0x00,0xDF,0x71,0x1B,0x67,0x02,0xFF,0x9D,0x53,0x4D,0x6F,0xE3,0x20,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x9D,0x53,0x4D,0x6F,0xE3,0x20,
 	0x14,0xBC,0xEF,0xAF,0xA0,0xA8,0x4A,0x41,0xFB,0x42,0xED,0x7C,0x28,0x49,0x5D,0x7A,
 	0xE8,0x6A,0xA5,0x5E,0xF6,0xB2,0x3D,0x46,0x51,0x65,0xD9,0xC4,0xA6,0xC5,0x90,0x02,
 	0x4E,0x22,0x21,0xFF,0xF7,0x85,0x64,0xFB,0xB5,0xC7,0x95,0x6C,0x0F,0x9E,0x37,0x0C,
@@ -9561,7 +9561,7 @@ const uint8_t ESP_SVELTEKIT_DATA_31[] = {
 
 // _app/immutable/chunks/report-analytics.js
 const uint8_t ESP_SVELTEKIT_DATA_32[] = {
-	0x1F,0x8B,0x08,0x00,0xDF,0x71,0x1B,0x67,0x02,0xFF,0x9D,0x55,0x5B,0x6F,0xAB,0x38,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x9D,0x55,0x5B,0x6F,0xAB,0x38,
 	0x10,0x7E,0xDF,0x5F,0x41,0xD1,0x51,0x8F,0xD1,0x1A,0x1A,0xE8,0xA9,0x56,0x1B,0xEA,
 	0x4A,0xDB,0x76,0xA5,0xBE,0xEC,0xCB,0x9E,0xA3,0xBE,0x44,0x51,0xE4,0xC2,0x24,0xF8,
 	0xD4,0x60,0x6A,0x9B,0x24,0x12,0xE2,0xBF,0xEF,0x18,0x1A,0x02,0xD9,0x7D,0x5A,0xE5,
@@ -9619,7 +9619,7 @@ const uint8_t ESP_SVELTEKIT_DATA_32[] = {
 
 // _app/immutable/chunks/RSSIIndicator.js
 const uint8_t ESP_SVELTEKIT_DATA_33[] = {
-	0x1F,0x8B,0x08,0x00,0xDF,0x71,0x1B,0x67,0x02,0xFF,0xED,0x59,0x6D,0x73,0xDB,0x36,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xED,0x59,0x6D,0x73,0xDB,0x36,
 	0x12,0xFE,0x7E,0xBF,0x82,0xE6,0x64,0x54,0x70,0xBA,0x62,0x44,0xCA,0x72,0x54,0x29,
 	0x88,0x27,0x8E,0xD3,0x26,0x6D,0x9D,0xA6,0xCD,0x4B,0x5F,0x34,0x1A,0x0F,0x4D,0x41,
 	0x22,0x62,0x8A,0x64,0x40,0x50,0xB2,0xC3,0xEA,0xBF,0x77,0x17,0x14,0x25,0xCA,0x76,
@@ -9741,7 +9741,7 @@ const uint8_t ESP_SVELTEKIT_DATA_33[] = {
 
 // _app/immutable/chunks/scheduler.js
 const uint8_t ESP_SVELTEKIT_DATA_34[] = {
-	0x1F,0x8B,0x08,0x00,0xDF,0x71,0x1B,0x67,0x02,0xFF,0xAD,0x19,0x6D,0x6F,0xDB,0x36,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xAD,0x19,0x6D,0x6F,0xDB,0x36,
 	0xF3,0xFB,0xF3,0x2B,0x1C,0xA1,0x08,0xA4,0x85,0x51,0xEC,0xED,0xCB,0x03,0x2B,0x8A,
 	0x91,0x26,0x6E,0xD3,0x2D,0x49,0x5F,0xE2,0xAD,0xEB,0x0C,0xC3,0x93,0x25,0xDA,0x66,
 	0x2B,0x53,0xAE,0x48,0xD9,0x71,0x1D,0xFF,0xF7,0xE7,0x8E,0x14,0x25,0xCA,0x4E,0x30,
@@ -9934,7 +9934,7 @@ const uint8_t ESP_SVELTEKIT_DATA_34[] = {
 
 // _app/immutable/chunks/SettingsCard.js
 const uint8_t ESP_SVELTEKIT_DATA_35[] = {
-	0x1F,0x8B,0x08,0x00,0xDF,0x71,0x1B,0x67,0x02,0xFF,0xBD,0x58,0xFF,0x8F,0xDB,0xB6,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xBD,0x58,0xFF,0x8F,0xDB,0xB6,
 	0x0E,0xFF,0xFD,0xFD,0x15,0xAE,0x51,0x78,0x32,0x26,0x67,0xC9,0xB5,0x38,0xBC,0x97,
 	0xCC,0x3D,0xB4,0xD7,0x6E,0xED,0xB6,0x7E,0xD9,0xAE,0xBD,0x76,0x2F,0x08,0x02,0xC7,
 	0x96,0x63,0x5D,0x6C,0xC9,0xB5,0xE5,0x24,0x6D,0x2E,0xFF,0xFB,0x48,0xCA,0x49,0x7C,
@@ -10077,7 +10077,7 @@ const uint8_t ESP_SVELTEKIT_DATA_35[] = {
 
 // _app/immutable/chunks/singletons.js
 const uint8_t ESP_SVELTEKIT_DATA_36[] = {
-	0x1F,0x8B,0x08,0x00,0xDF,0x71,0x1B,0x67,0x02,0xFF,0x95,0x56,0x6D,0x6F,0xDB,0x36,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x95,0x56,0x6D,0x6F,0xDB,0x36,
 	0x10,0xFE,0xBE,0x5F,0x21,0x0B,0x85,0x41,0x62,0x8C,0x12,0xA7,0x2B,0x96,0x49,0x60,
 	0x83,0x6C,0x28,0x8A,0x00,0x45,0x5A,0xE4,0x6D,0x1B,0xBA,0xC2,0x61,0x24,0x4A,0x62,
 	0x42,0x93,0x02,0x49,0xD9,0xF1,0x64,0xFD,0xF7,0x1D,0x45,0xF9,0x25,0x1D,0x30,0x60,
@@ -10162,56 +10162,59 @@ const uint8_t ESP_SVELTEKIT_DATA_36[] = {
 
 // _app/immutable/chunks/socket.js
 const uint8_t ESP_SVELTEKIT_DATA_37[] = {
-	0x1F,0x8B,0x08,0x00,0xDF,0x71,0x1B,0x67,0x02,0xFF,0x95,0x54,0xC1,0x6E,0xDB,0x30,
-	0x0C,0xBD,0xEF,0x2B,0x1C,0xA3,0x28,0x24,0x54,0x70,0xDA,0x15,0xBB,0xC4,0x50,0x86,
-	0x0D,0xC8,0x61,0x03,0xD6,0x0C,0x48,0x80,0x1E,0x82,0x02,0x55,0x6C,0x3A,0xD5,0xE2,
-	0x50,0x86,0x24,0xB7,0xCD,0x6C,0xFF,0xFB,0x64,0xD9,0x49,0x9C,0x6E,0x3B,0xF4,0x12,
-	0xC7,0x94,0xF8,0xF8,0xF8,0xF8,0x68,0xB9,0x2B,0x94,0xB6,0xD5,0x4B,0x93,0x69,0xB5,
-	0x0B,0xA3,0xB1,0xC4,0x14,0x5E,0x6F,0xA3,0x5F,0x26,0x8C,0x13,0x85,0xC6,0x06,0x33,
-	0xBE,0x0A,0x55,0x01,0x18,0xB2,0x30,0xC9,0x95,0x01,0xF7,0x04,0xAD,0x95,0x76,0xCF,
-	0x1D,0x18,0x23,0x36,0x6D,0xA4,0x44,0x0D,0xA6,0x70,0xF7,0xE5,0x33,0x84,0x0F,0x71,
-	0x56,0x62,0x62,0xA5,0xC2,0xE0,0x95,0xD0,0x2A,0x07,0x1B,0x68,0x8E,0xF0,0x12,0xFC,
-	0x10,0x45,0x07,0x5A,0x99,0x72,0x6D,0x12,0x2D,0xD7,0x30,0x59,0x30,0x03,0x76,0x22,
-	0x1A,0xFE,0x42,0x46,0x37,0x94,0xE5,0xFC,0x13,0xDC,0xC6,0x6D,0x4A,0xC2,0x4A,0xA6,
-	0x58,0x7A,0xC2,0xDA,0x12,0xA0,0x55,0xCA,0x81,0xAD,0x09,0x6D,0x8E,0xD1,0x8C,0x00,
-	0xB3,0xB4,0x7A,0x16,0x3A,0xC0,0x58,0x45,0x9E,0x22,0xA1,0x4C,0x78,0xB4,0x24,0x07,
-	0xA1,0x97,0x72,0x07,0xAA,0xB4,0x24,0x79,0xF3,0x5E,0x52,0x46,0x90,0xEB,0x68,0x03,
-	0xD6,0x21,0x53,0xCE,0xB1,0xCC,0xF3,0xBA,0xC6,0x28,0x53,0x7A,0x26,0x92,0x27,0x62,
-	0xF8,0xD4,0x10,0x4B,0x29,0x2B,0xB9,0xE3,0x78,0x48,0x5B,0xB3,0x7C,0x50,0xDE,0x71,
-	0xA9,0x94,0x6F,0xEE,0x1E,0xD6,0x0B,0x95,0x6C,0x1D,0x58,0x4A,0x99,0x8A,0x14,0xB6,
-	0xA2,0x71,0xE0,0x53,0xCF,0xCD,0xC6,0x8E,0xD1,0xF5,0x3F,0x18,0xD8,0x9E,0x41,0xA7,
-	0xF1,0x89,0x86,0x3D,0xD2,0x40,0x3E,0xC5,0x96,0x60,0xEC,0x02,0xA4,0x9B,0x09,0x06,
-	0x2A,0x0B,0x74,0xB4,0x85,0xBD,0x21,0x94,0xCE,0x22,0x89,0x49,0x5E,0xA6,0x60,0x08,
-	0xD2,0xBA,0xDE,0xB8,0xDF,0xC6,0x33,0xE8,0xE7,0x73,0x24,0x51,0xB0,0x65,0xBC,0x27,
-	0xD4,0xCB,0x6B,0x39,0x44,0xA9,0xB0,0x22,0x96,0x19,0xB1,0x81,0x74,0xA8,0x02,0x13,
-	0x70,0xB0,0x5F,0xB4,0x16,0xFB,0xAF,0x65,0x96,0x81,0xA6,0x15,0x29,0x0E,0xF4,0xD6,
-	0x12,0x85,0xDE,0x0F,0x08,0x16,0x47,0x82,0x92,0x4F,0x65,0xAB,0x53,0xAC,0xC1,0x96,
-	0x1A,0x9B,0x16,0x91,0xDB,0xA8,0x9D,0xB1,0xD5,0x12,0x37,0xC4,0x4D,0x62,0x64,0x69,
-	0x77,0xEA,0x8B,0xE3,0xD9,0xB1,0x8D,0xBC,0xE9,0xE6,0x19,0x09,0xC7,0x21,0xBD,0xBA,
-	0x61,0x83,0xC0,0xCA,0x55,0x64,0xE6,0x7F,0xD7,0x57,0xFD,0xF5,0x5C,0x18,0xFB,0xED,
-	0x10,0x7C,0x70,0x29,0xB1,0xD5,0xFB,0xCA,0xF0,0xEF,0x8B,0xF9,0x5D,0x54,0x08,0xED,
-	0x2C,0x61,0x68,0x93,0x08,0x9B,0x3C,0x55,0x0D,0x5E,0x5E,0x12,0xB2,0xEC,0xFB,0xC2,
-	0x53,0x43,0xCB,0xF3,0x86,0x0C,0xA5,0xBD,0x8C,0xDE,0xEE,0xAD,0x88,0x0E,0xBC,0xB7,
-	0x3E,0x74,0x23,0xF6,0x6E,0xEB,0x4F,0xFA,0xE5,0x80,0x81,0x39,0x76,0x9D,0x37,0xBB,
-	0x8E,0x0F,0x46,0x8B,0xDB,0xFA,0x18,0x19,0xF9,0x1B,0xEA,0xFA,0xC9,0x05,0x98,0xFD,
-	0x8C,0x27,0xF3,0xA5,0xE0,0xAE,0x83,0x93,0x73,0xA2,0x0F,0xFF,0xDD,0xEC,0x4F,0x98,
-	0x6E,0x7E,0xD5,0x5F,0xB6,0x1E,0xFA,0x93,0x50,0x4F,0xE7,0x6C,0x23,0xE9,0x99,0x67,
-	0xE7,0x1D,0xAD,0x91,0xAA,0x6B,0x15,0x69,0x10,0xE9,0x7E,0x61,0x85,0x85,0x11,0xE7,
-	0x47,0x0F,0x47,0xF3,0x9F,0xB3,0xBB,0xF6,0xD8,0x00,0xA6,0xE4,0xF1,0xE3,0xF8,0xA2,
-	0x82,0x66,0x75,0x51,0x79,0x41,0xBB,0x39,0xC8,0x6C,0xEF,0x58,0x36,0x0F,0x8F,0x03,
-	0xE4,0xB6,0x9D,0x77,0xE0,0x86,0x37,0xE3,0xF0,0x6A,0x28,0xD8,0xE6,0x9D,0xF9,0xD7,
-	0x5D,0x7E,0xE7,0xAC,0x37,0x1F,0x15,0x4C,0x67,0xCF,0x80,0x76,0x32,0x67,0x12,0xA5,
-	0x9D,0x6C,0x99,0xC2,0x89,0x6F,0xDC,0x2D,0xC3,0x9B,0x89,0x74,0xF9,0x01,0xD6,0x35,
-	0x19,0xEC,0x12,0xF8,0x5D,0x72,0xF3,0x41,0xBF,0xDF,0x0B,0xB0,0x4C,0xBB,0xBA,0x2E,
-	0x83,0x39,0xD7,0x30,0x8C,0x44,0x9A,0x3A,0x05,0x58,0x2B,0x78,0xD5,0x8D,0xBA,0x71,
-	0x86,0xC9,0xB2,0x63,0x99,0x43,0xB0,0xE9,0xB6,0xF6,0x9E,0xBB,0xCF,0x61,0x0C,0xAF,
-	0xFE,0x83,0x7B,0x1F,0x08,0x13,0x98,0x26,0xFE,0xF0,0x07,0x06,0x22,0x82,0x28,0x81,
-	0x05,0x00,0x00,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x95,0x54,0x4D,0x6F,0xDB,0x38,
+	0x10,0xBD,0xEF,0xAF,0x50,0x84,0x22,0x20,0x11,0x42,0x69,0x36,0xED,0xC5,0x02,0x13,
+	0xB4,0x80,0x0F,0xBB,0x40,0xEB,0x02,0x0E,0x90,0x43,0x10,0x20,0xB4,0x34,0x72,0xD8,
+	0xC8,0x43,0x83,0xA4,0x9C,0xB8,0xB2,0xFE,0x7B,0x47,0x94,0x64,0xCB,0x69,0x83,0xA2,
+	0x17,0x7D,0x0C,0x87,0x8F,0x6F,0xDE,0xBC,0xA1,0x5E,0xAD,0x8D,0xF5,0xF5,0x73,0x53,
+	0x58,0xB3,0x8A,0x93,0x73,0x8D,0x39,0xBC,0x5C,0x26,0xDF,0x5D,0x9C,0x66,0x06,0x9D,
+	0x8F,0xA6,0xF2,0x2E,0x36,0x6B,0xC0,0x58,0xC4,0x59,0x69,0x1C,0xD0,0x1B,0xAC,0x35,
+	0x96,0xDE,0x2B,0x70,0x4E,0x2D,0xDB,0x48,0x85,0x16,0xDC,0x9A,0xF2,0xF5,0x06,0xE2,
+	0xFB,0xB4,0xA8,0x30,0xF3,0xDA,0x60,0xF4,0xC2,0x78,0x5D,0x82,0x8F,0xAC,0x44,0x78,
+	0x8E,0xBE,0xA8,0xB5,0xD8,0x0C,0x5F,0x1D,0x7C,0xED,0xAA,0x85,0xCB,0xAC,0x5E,0xC0,
+	0x64,0x2E,0x1C,0xF8,0x89,0x6A,0xE4,0x33,0x3B,0xB9,0xE0,0xA2,0x94,0x1F,0xE1,0x32,
+	0x6D,0x37,0x67,0xA2,0x12,0x46,0xE4,0x07,0xD4,0x27,0x06,0xBC,0xCE,0x25,0x88,0x05,
+	0xE3,0xCD,0x3E,0x5A,0x30,0x10,0x9E,0xD7,0x1B,0x65,0x23,0x4C,0x4D,0x12,0xC8,0x32,
+	0x2E,0x54,0x40,0xCB,0x4A,0x50,0xF6,0x46,0xAF,0xC0,0x54,0x9E,0x65,0xAF,0xFE,0x2B,
+	0x2E,0x18,0x4A,0x9B,0x2C,0xC1,0x13,0x32,0x97,0x12,0xAB,0xB2,0xDC,0xED,0x30,0x29,
+	0x8C,0x9D,0xAA,0xEC,0x91,0x39,0x79,0xE5,0x98,0xE7,0x5C,0x54,0x92,0x38,0x0E,0xDB,
+	0x16,0xA2,0x1C,0x1D,0x4F,0x5C,0x6A,0x13,0x8A,0xBB,0x85,0xC5,0xDC,0x64,0x4F,0x04,
+	0x96,0x73,0x61,0x12,0x83,0xAD,0x7C,0x12,0xE4,0x55,0xE0,0xE6,0x53,0x62,0xF4,0xFE,
+	0x37,0x0C,0x7C,0xCF,0xA0,0x53,0xFB,0x40,0xC3,0xEF,0x69,0xA0,0xBC,0xC2,0x96,0x60,
+	0x4A,0x01,0xD6,0x75,0x07,0x23,0x53,0x44,0x36,0x79,0x82,0xAD,0x63,0x9C,0x4F,0x13,
+	0x8D,0x59,0x59,0xE5,0xE0,0x18,0xF2,0xDD,0x6E,0x49,0xCF,0x26,0x30,0xE8,0x3B,0xB5,
+	0x27,0xB1,0x16,0x37,0xE9,0x96,0xF1,0x20,0xAF,0x97,0x90,0xE4,0xCA,0xAB,0x54,0x17,
+	0xCC,0x47,0x9A,0x50,0x15,0x66,0x40,0xB0,0x9F,0xAC,0x55,0xDB,0xCF,0x55,0x51,0x80,
+	0xE5,0x35,0x5B,0x0F,0xF4,0x16,0x1A,0x95,0xDD,0x8E,0x08,0xAE,0xF7,0x04,0xB5,0xBC,
+	0xD2,0xAD,0x4E,0xA9,0x05,0x5F,0x59,0x6C,0x5A,0x44,0x29,0x65,0x7C,0x19,0x93,0x36,
+	0x89,0x03,0xCC,0x59,0xFC,0x21,0x3E,0x5E,0xF6,0x49,0x6B,0x01,0x6F,0x35,0x2E,0x19,
+	0x35,0xEA,0xC4,0xF3,0x6E,0x35,0x70,0xC3,0xA3,0x65,0x9F,0x04,0x77,0xCE,0x0A,0x16,
+	0x9F,0xC7,0xFC,0xEC,0x42,0x8C,0x02,0x77,0x44,0x48,0xB8,0xB7,0xD2,0xEF,0xFA,0xF4,
+	0x52,0x39,0xFF,0xDF,0x10,0xBC,0xA7,0x2D,0xA9,0xB7,0xDB,0xDA,0xC9,0xFF,0xE7,0xB3,
+	0xAF,0xC9,0x5A,0x59,0x72,0x8C,0xE3,0x4D,0xA6,0x7C,0xF6,0x58,0x37,0x78,0x7A,0xCA,
+	0xD8,0x4D,0x5F,0x36,0x1E,0xEA,0xBD,0x39,0xAE,0xD7,0x71,0xDE,0xAB,0x1C,0xE6,0xA2,
+	0xD5,0x98,0xC0,0xFB,0x19,0x81,0xCE,0x01,0xC1,0x8C,0xFD,0x4A,0x3F,0x45,0x30,0xF2,
+	0xCE,0xAA,0xB3,0x6E,0x57,0xF1,0xE0,0xC3,0xB4,0x3D,0x1F,0x13,0xA7,0x7F,0xC0,0x6E,
+	0xF7,0x48,0x01,0xE1,0xAF,0xF1,0xE0,0xCD,0x1C,0x28,0x1D,0x48,0xED,0x09,0xB3,0xC3,
+	0x0F,0xE5,0x6C,0x0E,0xDF,0x7C,0x74,0x02,0x35,0xBB,0xFE,0x65,0x06,0xC6,0x66,0x66,
+	0x3C,0x90,0x3B,0x1A,0x64,0x7E,0x64,0xF0,0x59,0x47,0xF2,0xC4,0xEC,0x76,0x26,0xB1,
+	0xA0,0xF2,0xED,0xDC,0x2B,0x0F,0x27,0x52,0xEE,0x0D,0x9F,0xCC,0xBE,0x4D,0xBF,0xB6,
+	0xCB,0xA1,0xD5,0x0F,0xFF,0x9E,0xBF,0xAB,0xA1,0xB9,0x7B,0x57,0x07,0x79,0xBB,0xAE,
+	0xE8,0x62,0x4B,0x9C,0x9B,0xFB,0x87,0x11,0x72,0x5B,0xDC,0x5F,0xE0,0xC6,0x17,0xE7,
+	0xF1,0xD9,0x58,0xBE,0x65,0xBB,0x9F,0xCC,0xF4,0x47,0x88,0xC1,0x5A,0xDD,0xEC,0x78,
+	0xB9,0x19,0xA4,0x1E,0x90,0xDF,0xB7,0xC8,0x67,0xCC,0x5F,0x3F,0xBC,0xC1,0x7A,0x12,
+	0x93,0x69,0x9A,0x0E,0xE6,0xD5,0xDD,0x85,0xF9,0x74,0x03,0xE8,0x27,0x33,0xA1,0x51,
+	0xFB,0xC9,0x93,0x30,0x38,0x69,0x25,0x13,0x9A,0xA4,0x7D,0xDD,0xDB,0x0E,0x21,0xD2,
+	0xA7,0xA7,0x1B,0x3A,0x9A,0x42,0x94,0x25,0xF0,0x9A,0xFE,0xDB,0x62,0x26,0x6C,0x34,
+	0xC9,0x10,0x26,0x99,0x5A,0x8B,0xE1,0x76,0x99,0x83,0x17,0xB6,0xDF,0x43,0xA6,0x14,
+	0x98,0xA8,0x3C,0x27,0x72,0xA2,0xED,0x60,0xDD,0x39,0xA9,0x21,0x3F,0x16,0x45,0x38,
+	0x7D,0x1C,0x6C,0xBA,0xBA,0x6F,0x25,0x5D,0xCB,0x29,0xBC,0x84,0x8B,0xFF,0x36,0x52,
+	0x2E,0x72,0x4D,0xFA,0xCF,0x4F,0x50,0x21,0xB1,0x85,0x09,0x06,0x00,0x00,
 };
 
 // _app/immutable/chunks/Spinner.js
 const uint8_t ESP_SVELTEKIT_DATA_38[] = {
-	0x1F,0x8B,0x08,0x00,0xDF,0x71,0x1B,0x67,0x02,0xFF,0x95,0x55,0x51,0x6B,0xE3,0x38,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x95,0x55,0x51,0x6B,0xE3,0x38,
 	0x10,0x7E,0xBF,0x5F,0xE1,0x8A,0xC5,0x48,0xDC,0xC4,0xD7,0x2C,0x77,0x0B,0x97,0xE0,
 	0x83,0x6E,0xDB,0x87,0x2E,0xA5,0x14,0x0A,0x7D,0x09,0x61,0x71,0x6C,0x39,0x51,0xAB,
 	0xC8,0xAE,0x25,0xB7,0x6E,0xBD,0xFE,0xEF,0x3B,0x63,0x35,0x75,0x12,0xEF,0x1D,0xDC,
@@ -10274,7 +10277,7 @@ const uint8_t ESP_SVELTEKIT_DATA_38[] = {
 
 // _app/immutable/chunks/stethoscope.js
 const uint8_t ESP_SVELTEKIT_DATA_39[] = {
-	0x1F,0x8B,0x08,0x00,0xDF,0x71,0x1B,0x67,0x02,0xFF,0x9D,0x53,0xD1,0x6E,0xDB,0x20,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x9D,0x53,0xD1,0x6E,0xDB,0x20,
 	0x14,0x7D,0xDF,0x57,0x50,0xAB,0x4A,0x41,0xBB,0x76,0x6D,0xB7,0xA9,0xD6,0xBA,0xF4,
 	0x61,0xD3,0xA4,0xBC,0xF4,0x29,0xD2,0x5E,0xA2,0xA8,0xA2,0x36,0xB1,0x69,0x31,0x64,
 	0x80,0x9D,0x48,0xC8,0xFF,0x3E,0x48,0xDA,0x2E,0xDD,0xE3,0x64,0xE3,0x03,0x97,0xC3,
@@ -10318,7 +10321,7 @@ const uint8_t ESP_SVELTEKIT_DATA_39[] = {
 
 // _app/immutable/chunks/stores.js
 const uint8_t ESP_SVELTEKIT_DATA_40[] = {
-	0x1F,0x8B,0x08,0x00,0xDF,0x71,0x1B,0x67,0x02,0xFF,0x5D,0x4F,0x4B,0x0E,0xC2,0x20,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x5D,0x4F,0x4B,0x0E,0xC2,0x20,
 	0x10,0xDD,0x7B,0x0A,0xD2,0x55,0x49,0x1A,0xDC,0x97,0xE0,0x5D,0xA0,0x1D,0x1B,0x8C,
 	0x05,0x32,0x43,0x4D,0x13,0x32,0x77,0x97,0x5A,0x63,0xD5,0xDD,0xFB,0xCD,0xBC,0x3C,
 	0x3F,0xA7,0x88,0xB9,0x8C,0xC2,0x92,0x00,0xBE,0x62,0x9C,0x1B,0x75,0x26,0x1F,0xA6,
@@ -10332,7 +10335,7 @@ const uint8_t ESP_SVELTEKIT_DATA_40[] = {
 
 // _app/immutable/chunks/topology-star-3.js
 const uint8_t ESP_SVELTEKIT_DATA_41[] = {
-	0x1F,0x8B,0x08,0x00,0xDF,0x71,0x1B,0x67,0x02,0xFF,0xED,0x55,0x51,0x4F,0xDB,0x30,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xED,0x55,0x51,0x4F,0xDB,0x30,
 	0x10,0x7E,0xDF,0xAF,0x30,0x11,0x2A,0xB6,0x76,0x09,0x49,0x9A,0x0D,0x4A,0x31,0x0F,
 	0xA0,0x49,0xF0,0xD0,0x27,0xF6,0x56,0x55,0x28,0x4A,0xDC,0xC6,0xE0,0x38,0x9D,0xE3,
 	0xB4,0x45,0x51,0xFE,0xFB,0xCE,0x29,0x65,0x05,0x69,0xA0,0x4D,0x9B,0xB4,0x87,0x29,
@@ -10380,7 +10383,7 @@ const uint8_t ESP_SVELTEKIT_DATA_41[] = {
 
 // _app/immutable/chunks/user.js
 const uint8_t ESP_SVELTEKIT_DATA_42[] = {
-	0x1F,0x8B,0x08,0x00,0xDF,0x71,0x1B,0x67,0x02,0xFF,0x9D,0x54,0x4B,0x6F,0xDC,0x36,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x9D,0x54,0x4B,0x6F,0xDC,0x36,
 	0x10,0xBE,0xF7,0x57,0xD0,0x4C,0x62,0x90,0x30,0x2B,0xAF,0x93,0x20,0x07,0x29,0x6C,
 	0x51,0x18,0x3D,0xB8,0x28,0x52,0xA0,0x6E,0x4E,0x45,0x10,0x53,0xD2,0xAC,0x96,0x89,
 	0x96,0x14,0x86,0x23,0x3F,0xA0,0xF0,0xBF,0x87,0x94,0x76,0xBD,0xDE,0x43,0x90,0x20,
@@ -10430,7 +10433,7 @@ const uint8_t ESP_SVELTEKIT_DATA_42[] = {
 
 // _app/immutable/chunks/users.js
 const uint8_t ESP_SVELTEKIT_DATA_43[] = {
-	0x1F,0x8B,0x08,0x00,0xDF,0x71,0x1B,0x67,0x02,0xFF,0x9D,0x53,0x4D,0x6F,0xE3,0x20,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x9D,0x53,0x4D,0x6F,0xE3,0x20,
 	0x10,0xBD,0xEF,0xAF,0xA0,0xA8,0x4A,0x41,0x3B,0x71,0x6D,0x37,0x55,0xAA,0xBA,0xF4,
 	0xD0,0xD5,0x4A,0xBD,0xE4,0xB4,0xEA,0x29,0x8A,0x2A,0xCB,0x9E,0xC4,0xB4,0x36,0x64,
 	0x01,0x3B,0x91,0x90,0xFF,0xFB,0x42,0xD2,0x8F,0xB4,0xC7,0x95,0x8C,0x1F,0xF3,0x66,
@@ -10472,7 +10475,7 @@ const uint8_t ESP_SVELTEKIT_DATA_43[] = {
 
 // _app/immutable/chunks/utils.js
 const uint8_t ESP_SVELTEKIT_DATA_44[] = {
-	0x1F,0x8B,0x08,0x00,0xDF,0x71,0x1B,0x67,0x02,0xFF,0x85,0x54,0x4B,0x73,0xA3,0x38,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x85,0x54,0x4B,0x73,0xA3,0x38,
 	0x10,0xBE,0xEF,0xAF,0xC0,0x54,0xCA,0x25,0x4D,0x14,0xC5,0xC9,0xDC,0xCC,0x28,0xD4,
 	0x3C,0x92,0x5B,0x2A,0x87,0x1C,0x19,0x6F,0x0A,0x63,0x61,0x48,0xB0,0x44,0x84,0x98,
 	0xD8,0x63,0xFB,0xBF,0x6F,0xB7,0x41,0x08,0x4F,0x6D,0xED,0x5E,0xF8,0x44,0x3F,0x3E,
@@ -10531,7 +10534,7 @@ const uint8_t ESP_SVELTEKIT_DATA_44[] = {
 
 // _app/immutable/entry/app.js
 const uint8_t ESP_SVELTEKIT_DATA_45[] = {
-	0x1F,0x8B,0x08,0x00,0xDF,0x71,0x1B,0x67,0x02,0xFF,0xED,0x5A,0x7B,0x73,0xDB,0x36,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xED,0x5A,0x7B,0x73,0xDB,0x36,
 	0x12,0xFF,0xFF,0x3E,0x85,0xC2,0xF1,0xA9,0xE4,0x0C,0x4C,0x8B,0xF2,0x23,0x8E,0x3C,
 	0xAC,0xA7,0x75,0xDC,0xD6,0x6D,0x9A,0xA6,0x71,0x93,0x3E,0x14,0x8D,0x0A,0x93,0xA0,
 	0x88,0x98,0x22,0x18,0x00,0x94,0xEC,0x2A,0xFC,0xEE,0xB7,0x0B,0x3E,0x2C,0xDB,0x94,
@@ -10719,7 +10722,7 @@ const uint8_t ESP_SVELTEKIT_DATA_45[] = {
 
 // _app/immutable/entry/start.js
 const uint8_t ESP_SVELTEKIT_DATA_46[] = {
-	0x1F,0x8B,0x08,0x00,0xDF,0x71,0x1B,0x67,0x02,0xFF,0x9D,0x5D,0x7B,0x73,0xDB,0x46,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x9D,0x5D,0x7B,0x73,0xDB,0x46,
 	0x92,0xFF,0xFF,0x3E,0x05,0x89,0xD3,0xB2,0x80,0x68,0x04,0x4B,0x4E,0x76,0xEB,0x0A,
 	0xF4,0x88,0x25,0x5B,0xB2,0x2D,0x47,0x91,0xB4,0x92,0xEC,0x5C,0x96,0x66,0x68,0x10,
 	0x18,0x92,0x90,0x40,0x80,0x01,0x40,0x52,0x0C,0x89,0xFB,0xEC,0xD7,0x3D,0x2F,0x0C,
@@ -11346,7 +11349,7 @@ const uint8_t ESP_SVELTEKIT_DATA_46[] = {
 
 // _app/immutable/nodes/0.js
 const uint8_t ESP_SVELTEKIT_DATA_47[] = {
-	0x1F,0x8B,0x08,0x00,0xDF,0x71,0x1B,0x67,0x02,0xFF,0xED,0x7D,0xF9,0x53,0xDB,0xC8,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xED,0x7D,0xF9,0x53,0xDB,0xC8,
 	0xD6,0xE8,0xEF,0xEF,0xAF,0x50,0x5C,0x29,0x7F,0xF2,0xA4,0xED,0x78,0x83,0x80,0x19,
 	0x0D,0x45,0x16,0x12,0x66,0x20,0xC9,0x84,0x40,0x66,0x2E,0x45,0x79,0x84,0xD4,0xB6,
 	0x04,0xDA,0xD2,0x6A,0x1B,0x1C,0xE0,0x7F,0x7F,0xE7,0x9C,0x6E,0xAD,0xB6,0xB3,0xDC,
@@ -12135,7 +12138,7 @@ const uint8_t ESP_SVELTEKIT_DATA_47[] = {
 
 // _app/immutable/nodes/1.js
 const uint8_t ESP_SVELTEKIT_DATA_48[] = {
-	0x1F,0x8B,0x08,0x00,0xDF,0x71,0x1B,0x67,0x02,0xFF,0x75,0x55,0x5D,0x6F,0xDB,0x38,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x75,0x55,0x5D,0x6F,0xDB,0x38,
 	0x10,0x7C,0xBF,0x5F,0xC1,0x08,0x81,0x40,0xA2,0x2B,0xC7,0x29,0x7A,0xE8,0x21,0x82,
 	0xEE,0xD0,0x26,0x6E,0x9B,0x7E,0x20,0x01,0x02,0xA4,0x0F,0x41,0x60,0xC8,0x12,0x25,
 	0xD1,0xA1,0x48,0x95,0xA4,0x64,0xA7,0x82,0xFF,0xFB,0x2D,0xA5,0x34,0xD6,0xF9,0x9A,
@@ -12196,7 +12199,7 @@ const uint8_t ESP_SVELTEKIT_DATA_48[] = {
 
 // _app/immutable/nodes/10.js
 const uint8_t ESP_SVELTEKIT_DATA_49[] = {
-	0x1F,0x8B,0x08,0x00,0xDF,0x71,0x1B,0x67,0x02,0xFF,0xED,0x5B,0xFD,0x77,0xD3,0x46,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xED,0x5B,0xFD,0x77,0xD3,0x46,
 	0xB3,0xFE,0xF9,0x7D,0xFF,0x0A,0xA1,0xC3,0x71,0xA5,0xC3,0x5A,0xB1,0x4D,0x42,0xA8,
 	0x8D,0xE0,0xE4,0x8B,0x40,0x0B,0x81,0x42,0x68,0xA1,0xB9,0x39,0x7E,0xD7,0xF2,0xCA,
 	0x5E,0xA2,0x2F,0xA4,0x55,0x12,0x63,0xFC,0xBF,0xDF,0x67,0x76,0x65,0x5B,0x8E,0x9D,
@@ -12510,7 +12513,7 @@ const uint8_t ESP_SVELTEKIT_DATA_49[] = {
 
 // _app/immutable/nodes/11.js
 const uint8_t ESP_SVELTEKIT_DATA_50[] = {
-	0x1F,0x8B,0x08,0x00,0xDF,0x71,0x1B,0x67,0x02,0xFF,0xED,0x3C,0x6D,0x73,0xDB,0x38,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xED,0x3C,0x6D,0x73,0xDB,0x38,
 	0xCE,0x9F,0x9F,0xFB,0x15,0xAA,0x26,0xE3,0x95,0x66,0x69,0xD5,0x76,0xDC,0x24,0xB5,
 	0xAB,0x76,0xF2,0xE2,0x36,0x69,0x93,0x36,0x4D,0xD2,0xA4,0xA9,0x1F,0x4F,0x4E,0xB6,
 	0x68,0x5B,0x89,0xDE,0x22,0xD1,0x6F,0xF1,0xFA,0xBF,0x1F,0x00,0x4A,0x96,0x64,0x3B,
@@ -12950,7 +12953,7 @@ const uint8_t ESP_SVELTEKIT_DATA_50[] = {
 
 // _app/immutable/nodes/12.js
 const uint8_t ESP_SVELTEKIT_DATA_51[] = {
-	0x1F,0x8B,0x08,0x00,0xDF,0x71,0x1B,0x67,0x02,0xFF,0x2D,0xCE,0xB1,0x0A,0x83,0x30,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x2D,0xCE,0xB1,0x0A,0x83,0x30,
 	0x10,0x00,0xD0,0xBD,0x5F,0x21,0x99,0x14,0x24,0xEE,0x8A,0xFD,0x83,0xD2,0x82,0xDD,
 	0x25,0xC6,0xD3,0xC6,0xC6,0x3B,0xB9,0x24,0x52,0x1B,0xF2,0xEF,0xA5,0xA5,0xE3,0xDB,
 	0x9E,0x59,0x37,0x62,0x1F,0xE7,0x4C,0xB9,0x0C,0xD2,0xC4,0xB4,0x0A,0x29,0x2B,0xFD,
@@ -12966,7 +12969,7 @@ const uint8_t ESP_SVELTEKIT_DATA_51[] = {
 
 // _app/immutable/nodes/13.js
 const uint8_t ESP_SVELTEKIT_DATA_52[] = {
-	0x1F,0x8B,0x08,0x00,0xDF,0x71,0x1B,0x67,0x02,0xFF,0xDD,0x7C,0x6B,0x73,0xDB,0xBA,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xDD,0x7C,0x6B,0x73,0xDB,0xBA,
 	0xAE,0xE8,0xF7,0xFB,0x2B,0xB4,0x34,0x99,0x6C,0x69,0x36,0xED,0xC6,0x49,0x5F,0xCB,
 	0xAE,0xDA,0xC9,0xFB,0x9D,0xB8,0x79,0xB6,0xCD,0xCE,0x64,0x64,0x89,0xB6,0x95,0xC8,
 	0x92,0x22,0x51,0x7E,0xC4,0xF5,0x7F,0x3F,0x00,0x28,0xD9,0x94,0x1F,0x8D,0xBB,0x4E,
@@ -13464,7 +13467,7 @@ const uint8_t ESP_SVELTEKIT_DATA_52[] = {
 
 // _app/immutable/nodes/14.js
 const uint8_t ESP_SVELTEKIT_DATA_53[] = {
-	0x1F,0x8B,0x08,0x00,0xE0,0x71,0x1B,0x67,0x02,0xFF,0xED,0x7D,0x6B,0x77,0xDB,0xB8,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xED,0x7D,0x6B,0x77,0xDB,0xB8,
 	0xAE,0xE8,0xE7,0x7B,0x7E,0x85,0xAB,0x95,0x9B,0x23,0x9F,0xD2,0xAE,0xED,0x24,0x9D,
 	0xD6,0x1E,0x35,0x2B,0x49,0xF3,0x6C,0x5E,0xCD,0xBB,0xC9,0xF1,0xCA,0xC8,0x32,0x9D,
 	0x28,0x96,0x65,0x57,0x92,0x5F,0x49,0xFC,0xDF,0x2F,0x00,0x52,0x12,0x25,0xCB,0x89,
@@ -14690,7 +14693,7 @@ const uint8_t ESP_SVELTEKIT_DATA_53[] = {
 
 // _app/immutable/nodes/2.js
 const uint8_t ESP_SVELTEKIT_DATA_54[] = {
-	0x1F,0x8B,0x08,0x00,0xE0,0x71,0x1B,0x67,0x02,0xFF,0x5D,0x53,0x5D,0x6B,0xDB,0x30,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x5D,0x53,0x5D,0x6B,0xDB,0x30,
 	0x14,0x7D,0x5E,0x7F,0x85,0x2A,0x46,0xB0,0x41,0x4E,0xD2,0x50,0xCA,0x68,0xE3,0x3C,
 	0x6D,0xD0,0x41,0x07,0x83,0x8E,0xED,0xB5,0x8A,0x74,0x6D,0x69,0x95,0x25,0xA3,0x8F,
 	0x34,0xC1,0xF8,0xBF,0xEF,0xCA,0x69,0x46,0x1A,0x83,0x74,0xC4,0xD5,0xB9,0xE7,0x1E,
@@ -14729,7 +14732,7 @@ const uint8_t ESP_SVELTEKIT_DATA_54[] = {
 
 // _app/immutable/nodes/3.js
 const uint8_t ESP_SVELTEKIT_DATA_55[] = {
-	0x1F,0x8B,0x08,0x00,0xE0,0x71,0x1B,0x67,0x02,0xFF,0x2D,0xCE,0xB1,0x0A,0x83,0x30,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x2D,0xCE,0xB1,0x0A,0x83,0x30,
 	0x10,0x00,0xD0,0xBD,0x5F,0x21,0x99,0x14,0x24,0xEE,0x8A,0xFD,0x83,0xD2,0x82,0xDD,
 	0x25,0xC6,0xD3,0xC6,0xC6,0x3B,0xB9,0x24,0x52,0x1B,0xF2,0xEF,0xA5,0xA5,0xE3,0xDB,
 	0x9E,0x59,0x37,0x62,0x1F,0xE7,0x4C,0xB9,0x0C,0xD2,0xC4,0xB4,0x0A,0x29,0x2B,0xFD,
@@ -14745,7 +14748,7 @@ const uint8_t ESP_SVELTEKIT_DATA_55[] = {
 
 // _app/immutable/nodes/4.js
 const uint8_t ESP_SVELTEKIT_DATA_56[] = {
-	0x1F,0x8B,0x08,0x00,0xE0,0x71,0x1B,0x67,0x02,0xFF,0xED,0x5D,0xFD,0x5F,0xDB,0x38,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xED,0x5D,0xFD,0x5F,0xDB,0x38,
 	0x93,0xFF,0xF9,0xEE,0xAF,0x70,0x7D,0x1C,0x6B,0xDF,0xA3,0xA4,0x04,0x28,0xDB,0x92,
 	0x7A,0x39,0xDE,0xA1,0x05,0xCA,0x5B,0x69,0xB7,0x2C,0x1F,0xCE,0x71,0x94,0xD8,0x24,
 	0x7E,0xC1,0x56,0x48,0x20,0xE5,0xFE,0xF6,0x9B,0x19,0xC9,0xB1,0x9C,0x17,0x0A,0xFB,
@@ -15241,7 +15244,7 @@ const uint8_t ESP_SVELTEKIT_DATA_56[] = {
 
 // _app/immutable/nodes/5.js
 const uint8_t ESP_SVELTEKIT_DATA_57[] = {
-	0x1F,0x8B,0x08,0x00,0xE0,0x71,0x1B,0x67,0x02,0xFF,0xED,0x7D,0xFD,0x77,0xE2,0x38,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xED,0x7D,0xFD,0x77,0xE2,0x38,
 	0xB2,0xE8,0xEF,0xEF,0xAF,0x60,0xB8,0xBD,0x19,0xB8,0x23,0x08,0xE4,0xB3,0x93,0x0C,
 	0xD3,0x37,0x1F,0x74,0x3E,0xA1,0x99,0x40,0x27,0xDD,0x9D,0xC9,0xE1,0x08,0x5B,0xC1,
 	0x0A,0xC6,0x22,0xB2,0x0D,0x21,0x99,0xBC,0xBF,0xFD,0x55,0x49,0xB6,0xB1,0xB1,0x93,
@@ -15870,7 +15873,7 @@ const uint8_t ESP_SVELTEKIT_DATA_57[] = {
 
 // _app/immutable/nodes/6.js
 const uint8_t ESP_SVELTEKIT_DATA_58[] = {
-	0x1F,0x8B,0x08,0x00,0xE0,0x71,0x1B,0x67,0x02,0xFF,0xED,0x3C,0xDB,0x76,0xDB,0xB6,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xED,0x3C,0xDB,0x76,0xDB,0xB6,
 	0x96,0xCF,0x33,0x5F,0xA1,0x70,0x65,0x54,0xB2,0x81,0x64,0x49,0x76,0x9C,0x84,0x0E,
 	0x9D,0xE5,0xDA,0x49,0x9D,0x53,0x3B,0x49,0x63,0x25,0x69,0xAB,0xD1,0x52,0x60,0x12,
 	0x14,0x11,0x53,0x24,0x43,0x40,0xB2,0x1D,0x45,0xAF,0xF3,0x38,0xAF,0xF3,0x2B,0xF3,
@@ -16271,7 +16274,7 @@ const uint8_t ESP_SVELTEKIT_DATA_58[] = {
 
 // _app/immutable/nodes/7.js
 const uint8_t ESP_SVELTEKIT_DATA_59[] = {
-	0x1F,0x8B,0x08,0x00,0xE0,0x71,0x1B,0x67,0x02,0xFF,0x2D,0xCE,0xB1,0x0A,0x83,0x30,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x2D,0xCE,0xB1,0x0A,0x83,0x30,
 	0x10,0x00,0xD0,0xBD,0x5F,0x21,0x99,0x14,0x24,0xEE,0x8A,0xFD,0x83,0xD2,0x82,0xDD,
 	0x25,0xC6,0xD3,0xC6,0xC6,0x3B,0xB9,0x24,0x52,0x1B,0xF2,0xEF,0xA5,0xA5,0xE3,0xDB,
 	0x9E,0x59,0x37,0x62,0x1F,0xE7,0x4C,0xB9,0x0C,0xD2,0xC4,0xB4,0x0A,0x29,0x2B,0xFD,
@@ -16287,7 +16290,7 @@ const uint8_t ESP_SVELTEKIT_DATA_59[] = {
 
 // _app/immutable/nodes/8.js
 const uint8_t ESP_SVELTEKIT_DATA_60[] = {
-	0x1F,0x8B,0x08,0x00,0xE0,0x71,0x1B,0x67,0x02,0xFF,0xED,0x58,0xEB,0x72,0xDB,0xB6,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xED,0x58,0xEB,0x72,0xDB,0xB6,
 	0x12,0xFE,0x7F,0x9E,0x82,0xE1,0x78,0x3C,0xE4,0x0C,0xA4,0x48,0x4E,0x9D,0x69,0xA9,
 	0x61,0xCF,0xB8,0x4A,0xD2,0xA4,0xAD,0x93,0x34,0xCE,0xA5,0xAD,0xC6,0xA3,0x81,0x48,
 	0x50,0x64,0x4C,0x11,0x0C,0x01,0xEA,0x12,0x86,0xEF,0x74,0x9E,0xE1,0x3C,0xD9,0xF9,
@@ -16429,7 +16432,7 @@ const uint8_t ESP_SVELTEKIT_DATA_60[] = {
 
 // _app/immutable/nodes/9.js
 const uint8_t ESP_SVELTEKIT_DATA_61[] = {
-	0x1F,0x8B,0x08,0x00,0xE0,0x71,0x1B,0x67,0x02,0xFF,0xED,0x7D,0x6B,0x77,0x22,0x39,
+	0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xED,0x7D,0x6B,0x77,0x22,0x39,
 	0x92,0xE8,0xE7,0xBB,0xBF,0x22,0x9B,0xC3,0xD4,0xC2,0xB6,0xA0,0x00,0x63,0x97,0xCB,
 	0x1E,0xBA,0x8F,0x1F,0xF8,0xFD,0xC6,0xEF,0xBA,0x75,0xBC,0x02,0x04,0xA4,0x9D,0x64,
 	0xE2,0x94,0x12,0x03,0x1E,0xFF,0xA7,0xFB,0x1B,0xEE,0x2F,0xDB,0x88,0x90,0x30,0x29,
@@ -16953,73 +16956,109 @@ const uint8_t ESP_SVELTEKIT_DATA_61[] = {
 	0x7B,0x4F,0xCB,0xFF,0xF1,0x3F,0xB4,0xA8,0x10,0xF4,0x63,0x7F,0x00,0x00,
 };
 
+// Footprint: gzip 266837 bytes
+
+struct WWWAsset {
+	const char *uri;
+	const char *contentType;
+	const uint8_t *content; // gzip
+	size_t len;
+	const char *etag; // quoted content hash of the uncompressed file, tagged with the encoding
+	const uint8_t *brotli; // nullptr unless built with EMBED_WWW_BROTLI
+	size_t brotliLen;
+	const char *brotliEtag;
+};
+
 typedef std::function<void(const String& uri, const String& contentType, const uint8_t * content, size_t len)> RouteRegistrationHandler;
 
 class WWWData {
 	public:
+		static constexpr size_t assetCount = 62;
+
+		static const WWWAsset *find(const char *uri, size_t len) {
+			if (!assetCount) return nullptr;
+			const WWWAsset &asset = assets[hash(seeds[hash(0, uri, len) % seedCount], uri, len) % assetCount];
+			return strlen(asset.uri) == len && !strncmp(asset.uri, uri, len) ? &asset : nullptr;
+		}
+
 		static void registerRoutes(RouteRegistrationHandler handler) {
-			handler("/favicon.png", "image/png", ESP_SVELTEKIT_DATA_0, 1594);
-			handler("/index.html", "text/html", ESP_SVELTEKIT_DATA_1, 452);
-			handler("/manifest.json", "application/json", ESP_SVELTEKIT_DATA_2, 177);
-			handler("/_app/version.json", "application/json", ESP_SVELTEKIT_DATA_3, 47);
-			handler("/_app/immutable/assets/0.css", "text/css", ESP_SVELTEKIT_DATA_4, 16453);
-			handler("/_app/immutable/assets/14.css", "text/css", ESP_SVELTEKIT_DATA_5, 331);
-			handler("/_app/immutable/assets/6.css", "text/css", ESP_SVELTEKIT_DATA_6, 1136);
-			handler("/_app/immutable/assets/logo.png", "image/png", ESP_SVELTEKIT_DATA_7, 19156);
-			handler("/_app/immutable/assets/_layout.css", "text/css", ESP_SVELTEKIT_DATA_8, 16440);
-			handler("/_app/immutable/assets/_page.css", "text/css", ESP_SVELTEKIT_DATA_9, 1136);
-			handler("/_app/immutable/assets/_page2.css", "text/css", ESP_SVELTEKIT_DATA_10, 331);
-			handler("/_app/immutable/chunks/24-hours.js", "application/javascript", ESP_SVELTEKIT_DATA_11, 631);
-			handler("/_app/immutable/chunks/access-point.js", "application/javascript", ESP_SVELTEKIT_DATA_12, 605);
-			handler("/_app/immutable/chunks/alert-triangle.js", "application/javascript", ESP_SVELTEKIT_DATA_13, 621);
-			handler("/_app/immutable/chunks/await_block.js", "application/javascript", ESP_SVELTEKIT_DATA_14, 515);
-			handler("/_app/immutable/chunks/chart.js", "application/javascript", ESP_SVELTEKIT_DATA_15, 70053);
-			handler("/_app/immutable/chunks/clock-check.js", "application/javascript", ESP_SVELTEKIT_DATA_16, 593);
-			handler("/_app/immutable/chunks/Collapsible.js", "application/javascript", ESP_SVELTEKIT_DATA_17, 1491);
-			handler("/_app/immutable/chunks/compareVersions.js", "application/javascript", ESP_SVELTEKIT_DATA_18, 3279);
-			handler("/_app/immutable/chunks/ConfirmDialog.js", "application/javascript", ESP_SVELTEKIT_DATA_19, 5573);
-			handler("/_app/immutable/chunks/each.js", "application/javascript", ESP_SVELTEKIT_DATA_20, 532);
-			handler("/_app/immutable/chunks/home.js", "application/javascript", ESP_SVELTEKIT_DATA_21, 745);
-			handler("/_app/immutable/chunks/index.js", "application/javascript", ESP_SVELTEKIT_DATA_22, 2804);
-			handler("/_app/immutable/chunks/index2.js", "application/javascript", ESP_SVELTEKIT_DATA_23, 759);
-			handler("/_app/immutable/chunks/index3.js", "application/javascript", ESP_SVELTEKIT_DATA_24, 303);
-			handler("/_app/immutable/chunks/InfoDialog.js", "application/javascript", ESP_SVELTEKIT_DATA_25, 1627);
-			handler("/_app/immutable/chunks/InputPassword.js", "application/javascript", ESP_SVELTEKIT_DATA_26, 1430);
-			handler("/_app/immutable/chunks/logo.js", "application/javascript", ESP_SVELTEKIT_DATA_27, 96);
-			handler("/_app/immutable/chunks/navigation.js", "application/javascript", ESP_SVELTEKIT_DATA_28, 83);
-			handler("/_app/immutable/chunks/notifications.js", "application/javascript", ESP_SVELTEKIT_DATA_29, 374);
-			handler("/_app/immutable/chunks/pencil.js", "application/javascript", ESP_SVELTEKIT_DATA_30, 674);
-			handler("/_app/immutable/chunks/reload.js", "application/javascript", ESP_SVELTEKIT_DATA_31, 606);
-			handler("/_app/immutable/chunks/report-analytics.js", "application/javascript", ESP_SVELTEKIT_DATA_32, 856);
-			handler("/_app/immutable/chunks/RSSIIndicator.js", "application/javascript", ESP_SVELTEKIT_DATA_33, 1878);
-			handler("/_app/immutable/chunks/scheduler.js", "application/javascript", ESP_SVELTEKIT_DATA_34, 3016);
-			handler("/_app/immutable/chunks/SettingsCard.js", "application/javascript", ESP_SVELTEKIT_DATA_35, 2210);
-			handler("/_app/immutable/chunks/singletons.js", "application/javascript", ESP_SVELTEKIT_DATA_36, 1289);
-			handler("/_app/immutable/chunks/socket.js", "application/javascript", ESP_SVELTEKIT_DATA_37, 707);
-			handler("/_app/immutable/chunks/Spinner.js", "application/javascript", ESP_SVELTEKIT_DATA_38, 935);
-			handler("/_app/immutable/chunks/stethoscope.js", "application/javascript", ESP_SVELTEKIT_DATA_39, 625);
-			handler("/_app/immutable/chunks/stores.js", "application/javascript", ESP_SVELTEKIT_DATA_40, 156);
-			handler("/_app/immutable/chunks/topology-star-3.js", "application/javascript", ESP_SVELTEKIT_DATA_41, 702);
-			handler("/_app/immutable/chunks/user.js", "application/javascript", ESP_SVELTEKIT_DATA_42, 725);
-			handler("/_app/immutable/chunks/users.js", "application/javascript", ESP_SVELTEKIT_DATA_43, 598);
-			handler("/_app/immutable/chunks/utils.js", "application/javascript", ESP_SVELTEKIT_DATA_44, 877);
-			handler("/_app/immutable/entry/app.js", "application/javascript", ESP_SVELTEKIT_DATA_45, 2934);
-			handler("/_app/immutable/entry/start.js", "application/javascript", ESP_SVELTEKIT_DATA_46, 9956);
-			handler("/_app/immutable/nodes/0.js", "application/javascript", ESP_SVELTEKIT_DATA_47, 12551);
-			handler("/_app/immutable/nodes/1.js", "application/javascript", ESP_SVELTEKIT_DATA_48, 905);
-			handler("/_app/immutable/nodes/10.js", "application/javascript", ESP_SVELTEKIT_DATA_49, 4955);
-			handler("/_app/immutable/nodes/11.js", "application/javascript", ESP_SVELTEKIT_DATA_50, 6973);
-			handler("/_app/immutable/nodes/12.js", "application/javascript", ESP_SVELTEKIT_DATA_51, 178);
-			handler("/_app/immutable/nodes/13.js", "application/javascript", ESP_SVELTEKIT_DATA_52, 7902);
-			handler("/_app/immutable/nodes/14.js", "application/javascript", ESP_SVELTEKIT_DATA_53, 19547);
-			handler("/_app/immutable/nodes/2.js", "application/javascript", ESP_SVELTEKIT_DATA_54, 547);
-			handler("/_app/immutable/nodes/3.js", "application/javascript", ESP_SVELTEKIT_DATA_55, 178);
-			handler("/_app/immutable/nodes/4.js", "application/javascript", ESP_SVELTEKIT_DATA_56, 7862);
-			handler("/_app/immutable/nodes/5.js", "application/javascript", ESP_SVELTEKIT_DATA_57, 9999);
-			handler("/_app/immutable/nodes/6.js", "application/javascript", ESP_SVELTEKIT_DATA_58, 6339);
-			handler("/_app/immutable/nodes/7.js", "application/javascript", ESP_SVELTEKIT_DATA_59, 178);
-			handler("/_app/immutable/nodes/8.js", "application/javascript", ESP_SVELTEKIT_DATA_60, 2203);
-			handler("/_app/immutable/nodes/9.js", "application/javascript", ESP_SVELTEKIT_DATA_61, 8350);
+			for (const WWWAsset &asset : assets) {
+				handler(asset.uri, asset.contentType, asset.content, asset.len);
+			}
+		}
+
+	private:
+		static constexpr size_t seedCount = 31;
+		static constexpr uint32_t seeds[seedCount] = {5, 3, 1, 1, 1, 23, 0, 3, 0, 7, 7, 11, 1, 7, 18, 1, 3, 14, 8, 13, 2, 1, 9, 16, 14, 14, 20, 7, 5, 2, 19};
+		static constexpr WWWAsset assets[assetCount] = {
+			{"/_app/immutable/nodes/2.js", "application/javascript", ESP_SVELTEKIT_DATA_54, 547, "\"9b30a707e57bac5a-gz\"", nullptr, 0, nullptr},
+			{"/_app/immutable/chunks/InputPassword.js", "application/javascript", ESP_SVELTEKIT_DATA_26, 1430, "\"ceef7045c9bcefe8-gz\"", nullptr, 0, nullptr},
+			{"/_app/immutable/chunks/Spinner.js", "application/javascript", ESP_SVELTEKIT_DATA_38, 935, "\"1485b70b4fc87e5f-gz\"", nullptr, 0, nullptr},
+			{"/_app/immutable/chunks/reload.js", "application/javascript", ESP_SVELTEKIT_DATA_31, 606, "\"26e8ccefa99274ab-gz\"", nullptr, 0, nullptr},
+			{"/_app/immutable/assets/_page.css", "text/css", ESP_SVELTEKIT_DATA_9, 1136, "\"1311fb9e27f2d964-gz\"", nullptr, 0, nullptr},
+			{"/_app/immutable/chunks/clock-check.js", "application/javascript", ESP_SVELTEKIT_DATA_16, 593, "\"b86da7c0d526d5c0-gz\"", nullptr, 0, nullptr},
+			{"/_app/immutable/nodes/13.js", "application/javascript", ESP_SVELTEKIT_DATA_52, 7902, "\"1a659ada896d555f-gz\"", nullptr, 0, nullptr},
+			{"/_app/immutable/chunks/await_block.js", "application/javascript", ESP_SVELTEKIT_DATA_14, 515, "\"3d7da53a1c399867-gz\"", nullptr, 0, nullptr},
+			{"/_app/immutable/chunks/ConfirmDialog.js", "application/javascript", ESP_SVELTEKIT_DATA_19, 5573, "\"57026376ffb194b5-gz\"", nullptr, 0, nullptr},
+			{"/_app/immutable/nodes/5.js", "application/javascript", ESP_SVELTEKIT_DATA_57, 9999, "\"72cd8e9a0532b922-gz\"", nullptr, 0, nullptr},
+			{"/_app/immutable/chunks/users.js", "application/javascript", ESP_SVELTEKIT_DATA_43, 598, "\"09f505d15ed69ee8-gz\"", nullptr, 0, nullptr},
+			{"/_app/immutable/chunks/index2.js", "application/javascript", ESP_SVELTEKIT_DATA_23, 759, "\"9d0252a3fabb5e87-gz\"", nullptr, 0, nullptr},
+			{"/_app/immutable/nodes/12.js", "application/javascript", ESP_SVELTEKIT_DATA_51, 178, "\"2674e5980084852b-gz\"", nullptr, 0, nullptr},
+			{"/_app/immutable/chunks/chart.js", "application/javascript", ESP_SVELTEKIT_DATA_15, 70053, "\"845b1e00d2903059-gz\"", nullptr, 0, nullptr},
+			{"/_app/immutable/chunks/home.js", "application/javascript", ESP_SVELTEKIT_DATA_21, 745, "\"0b5d002d3775704a-gz\"", nullptr, 0, nullptr},
+			{"/_app/immutable/chunks/Collapsible.js", "application/javascript", ESP_SVELTEKIT_DATA_17, 1491, "\"dce49dd2188142b9-gz\"", nullptr, 0, nullptr},
+			{"/_app/immutable/chunks/report-analytics.js", "application/javascript", ESP_SVELTEKIT_DATA_32, 856, "\"c1feffeed7630027-gz\"", nullptr, 0, nullptr},
+			{"/_app/immutable/nodes/1.js", "application/javascript", ESP_SVELTEKIT_DATA_48, 905, "\"2d0bca2766daed79-gz\"", nullptr, 0, nullptr},
+			{"/_app/immutable/nodes/9.js", "application/javascript", ESP_SVELTEKIT_DATA_61, 8350, "\"28f4dabc7a5b8fb2-gz\"", nullptr, 0, nullptr},
+			{"/_app/immutable/chunks/compareVersions.js", "application/javascript", ESP_SVELTEKIT_DATA_18, 3279, "\"925300a8a2fa0238-gz\"", nullptr, 0, nullptr},
+			{"/_app/immutable/chunks/scheduler.js", "application/javascript", ESP_SVELTEKIT_DATA_34, 3016, "\"e82efbbc5476686e-gz\"", nullptr, 0, nullptr},
+			{"/_app/immutable/nodes/7.js", "application/javascript", ESP_SVELTEKIT_DATA_59, 178, "\"2674e5980084852b-gz\"", nullptr, 0, nullptr},
+			{"/_app/immutable/nodes/6.js", "application/javascript", ESP_SVELTEKIT_DATA_58, 6339, "\"5bbb93c40ea196e1-gz\"", nullptr, 0, nullptr},
+			{"/_app/immutable/nodes/14.js", "application/javascript", ESP_SVELTEKIT_DATA_53, 19547, "\"ce0f220717311f03-gz\"", nullptr, 0, nullptr},
+			{"/_app/version.json", "application/json", ESP_SVELTEKIT_DATA_3, 47, "\"598ca52805150c2c-gz\"", nullptr, 0, nullptr},
+			{"/_app/immutable/chunks/InfoDialog.js", "application/javascript", ESP_SVELTEKIT_DATA_25, 1627, "\"c71bf9ee67680886-gz\"", nullptr, 0, nullptr},
+			{"/_app/immutable/nodes/3.js", "application/javascript", ESP_SVELTEKIT_DATA_55, 178, "\"2674e5980084852b-gz\"", nullptr, 0, nullptr},
+			{"/_app/immutable/entry/app.js", "application/javascript", ESP_SVELTEKIT_DATA_45, 2934, "\"cfd4767896171182-gz\"", nullptr, 0, nullptr},
+			{"/manifest.json", "application/json", ESP_SVELTEKIT_DATA_2, 177, "\"fdb0d9f50a3f80d4-gz\"", nullptr, 0, nullptr},
+			{"/favicon.png", "image/png", ESP_SVELTEKIT_DATA_0, 1594, "\"5146ed79b486cb9e-gz\"", nullptr, 0, nullptr},
+			{"/_app/immutable/chunks/index3.js", "application/javascript", ESP_SVELTEKIT_DATA_24, 303, "\"edd480c3afb3b1e6-gz\"", nullptr, 0, nullptr},
+			{"/_app/immutable/chunks/access-point.js", "application/javascript", ESP_SVELTEKIT_DATA_12, 605, "\"ec736bb1f21fefa4-gz\"", nullptr, 0, nullptr},
+			{"/_app/immutable/assets/6.css", "text/css", ESP_SVELTEKIT_DATA_6, 1136, "\"1311fb9e27f2d964-gz\"", nullptr, 0, nullptr},
+			{"/_app/immutable/entry/start.js", "application/javascript", ESP_SVELTEKIT_DATA_46, 9956, "\"5d9ea8ee4d457c13-gz\"", nullptr, 0, nullptr},
+			{"/_app/immutable/chunks/pencil.js", "application/javascript", ESP_SVELTEKIT_DATA_30, 674, "\"e36b6cc4ab1891b9-gz\"", nullptr, 0, nullptr},
+			{"/_app/immutable/chunks/topology-star-3.js", "application/javascript", ESP_SVELTEKIT_DATA_41, 702, "\"1cbc7295540a0ff2-gz\"", nullptr, 0, nullptr},
+			{"/_app/immutable/chunks/SettingsCard.js", "application/javascript", ESP_SVELTEKIT_DATA_35, 2210, "\"8d6fe25323df12dc-gz\"", nullptr, 0, nullptr},
+			{"/_app/immutable/chunks/RSSIIndicator.js", "application/javascript", ESP_SVELTEKIT_DATA_33, 1878, "\"e38be0c00f0b44e8-gz\"", nullptr, 0, nullptr},
+			{"/_app/immutable/chunks/stethoscope.js", "application/javascript", ESP_SVELTEKIT_DATA_39, 625, "\"dc94f945464e9de0-gz\"", nullptr, 0, nullptr},
+			{"/_app/immutable/chunks/index.js", "application/javascript", ESP_SVELTEKIT_DATA_22, 2804, "\"0c7605db79a81b11-gz\"", nullptr, 0, nullptr},
+			{"/index.html", "text/html", ESP_SVELTEKIT_DATA_1, 452, "\"292c0b38898f77ec-gz\"", nullptr, 0, nullptr},
+			{"/_app/immutable/assets/_page2.css", "text/css", ESP_SVELTEKIT_DATA_10, 331, "\"57b9d29830b0826a-gz\"", nullptr, 0, nullptr},
+			{"/_app/immutable/assets/14.css", "text/css", ESP_SVELTEKIT_DATA_5, 331, "\"57b9d29830b0826a-gz\"", nullptr, 0, nullptr},
+			{"/_app/immutable/nodes/4.js", "application/javascript", ESP_SVELTEKIT_DATA_56, 7862, "\"a8a33bf8e74ffa3e-gz\"", nullptr, 0, nullptr},
+			{"/_app/immutable/chunks/alert-triangle.js", "application/javascript", ESP_SVELTEKIT_DATA_13, 621, "\"40949dd57eacf7a1-gz\"", nullptr, 0, nullptr},
+			{"/_app/immutable/assets/_layout.css", "text/css", ESP_SVELTEKIT_DATA_8, 16440, "\"0b831b7fa3e6a49e-gz\"", nullptr, 0, nullptr},
+			{"/_app/immutable/nodes/11.js", "application/javascript", ESP_SVELTEKIT_DATA_50, 6973, "\"57e1bec75a405f96-gz\"", nullptr, 0, nullptr},
+			{"/_app/immutable/chunks/24-hours.js", "application/javascript", ESP_SVELTEKIT_DATA_11, 631, "\"ea0d5fc6ddc1fdac-gz\"", nullptr, 0, nullptr},
+			{"/_app/immutable/chunks/each.js", "application/javascript", ESP_SVELTEKIT_DATA_20, 532, "\"83b009b3a78b1d35-gz\"", nullptr, 0, nullptr},
+			{"/_app/immutable/chunks/stores.js", "application/javascript", ESP_SVELTEKIT_DATA_40, 156, "\"953e0a707cf0c519-gz\"", nullptr, 0, nullptr},
+			{"/_app/immutable/nodes/10.js", "application/javascript", ESP_SVELTEKIT_DATA_49, 4955, "\"28b2b7dee5407926-gz\"", nullptr, 0, nullptr},
+			{"/_app/immutable/chunks/navigation.js", "application/javascript", ESP_SVELTEKIT_DATA_28, 83, "\"7daa7c0173c17cb4-gz\"", nullptr, 0, nullptr},
+			{"/_app/immutable/assets/logo.png", "image/png", ESP_SVELTEKIT_DATA_7, 19156, "\"b54480533cdeee50-gz\"", nullptr, 0, nullptr},
+			{"/_app/immutable/chunks/user.js", "application/javascript", ESP_SVELTEKIT_DATA_42, 725, "\"4730eacdb43036a3-gz\"", nullptr, 0, nullptr},
+			{"/_app/immutable/chunks/socket.js", "application/javascript", ESP_SVELTEKIT_DATA_37, 766, "\"3d154030ec053149-gz\"", nullptr, 0, nullptr},
+			{"/_app/immutable/chunks/notifications.js", "application/javascript", ESP_SVELTEKIT_DATA_29, 374, "\"7eb671dc987ced8f-gz\"", nullptr, 0, nullptr},
+			{"/_app/immutable/assets/0.css", "text/css", ESP_SVELTEKIT_DATA_4, 16453, "\"b8a7fbaec953a42a-gz\"", nullptr, 0, nullptr},
+			{"/_app/immutable/nodes/8.js", "application/javascript", ESP_SVELTEKIT_DATA_60, 2203, "\"c1bc3676d53decc0-gz\"", nullptr, 0, nullptr},
+			{"/_app/immutable/nodes/0.js", "application/javascript", ESP_SVELTEKIT_DATA_47, 12551, "\"734af2b7e9d26fe6-gz\"", nullptr, 0, nullptr},
+			{"/_app/immutable/chunks/utils.js", "application/javascript", ESP_SVELTEKIT_DATA_44, 877, "\"9577ce947b979e78-gz\"", nullptr, 0, nullptr},
+			{"/_app/immutable/chunks/logo.js", "application/javascript", ESP_SVELTEKIT_DATA_27, 96, "\"fb5535caa915726c-gz\"", nullptr, 0, nullptr},
+			{"/_app/immutable/chunks/singletons.js", "application/javascript", ESP_SVELTEKIT_DATA_36, 1289, "\"f0c9485a487bf489-gz\"", nullptr, 0, nullptr},
+		};
+
+		static constexpr uint32_t hash(uint32_t seed, const char *text, size_t len) {
+			uint32_t h = 2166136261u ^ seed;
+			for (size_t i = 0; i < len; i++) h = (h ^ (uint8_t)text[i]) * 16777619u;
+			return h;
 		}
 };
 
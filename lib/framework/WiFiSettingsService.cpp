@@ -6,7 +6,12 @@ WiFiSettingsService::WiFiSettingsService()
     : endpoint(WiFiSettings::read, WiFiSettings::update, this),
       _fsPersistence(WiFiSettings::read, WiFiSettings::update, this, WIFI_SETTINGS_FILE),
       _lastConnectionAttempt(0) {
-    addUpdateHandler([&](const String &originId) { reconfigureWiFiConnection(); }, false);
+    // the RSSI priority only matters for the next connection attempt
+    addUpdateHandler(
+        [&](origin_id_t originId, field_mask_t fields) {
+            if (fields & (WiFiSettings::FIELD_HOSTNAME | WiFiSettings::FIELD_NETWORKS)) reconfigureWiFiConnection();
+        },
+        false);
 }
 
 void WiFiSettingsService::initWiFi() {
@@ -22,6 +27,7 @@ void WiFiSettingsService::initWiFi() {
     WiFi.onEvent(std::bind(&WiFiSettingsService::onStationModeStop, this, std::placeholders::_1, std::placeholders::_2),
                  WiFiEvent_t::ARDUINO_EVENT_WIFI_STA_STOP);
     WiFi.onEvent(onStationModeGotIP, WiFiEvent_t::ARDUINO_EVENT_WIFI_STA_GOT_IP);
+    wifi_sta::begin();
 
     if (!_state.wifiSettings.empty()) {
         configureNetwork(_state.wifiSettings.front());
@@ -47,6 +53,11 @@ void WiFiSettingsService::loop() {
         manageSTA();
     }
 
+    if (_scanPending && wifi_sta::scanCount() != _scanCount) {
+        _scanPending = false;
+        if (!WiFi.isConnected()) connectToScannedNetwork();
+    }
+
     if (!_lastRssiUpdate || (unsigned long)(currentMillis - _lastRssiUpdate) >= RSSI_EVENT_DELAY) {
         _lastRssiUpdate = currentMillis;
         updateRSSI();
@@ -56,8 +67,8 @@ void WiFiSettingsService::loop() {
 String WiFiSettingsService::getHostname() { return _state.hostname; }
 
 void WiFiSettingsService::manageSTA() {
-    // Abort if already connected, or if we have no SSID
-    if (WiFi.isConnected() || _state.wifiSettings.empty()) {
+    // Abort if already connected, waiting for a scan, or if we have no SSID
+    if (WiFi.isConnected() || _scanPending || _state.wifiSettings.empty()) {
         return;
     }
 
@@ -69,77 +80,54 @@ void WiFiSettingsService::manageSTA() {
 }
 
 void WiFiSettingsService::connectToWiFi() {
-    // reset availability flag for all stored networks
-    for (auto &network : _state.wifiSettings) {
-        network.available = false;
+    // a recent scan, e.g. one started by the UI, is as good as a new one
+    if (wifi_sta::scanAge() < WIFI_SCAN_MAX_AGE) {
+        connectToScannedNetwork();
+        return;
     }
+    // loop() connects once the scan finished
+    _scanCount = wifi_sta::scanCount();
+    _scanPending = true;
+    wifi_sta::startScan();
+}
 
-    // scanning for available networks
-    int scanResult = WiFi.scanNetworks();
-    if (scanResult == WIFI_SCAN_FAILED) {
-        ESP_LOGE("WiFiSettingsService", "WiFi scan failed.");
-    } else if (scanResult == 0) {
-        ESP_LOGW("WiFiSettingsService", "No networks found.");
-    } else {
-        ESP_LOGI("WiFiSettingsService", "%d networks found.", scanResult);
-
-        // find the best network to connect
-        wifi_settings_t *bestNetwork = NULL;
-        int bestNetworkDb = FACTORY_WIFI_RSSI_THRESHOLD;
-
-        for (int i = 0; i < scanResult; ++i) {
-            String ssid_scan;
-            int32_t rssi_scan;
-            uint8_t sec_scan;
-            uint8_t *BSSID_scan;
-            int32_t chan_scan;
-
-            WiFi.getNetworkInfo(i, ssid_scan, sec_scan, rssi_scan, BSSID_scan, chan_scan);
-            ESP_LOGV("WiFiSettingsService", "SSID: %s, BSSID: " MACSTR ", RSSI: %d dbm, Channel: %d", ssid_scan.c_str(),
-                     MAC2STR(BSSID_scan), rssi_scan, chan_scan);
-
-            for (auto &network : _state.wifiSettings) {
-                if (ssid_scan == network.ssid) {     // SSID match
-                    if (rssi_scan > bestNetworkDb) { // best network
-                        bestNetworkDb = rssi_scan;
-                        ESP_LOGV("WiFiSettingsService", "--> New best network SSID: %s, BSSID: " MACSTR "",
-                                 ssid_scan.c_str(), MAC2STR(BSSID_scan));
-                        network.available = true;
-                        network.channel = chan_scan;
-                        memcpy(network.bssid, BSSID_scan, 6);
-                        bestNetwork = &network;
-                    } else if (rssi_scan >= FACTORY_WIFI_RSSI_THRESHOLD &&
-                               network.available == false) { // available network
-                        network.available = true;
-                        network.channel = chan_scan;
-                        memcpy(network.bssid, BSSID_scan, 6);
-                    }
-                }
-                break;
-            }
+void WiFiSettingsService::connectToScannedNetwork() {
+    // find the best network to connect
+    wifi_settings_t *bestNetwork = NULL;
+    int bestNetworkDb = FACTORY_WIFI_RSSI_THRESHOLD;
+
+    for (auto &network : _state.wifiSettings) {
+        wifi_sta::ScanResult result;
+        network.available =
+            wifi_sta::findNetwork(network.ssid.c_str(), result) && result.rssi >= FACTORY_WIFI_RSSI_THRESHOLD;
+        if (!network.available) continue;
+        network.channel = result.channel;
+        memcpy(network.bssid, result.bssid, 6);
+        if (result.rssi > bestNetworkDb) { // best network
+            bestNetworkDb = result.rssi;
+            ESP_LOGV("WiFiSettingsService", "--> New best network SSID: %s, BSSID: " MACSTR "", result.ssid,
+                     MAC2STR(result.bssid));
+            bestNetwork = &network;
         }
+    }
 
-        // if configured to prioritize signal strength, use the best network else
-        // use the first available network
-        if (_state.priorityBySignalStrength == false) {
-            for (auto &network : _state.wifiSettings) {
-                if (network.available == true) {
-                    ESP_LOGI("WiFiSettingsService", "Connecting to first available network: %s", network.ssid.c_str());
-                    configureNetwork(network);
-                    break;
-                }
+    // if configured to prioritize signal strength, use the best network else
+    // use the first available network
+    if (_state.priorityBySignalStrength == false) {
+        for (auto &network : _state.wifiSettings) {
+            if (network.available == true) {
+                ESP_LOGI("WiFiSettingsService", "Connecting to first available network: %s", network.ssid.c_str());
+                configureNetwork(network);
+                return;
             }
-        } else if (_state.priorityBySignalStrength == true && bestNetwork) {
-            ESP_LOGI("WiFiSettingsService", "Connecting to strongest known network: %s", bestNetwork->ssid.c_str());
-            configureNetwork(*bestNetwork);
-        } else // no suitable network to connect
-        {
-            ESP_LOGI("WiFiSettingsService", "No known networks found.");
         }
-
-        // delete scan results
-        WiFi.scanDelete();
+    } else if (bestNetwork) {
+        ESP_LOGI("WiFiSettingsService", "Connecting to strongest known network: %s", bestNetwork->ssid.c_str());
+        configureNetwork(*bestNetwork);
+        return;
     }
+    // no suitable network to connect
+    ESP_LOGI("WiFiSettingsService", "No known networks found.");
 }
 
 void WiFiSettingsService::configureNetwork(wifi_settings_t &network) {
@@ -184,16 +172,153 @@ void WiFiSettingsService::onStationModeGotIP(WiFiEvent_t event, WiFiEventInfo_t
 }
 
 namespace wifi_sta {
+static portMUX_TYPE scanMux = portMUX_INITIALIZER_UNLOCKED;
+static ScanResult scanResults[WIFI_SCAN_MAX_RESULTS];
+static size_t scanResultCount = 0;
+static bool hasScan = false;
+static uint32_t scannedAt = 0; // millis() the cached scan finished
+static bool scanRunning = false;
+static uint32_t scanStartedAt = 0;
+static uint32_t scansFinished = 0;
+
+// Under scanMux, gives up on a scan whose done event never came
+static void expireScan() {
+    if (scanRunning && millis() - scanStartedAt >= WIFI_SCAN_TIMEOUT) {
+        scanRunning = false;
+        scanResultCount = 0;
+        hasScan = false;
+        scansFinished++;
+    }
+}
+
+static void finishScan(const ScanResult *results, size_t count, bool succeeded) {
+    portENTER_CRITICAL(&scanMux);
+    if (count) memcpy(scanResults, results, count * sizeof(ScanResult));
+    scanResultCount = count;
+    hasScan = succeeded;
+    scannedAt = millis();
+    scanRunning = false;
+    scansFinished++;
+    portEXIT_CRITICAL(&scanMux);
+}
+
+// On the Arduino event task, after WiFiScanClass fetched the results
+static void onScanDone(WiFiEvent_t event, WiFiEventInfo_t info) {
+    // only written here, so it is filled without holding the lock
+    static ScanResult staged[WIFI_SCAN_MAX_RESULTS];
+    int found = WiFi.scanComplete();
+    size_t count = 0;
+    for (int i = 0; i < found; i++) {
+        String ssid;
+        uint8_t encryptionType;
+        int32_t rssi;
+        uint8_t *bssid;
+        int32_t channel;
+        WiFi.getNetworkInfo(i, ssid, encryptionType, rssi, bssid, channel);
+        ESP_LOGV(TAG, "SSID: %s, BSSID: " MACSTR ", RSSI: %d dbm, Channel: %d", ssid.c_str(), MAC2STR(bssid), rssi,
+                 channel);
+
+        // once full a network replaces the weakest one if it is stronger
+        size_t slot = count;
+        if (count == WIFI_SCAN_MAX_RESULTS) {
+            slot = 0;
+            for (size_t j = 1; j < count; j++) {
+                if (staged[j].rssi < staged[slot].rssi) slot = j;
+            }
+            if (staged[slot].rssi >= rssi) continue;
+        } else {
+            count++;
+        }
+        ScanResult &result = staged[slot];
+        strlcpy(result.ssid, ssid.c_str(), sizeof(result.ssid));
+        memcpy(result.bssid, bssid, 6);
+        result.rssi = rssi;
+        result.channel = channel;
+        result.encryptionType = encryptionType;
+    }
+    WiFi.scanDelete();
+
+    if (found < 0) {
+        ESP_LOGE(TAG, "WiFi scan failed.");
+    } else {
+        ESP_LOGI(TAG, "%d networks found.", found);
+    }
+    finishScan(staged, count, found >= 0);
+}
+
+void begin() { WiFi.onEvent(onScanDone, WiFiEvent_t::ARDUINO_EVENT_WIFI_SCAN_DONE); }
+
+void startScan() {
+    portENTER_CRITICAL(&scanMux);
+    expireScan();
+    bool start = !scanRunning;
+    if (start) {
+        scanRunning = true;
+        scanStartedAt = millis();
+    }
+    portEXIT_CRITICAL(&scanMux);
+    if (start && WiFi.scanNetworks(true) == WIFI_SCAN_FAILED) {
+        ESP_LOGE(TAG, "Failed to start a WiFi scan.");
+        finishScan(nullptr, 0, false);
+    }
+}
+
+bool scanning() {
+    portENTER_CRITICAL(&scanMux);
+    expireScan();
+    bool running = scanRunning;
+    portEXIT_CRITICAL(&scanMux);
+    return running;
+}
+
+uint32_t scanCount() {
+    portENTER_CRITICAL(&scanMux);
+    expireScan();
+    uint32_t count = scansFinished;
+    portEXIT_CRITICAL(&scanMux);
+    return count;
+}
+
+uint32_t scanAge() {
+    portENTER_CRITICAL(&scanMux);
+    expireScan();
+    uint32_t age = hasScan ? millis() - scannedAt : UINT32_MAX;
+    portEXIT_CRITICAL(&scanMux);
+    return age;
+}
+
+bool findNetwork(const char *ssid, ScanResult &result) {
+    bool found = false;
+    portENTER_CRITICAL(&scanMux);
+    for (size_t i = 0; i < scanResultCount; i++) {
+        if (strcmp(scanResults[i].ssid, ssid) || (found && scanResults[i].rssi <= result.rssi)) continue;
+        result = scanResults[i];
+        found = true;
+    }
+    portEXIT_CRITICAL(&scanMux);
+    return found;
+}
+
 void networks(JsonObject &root) {
     JsonArray networks = root["networks"].to<JsonArray>();
-    int numNetworks = WiFi.scanComplete();
-    for (int i = 0; i < numNetworks; i++) {
+    for (size_t i = 0;; i++) {
+        // one at a time, the json document may allocate which isn't allowed in a critical section
+        ScanResult result;
+        portENTER_CRITICAL(&scanMux);
+        bool cached = i < scanResultCount;
+        if (cached) result = scanResults[i];
+        portEXIT_CRITICAL(&scanMux);
+        if (!cached) break;
+
+        char bssid[18];
+        snprintf(bssid, sizeof(bssid), "%02X:%02X:%02X:%02X:%02X:%02X", result.bssid[0], result.bssid[1],
+                 result.bssid[2], result.bssid[3], result.bssid[4], result.bssid[5]);
         JsonObject network = networks.add<JsonObject>();
-        network["rssi"] = WiFi.RSSI(i);
-        network["ssid"] = WiFi.SSID(i);
-        network["bssid"] = WiFi.BSSIDstr(i);
-        network["channel"] = WiFi.channel(i);
-        network["encryption_type"] = (uint8_t)WiFi.encryptionType(i);
+        network["rssi"] = result.rssi;
+        network["ssid"] = result.ssid;
+        network["bssid"] = bssid;
+        network["channel"] = result.channel;
+        network["encryption_type"] = result.encryptionType;
     }
 }
 
@@ -221,18 +346,14 @@ void networkStatus(JsonObject &root) {
 }
 
 esp_err_t handleScan(PsychicRequest *request) {
-    if (WiFi.scanComplete() != -1) {
-        WiFi.scanDelete();
-        WiFi.scanNetworks(true);
-    }
+    startScan();
     return request->reply(202);
 }
 
 esp_err_t getNetworks(PsychicRequest *request) {
-    int numNetworks = WiFi.scanComplete();
-    if (numNetworks == -1)
+    if (scanning())
         return request->reply(202);
-    else if (numNetworks < -1)
+    else if (scanAge() == UINT32_MAX)
         return handleScan(request);
 
     PsychicJsonResponse response = PsychicJsonResponse(request, false);
@@ -241,11 +362,4 @@ esp_err_t getNetworks(PsychicRequest *request) {
     return response.send();
 }
 
-esp_err_t getNetworkStatus(PsychicRequest *request) {
-    PsychicJsonResponse response = PsychicJsonResponse(request, false);
-    JsonObject root = response.getRoot();
-    networkStatus(root);
-    return response.send();
-}
-
 } // namespace wifi_sta
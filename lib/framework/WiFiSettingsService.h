@@ -19,13 +19,56 @@
 
 #define EVENT_RSSI "rssi"
 
+// Networks kept of a scan, the strongest ones
+#ifndef WIFI_SCAN_MAX_RESULTS
+#define WIFI_SCAN_MAX_RESULTS 20
+#endif
+
+// Age up to which a reconnect uses the cached scan instead of scanning again
+#ifndef WIFI_SCAN_MAX_AGE
+#define WIFI_SCAN_MAX_AGE 1000 * 30
+#endif
+
+// A scan without a done event by then has failed
+#ifndef WIFI_SCAN_TIMEOUT
+#define WIFI_SCAN_TIMEOUT 1000 * 15
+#endif
+
+/*
+ * Scans run in the background and their results are cached when the scan done event
+ * arrives, so neither the HTTP handlers nor the reconnect logic wait for the radio.
+ * Both read the same cache, a scan started by the UI also serves the next reconnect.
+ */
 namespace wifi_sta {
+// Caches the results of every finished scan
+void begin();
+
+struct ScanResult {
+    char ssid[33];
+    uint8_t bssid[6];
+    int8_t rssi;
+    uint8_t channel;
+    uint8_t encryptionType;
+};
+
+// Starts a scan unless one is running
+void startScan();
+bool scanning();
+
+// Finished scans, failed ones included, changes once the cache was refreshed
+uint32_t scanCount();
+
+// ms since the cached scan finished, UINT32_MAX if there is none
+uint32_t scanAge();
+
+// The strongest cached network with this SSID
+bool findNetwork(const char *ssid, ScanResult &result);
+
 void networks(JsonObject &root);
 void networkStatus(JsonObject &root);
 
 esp_err_t handleScan(PsychicRequest *request);
 esp_err_t getNetworks(PsychicRequest *request);
-esp_err_t getNetworkStatus(PsychicRequest *request);
 } // namespace wifi_sta
 
 class WiFiSettingsService : public StatefulService<WiFiSettings> {
@@ -43,6 +86,8 @@ class WiFiSettingsService : public StatefulService<WiFiSettings> {
     FSPersistence<WiFiSettings> _fsPersistence;
     unsigned long _lastConnectionAttempt {0};
     unsigned long _lastRssiUpdate;
+    bool _scanPending {false};
+    uint32_t _scanCount {0}; // wifi_sta::scanCount() when the pending scan was requested
 
     bool _stopping {false};
     void onStationModeDisconnected(WiFiEvent_t event, WiFiEventInfo_t info);
@@ -52,6 +97,7 @@ class WiFiSettingsService : public StatefulService<WiFiSettings> {
     void reconfigureWiFiConnection();
     void manageSTA();
     void connectToWiFi();
+    void connectToScannedNetwork();
     void configureNetwork(wifi_settings_t &network);
     void updateRSSI();
 };
@@ -0,0 +1,79 @@
+#include <batch_service.h>
+
+#include <json_pool.h>
+#include <map>
+
+namespace batch_service {
+
+static const char *TAG = "BatchService";
+
+static std::map<String, StreamReader> readers;
+
+StreamReader add(const char *path, JsonReader reader) {
+    return add(path, [reader](JsonStreamWriter &json) {
+        JsonDocument doc(json_pool::allocator(json_pool::SITE_BATCH));
+        JsonObject root = doc.to<JsonObject>();
+        reader(root);
+        json.variant(doc);
+    });
+}
+
+StreamReader add(const char *path, StreamReader reader) {
+    readers[path] = reader;
+    return reader;
+}
+
+esp_err_t send(PsychicRequest *request, const StreamReader &writer) {
+    PsychicStreamResponse response = PsychicStreamResponse(request, "application/json");
+    esp_err_t err = response.beginSend();
+    if (err != ESP_OK) return err;
+    JsonStreamWriter json(response);
+    writer(json);
+    // without the last chunk the client sees the body broken off
+    if (json.aborted()) return ESP_FAIL;
+    return response.endSend();
+}
+
+esp_err_t handleBatch(PsychicRequest *request) {
+    if (!request->hasParam("paths")) return request->reply(400);
+    String paths = request->getParam("paths")->value();
+
+    // Refused before anything is sent, rather than answering only some of the paths
+    size_t count = 0;
+    for (unsigned int start = 0; start < paths.length(); count++) {
+        int end = paths.indexOf(',', start);
+        start = end < 0 ? paths.length() : end + 1;
+    }
+    if (count > BATCH_MAX_PATHS) {
+        ESP_LOGW(TAG, "Batch of %u paths, at most %d are allowed", count, BATCH_MAX_PATHS);
+        return request->reply(400);
+    }
+
+    PsychicStreamResponse response = PsychicStreamResponse(request, "application/json");
+    esp_err_t err = response.beginSend();
+    if (err != ESP_OK) return err;
+
+    // Unknown paths are answered with null, so one typo doesn't fail the whole batch
+    JsonStreamWriter json(response);
+    json.beginObject();
+    unsigned int start = 0;
+    while (start < paths.length()) {
+        int end = paths.indexOf(',', start);
+        if (end < 0) end = paths.length();
+        String path = paths.substring(start, end);
+        start = end + 1;
+
+        auto reader = readers.find(path);
+        if (reader == readers.end()) {
+            ESP_LOGW(TAG, "No batch reader for %s", path.c_str());
+            json.variant(path.c_str(), JsonVariantConst());
+            continue;
+        }
+        reader->second(json.name(path.c_str()));
+        if (json.aborted()) return ESP_FAIL;
+    }
+    json.endObject();
+    return response.endSend();
+}
+
+} // namespace batch_service
@@ -0,0 +1,29 @@
+#ifndef BatchService_h
+#define BatchService_h
+
+#include <ArduinoJson.h>
+#include <PsychicHttp.h>
+#include <functional>
+#include <json_stream.h>
+
+// Upper bound of paths in one batch request, more are answered with 400
+#define BATCH_MAX_PATHS 8
+
+namespace batch_service {
+
+typedef std::function<void(JsonObject &root)> JsonReader;
+typedef std::function<void(JsonStreamWriter &json)> StreamReader;
+
+// Makes the reader behind a GET route available to /api/v1/batch, returns the writer used for it
+StreamReader add(const char *path, JsonReader reader);
+StreamReader add(const char *path, StreamReader reader);
+
+// Answers a GET route with the writer add() returned, so the route and its batch entry can't differ
+esp_err_t send(PsychicRequest *request, const StreamReader &writer);
+
+// GET /api/v1/batch?paths=/api/v1/features,/api/v1/steps
+esp_err_t handleBatch(PsychicRequest *request);
+
+} // namespace batch_service
+
+#endif
@@ -0,0 +1,139 @@
+#include <connection_manager.h>
+
+#include <EventSocket.h>
+#include <histogram.h>
+#include <map>
+
+namespace connection_manager {
+
+static const char *TAG = "ConnectionManager";
+
+struct RouteStats {
+    uint32_t errors {0};       // callbacks which returned something else than ESP_OK
+    Log2Histogram<24> latency; // us per request
+};
+
+static SemaphoreHandle_t mutex = xSemaphoreCreateMutex();
+static PsychicHttpServer *server = nullptr;
+
+// millis() of the last request on every open socket
+static std::map<int, unsigned long> lastActive;
+static std::map<String, RouteStats> routes;
+static uint32_t opened = 0;
+static uint32_t purged = 0;
+
+static void touch(PsychicRequest *request) {
+    xSemaphoreTake(mutex, portMAX_DELAY);
+    lastActive[request->client()->socket()] = millis();
+    xSemaphoreGive(mutex);
+}
+
+static void record(RouteStats *stats, uint32_t start, esp_err_t err) {
+    uint32_t elapsed = micros() - start;
+    xSemaphoreTake(mutex, portMAX_DELAY);
+    stats->latency.record(elapsed);
+    if (err != ESP_OK) stats->errors++;
+    xSemaphoreGive(mutex);
+}
+
+static RouteStats *route(const char *uri, http_method method) {
+    xSemaphoreTake(mutex, portMAX_DELAY);
+    RouteStats *stats = &routes[String(http_method_str(method)) + " " + uri];
+    xSemaphoreGive(mutex);
+    return stats;
+}
+
+// Closes the least recently used socket which is idle and not held by EventSocket
+static void purgeIdle(int keep, unsigned long now) {
+    int oldest = -1;
+    unsigned long longestIdle = 0;
+    for (auto &[fd, active] : lastActive) {
+        unsigned long idle = now - active;
+        if (fd == keep || idle < HTTP_PURGE_MIN_IDLE || socket.hasClient(fd)) continue;
+        if (oldest < 0 || idle > longestIdle) {
+            oldest = fd;
+            longestIdle = idle;
+        }
+    }
+    if (oldest < 0) {
+        ESP_LOGW(TAG, "%u sockets open and none idle to purge", lastActive.size());
+        return;
+    }
+    ESP_LOGI(TAG, "Purging socket %d, idle for %lu ms", oldest, longestIdle);
+    if (httpd_sess_trigger_close(server->server, oldest) == ESP_OK) purged++;
+}
+
+static void onOpen(PsychicClient *client) {
+    unsigned long now = millis();
+    xSemaphoreTake(mutex, portMAX_DELAY);
+    lastActive[client->socket()] = now;
+    opened++;
+    if (lastActive.size() + HTTP_PURGE_HEADROOM > HTTP_MAX_OPEN_SOCKETS) purgeIdle(client->socket(), now);
+    xSemaphoreGive(mutex);
+}
+
+static void onClose(PsychicClient *client) {
+    xSemaphoreTake(mutex, portMAX_DELAY);
+    lastActive.erase(client->socket());
+    xSemaphoreGive(mutex);
+}
+
+void begin(PsychicHttpServer *httpServer) {
+    server = httpServer;
+    server->config.max_open_sockets = HTTP_MAX_OPEN_SOCKETS;
+    // last resort if every socket is busy, the server then drops its least recently used one itself
+    server->config.lru_purge_enable = true;
+    server->onOpen(onOpen);
+    server->onClose(onClose);
+}
+
+PsychicHttpRequestCallback timed(const char *uri, http_method method, PsychicHttpRequestCallback callback) {
+    RouteStats *stats = route(uri, method);
+    return [stats, callback](PsychicRequest *request) {
+        uint32_t start = micros();
+        touch(request);
+        esp_err_t err = callback(request);
+        record(stats, start, err);
+        return err;
+    };
+}
+
+PsychicJsonRequestCallback timed(const char *uri, http_method method, PsychicJsonRequestCallback callback) {
+    RouteStats *stats = route(uri, method);
+    return [stats, callback](PsychicRequest *request, JsonVariant &json) {
+        uint32_t start = micros();
+        touch(request);
+        esp_err_t err = callback(request, json);
+        record(stats, start, err);
+        return err;
+    };
+}
+
+RawBodyCallback timed(const char *uri, http_method method, RawBodyCallback callback) {
+    RouteStats *stats = route(uri, method);
+    return [stats, callback](PsychicRequest *request, const uint8_t *body, size_t len) {
+        uint32_t start = micros();
+        touch(request);
+        esp_err_t err = callback(request, body, len);
+        record(stats, start, err);
+        return err;
+    };
+}
+
+void metrics(JsonObject &root) {
+    xSemaphoreTake(mutex, portMAX_DELAY);
+    root["open"] = lastActive.size();
+    root["max_open"] = HTTP_MAX_OPEN_SOCKETS;
+    root["opened"] = opened;
+    root["purged"] = purged;
+    JsonObject routesObject = root["routes"].to<JsonObject>();
+    for (auto &[name, stats] : routes) {
+        if (!stats.latency.count()) continue;
+        JsonObject routeObject = routesObject[name].to<JsonObject>();
+        stats.latency.serialize(routeObject, false);
+        routeObject["errors"] = stats.errors;
+    }
+    xSemaphoreGive(mutex);
+}
+
+} // namespace connection_manager
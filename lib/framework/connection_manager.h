@@ -0,0 +1,46 @@
+#ifndef ConnectionManager_h
+#define ConnectionManager_h
+
+#include <ArduinoJson.h>
+#include <PsychicHttp.h>
+#include <raw_body_handler.h>
+
+// Sockets the http server may hold. lwIP keeps 3 of its 16 for itself and MQTT and the captive portal DNS take one each
+#ifndef HTTP_MAX_OPEN_SOCKETS
+#define HTTP_MAX_OPEN_SOCKETS 10
+#endif
+
+// Idle sockets are purged when a new connection leaves fewer than this many free
+#ifndef HTTP_PURGE_HEADROOM
+#define HTTP_PURGE_HEADROOM 2
+#endif
+
+// Sockets which saw a request more recently than this many ms are never purged
+#ifndef HTTP_PURGE_MIN_IDLE
+#define HTTP_PURGE_MIN_IDLE 1000
+#endif
+
+/*
+ * Keeps the http server below its socket limit.
+ *
+ * Tracks the last request on every socket and, when a new connection leaves the server
+ * short of sockets, closes the least recently used idle one. Websocket and Server-Sent
+ * Event clients are never purged, they are kept alive by EventSocket. Route callbacks
+ * registered through timed() are also timed per route.
+ */
+namespace connection_manager {
+
+// Sets the socket limits and connection callbacks, call before the server listens
+void begin(PsychicHttpServer *server);
+
+// Wraps a route callback to time it and mark its socket as active
+PsychicHttpRequestCallback timed(const char *uri, http_method method, PsychicHttpRequestCallback callback);
+PsychicJsonRequestCallback timed(const char *uri, http_method method, PsychicJsonRequestCallback callback);
+RawBodyCallback timed(const char *uri, http_method method, RawBodyCallback callback);
+
+// Open and purged sockets and latency percentiles per route
+void metrics(JsonObject &root);
+
+} // namespace connection_manager
+
+#endif
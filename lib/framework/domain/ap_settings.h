@@ -1,5 +1,7 @@
 #include <Arduino.h>
 #include <JsonUtils.h>
+#include <field_table.h>
+#include <state_lock.h>
 #include <stateful_result.h>
 #include <SettingValue.h>
 
@@ -50,6 +52,18 @@ enum APNetworkStatus { ACTIVE = 0, INACTIVE, LINGERING };
 
 class APSettings {
   public:
+    enum Field : field_mask_t {
+        FIELD_PROVISION_MODE = 1 << 0,
+        FIELD_SSID = 1 << 1,
+        FIELD_PASSWORD = 1 << 2,
+        FIELD_CHANNEL = 1 << 3,
+        FIELD_SSID_HIDDEN = 1 << 4,
+        FIELD_MAX_CLIENTS = 1 << 5,
+        FIELD_LOCAL_IP = 1 << 6,
+        FIELD_GATEWAY_IP = 1 << 7,
+        FIELD_SUBNET_MASK = 1 << 8,
+    };
+
     uint8_t provisionMode;
     String ssid;
     String password;
@@ -61,47 +75,35 @@ class APSettings {
     IPAddress gatewayIP;
     IPAddress subnetMask;
 
-    bool operator==(const APSettings &settings) const {
-        return provisionMode == settings.provisionMode && ssid == settings.ssid && password == settings.password &&
-               channel == settings.channel && ssidHidden == settings.ssidHidden && maxClients == settings.maxClients &&
-               localIP == settings.localIP && gatewayIP == settings.gatewayIP && subnetMask == settings.subnetMask;
+    static constexpr auto fields() {
+        return std::make_tuple(
+            field("provision_mode", &APSettings::provisionMode, FACTORY_AP_PROVISION_MODE, FIELD_PROVISION_MODE),
+            field("ssid", &APSettings::ssid, [] { return SettingValue::format(FACTORY_AP_SSID); }, FIELD_SSID),
+            field("password", &APSettings::password, FACTORY_AP_PASSWORD, FIELD_PASSWORD),
+            field("channel", &APSettings::channel, FACTORY_AP_CHANNEL, FIELD_CHANNEL),
+            field("ssid_hidden", &APSettings::ssidHidden, FACTORY_AP_SSID_HIDDEN, FIELD_SSID_HIDDEN),
+            field("max_clients", &APSettings::maxClients, FACTORY_AP_MAX_CLIENTS, FIELD_MAX_CLIENTS),
+            field("local_ip", &APSettings::localIP, FACTORY_AP_LOCAL_IP, FIELD_LOCAL_IP),
+            field("gateway_ip", &APSettings::gatewayIP, FACTORY_AP_GATEWAY_IP, FIELD_GATEWAY_IP),
+            field("subnet_mask", &APSettings::subnetMask, FACTORY_AP_SUBNET_MASK, FIELD_SUBNET_MASK));
     }
 
-    static void read(APSettings &settings, JsonObject &root) {
-        root["provision_mode"] = settings.provisionMode;
-        root["ssid"] = settings.ssid;
-        root["password"] = settings.password;
-        root["channel"] = settings.channel;
-        root["ssid_hidden"] = settings.ssidHidden;
-        root["max_clients"] = settings.maxClients;
-        root["local_ip"] = settings.localIP.toString();
-        root["gateway_ip"] = settings.gatewayIP.toString();
-        root["subnet_mask"] = settings.subnetMask.toString();
-    }
+    static void read(APSettings &settings, JsonObject &root) { field_table::read(settings, root); }
 
     static StateUpdateResult update(JsonObject &root, APSettings &settings) {
-        APSettings newSettings = {};
-        newSettings.provisionMode = root["provision_mode"] | FACTORY_AP_PROVISION_MODE;
+        field_mask_t changed = field_table::update(root, settings);
         switch (settings.provisionMode) {
             case AP_MODE_ALWAYS:
             case AP_MODE_DISCONNECTED:
             case AP_MODE_NEVER: break;
-            default: newSettings.provisionMode = AP_MODE_DISCONNECTED;
+            default: settings.provisionMode = AP_MODE_DISCONNECTED;
         }
-        newSettings.ssid = root["ssid"] | SettingValue::format(FACTORY_AP_SSID);
-        newSettings.password = root["password"] | FACTORY_AP_PASSWORD;
-        newSettings.channel = root["channel"] | FACTORY_AP_CHANNEL;
-        newSettings.ssidHidden = root["ssid_hidden"] | FACTORY_AP_SSID_HIDDEN;
-        newSettings.maxClients = root["max_clients"] | FACTORY_AP_MAX_CLIENTS;
-
-        JsonUtils::readIP(root, "local_ip", newSettings.localIP, FACTORY_AP_LOCAL_IP);
-        JsonUtils::readIP(root, "gateway_ip", newSettings.gatewayIP, FACTORY_AP_GATEWAY_IP);
-        JsonUtils::readIP(root, "subnet_mask", newSettings.subnetMask, FACTORY_AP_SUBNET_MASK);
-
-        if (newSettings == settings) {
-            return StateUpdateResult::UNCHANGED;
-        }
-        settings = newSettings;
-        return StateUpdateResult::CHANGED;
+        return StateUpdateResult::changed(changed);
     }
-};
\ No newline at end of file
+};
+
+// Read far more often than changed, readers share the lock
+template <>
+struct StateLockPolicy<APSettings> {
+    using type = SharedStateLock;
+};
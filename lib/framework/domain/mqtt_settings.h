@@ -1,5 +1,6 @@
 #include <Arduino.h>
 #include <ArduinoJson.h>
+#include <field_table.h>
 #include <stateful_result.h>
 #include <SettingValue.h>
 
@@ -43,6 +44,16 @@
 
 class MqttSettings {
   public:
+    enum Field : field_mask_t {
+        FIELD_ENABLED = 1 << 0,
+        FIELD_URI = 1 << 1,
+        FIELD_USERNAME = 1 << 2,
+        FIELD_PASSWORD = 1 << 3,
+        FIELD_CLIENT_ID = 1 << 4,
+        FIELD_KEEP_ALIVE = 1 << 5,
+        FIELD_CLEAN_SESSION = 1 << 6,
+    };
+
     // host and port - if enabled
     bool enabled;
     String uri;
@@ -58,24 +69,24 @@ class MqttSettings {
     uint16_t keepAlive;
     bool cleanSession;
 
-    static void read(MqttSettings &settings, JsonObject &root) {
-        root["enabled"] = settings.enabled;
-        root["uri"] = settings.uri;
-        root["username"] = settings.username;
-        root["password"] = settings.password;
-        root["client_id"] = settings.clientId;
-        root["keep_alive"] = settings.keepAlive;
-        root["clean_session"] = settings.cleanSession;
+    static constexpr auto fields() {
+        return std::make_tuple(
+            field("enabled", &MqttSettings::enabled, FACTORY_MQTT_ENABLED, FIELD_ENABLED),
+            field("uri", &MqttSettings::uri, FACTORY_MQTT_URI, FIELD_URI),
+            field(
+                "username", &MqttSettings::username, [] { return SettingValue::format(FACTORY_MQTT_USERNAME); },
+                FIELD_USERNAME),
+            field("password", &MqttSettings::password, FACTORY_MQTT_PASSWORD, FIELD_PASSWORD),
+            field(
+                "client_id", &MqttSettings::clientId, [] { return SettingValue::format(FACTORY_MQTT_CLIENT_ID); },
+                FIELD_CLIENT_ID),
+            field("keep_alive", &MqttSettings::keepAlive, FACTORY_MQTT_KEEP_ALIVE, FIELD_KEEP_ALIVE),
+            field("clean_session", &MqttSettings::cleanSession, FACTORY_MQTT_CLEAN_SESSION, FIELD_CLEAN_SESSION));
     }
 
+    static void read(MqttSettings &settings, JsonObject &root) { field_table::read(settings, root); }
+
     static StateUpdateResult update(JsonObject &root, MqttSettings &settings) {
-        settings.enabled = root["enabled"] | FACTORY_MQTT_ENABLED;
-        settings.uri = root["uri"] | FACTORY_MQTT_URI;
-        settings.username = root["username"] | SettingValue::format(FACTORY_MQTT_USERNAME);
-        settings.password = root["password"] | FACTORY_MQTT_PASSWORD;
-        settings.clientId = root["client_id"] | SettingValue::format(FACTORY_MQTT_CLIENT_ID);
-        settings.keepAlive = root["keep_alive"] | FACTORY_MQTT_KEEP_ALIVE;
-        settings.cleanSession = root["clean_session"] | FACTORY_MQTT_CLEAN_SESSION;
-        return StateUpdateResult::CHANGED;
+        return StateUpdateResult::changed(field_table::update(root, settings));
     }
 };
\ No newline at end of file
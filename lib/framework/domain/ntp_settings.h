@@ -1,4 +1,6 @@
 #include <Arduino.h>
+#include <field_table.h>
+#include <state_lock.h>
 #include <stateful_result.h>
 #include <ArduinoJson.h>
 
@@ -20,23 +22,35 @@
 
 class NTPSettings {
   public:
+    enum Field : field_mask_t {
+        FIELD_ENABLED = 1 << 0,
+        FIELD_SERVER = 1 << 1,
+        FIELD_TZ_LABEL = 1 << 2,
+        FIELD_TZ_FORMAT = 1 << 3,
+    };
+
     bool enabled;
     String tzLabel;
     String tzFormat;
     String server;
 
-    static void read(NTPSettings &settings, JsonObject &root) {
-        root["enabled"] = settings.enabled;
-        root["server"] = settings.server;
-        root["tz_label"] = settings.tzLabel;
-        root["tz_format"] = settings.tzFormat;
+    static constexpr auto fields() {
+        return std::make_tuple(
+            field("enabled", &NTPSettings::enabled, FACTORY_NTP_ENABLED, FIELD_ENABLED),
+            field("server", &NTPSettings::server, FACTORY_NTP_SERVER, FIELD_SERVER),
+            field("tz_label", &NTPSettings::tzLabel, FACTORY_NTP_TIME_ZONE_LABEL, FIELD_TZ_LABEL),
+            field("tz_format", &NTPSettings::tzFormat, FACTORY_NTP_TIME_ZONE_FORMAT, FIELD_TZ_FORMAT));
     }
 
+    static void read(NTPSettings &settings, JsonObject &root) { field_table::read(settings, root); }
+
     static StateUpdateResult update(JsonObject &root, NTPSettings &settings) {
-        settings.enabled = root["enabled"] | FACTORY_NTP_ENABLED;
-        settings.server = root["server"] | FACTORY_NTP_SERVER;
-        settings.tzLabel = root["tz_label"] | FACTORY_NTP_TIME_ZONE_LABEL;
-        settings.tzFormat = root["tz_format"] | FACTORY_NTP_TIME_ZONE_FORMAT;
-        return StateUpdateResult::CHANGED;
+        return StateUpdateResult::changed(field_table::update(root, settings));
     }
-};
\ No newline at end of file
+};
+
+// Only the settings page writes, status and sync readers share the lock
+template <>
+struct StateLockPolicy<NTPSettings> {
+    using type = SharedStateLock;
+};
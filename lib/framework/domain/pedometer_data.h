@@ -1,8 +1,15 @@
 #pragma once
 
+#include <algorithm>
 #include <vector>
 #include <ArduinoJson.h>
+#include <field_table.h>
+#include <json_stream.h>
+#include <state_lock.h>
 #include <stateful_result.h>
+#include <downsample.h>
+#include <domain/pedometer_totals.h>
+#include <domain/step_aggregate.h>
 
 struct SessionSlot {
     long start;
@@ -10,75 +17,239 @@ struct SessionSlot {
     int steps;
     std::vector<float> times;
 
-    void serialize(JsonObject &json) const {
-        json["start"] = start;
-        json["end"] = end;
-        json["steps"] = steps;
-        JsonArray timesArray = json["times"].to<JsonArray>();
-        for (auto &time : times) {
-            timesArray.add(time);
-        }
+    static constexpr auto fields() {
+        return std::make_tuple(field("start", &SessionSlot::start, 0),
+                               field("end", &SessionSlot::end, 0),
+                               field("steps", &SessionSlot::steps, 0),
+                               field("times", &SessionSlot::times, EMPTY_VALUE));
     }
-    bool deserialize(const JsonObject &json) {
-        start = json["start"];
-        end = json["end"];
-        steps = json["steps"];
 
-        if (json["times"].is<JsonArray>()) {
-            times.clear();
-            JsonArray timesArray = json["times"];
-            for (JsonVariant time : timesArray) {
-                times.push_back(time);
-            }
+    // Steps are timed from the start of the session by adding up the intervals
+    template <typename Callback>
+    void forEachStep(Callback &&callback) const {
+        double timestamp = start;
+        for (float interval : times) {
+            timestamp += interval;
+            callback((long)timestamp, interval);
         }
-        return true;
     }
+
+    double lastStep() const {
+        double timestamp = start;
+        for (float interval : times) timestamp += interval;
+        return timestamp;
+    }
+};
+
+// Reads a session as speed over time, x in seconds since the session started and y in m/s
+struct SessionSpeedReader {
+    const float *times;
+    float circumference;
+    double elapsed {0};
+
+    SeriesPoint next() {
+        float interval = *times++;
+        elapsed += interval;
+        return {(float)elapsed, interval > 0 ? circumference / interval : 0};
+    }
+};
+
+struct StepRecord {
+    long sessionStart;
+    double timestamp;
+    float interval;
+};
+
+// A session without its times, which are copied separately in batches
+struct SessionHeader {
+    long start {0};
+    long end {0};
+    int steps {0};
+    size_t times {0};
+};
+
+// The history at one point in time. Sessions only grow until they are reset or replaced, so the part
+// the view covers can be copied in batches with the state unlocked in between.
+struct HistoryView {
+    float magnets {0};
+    float diameter {0};
+    size_t sessions {0};
+    SessionHeader last; // the latest session keeps growing, the view covers it as it was
+    uint32_t generation {0};
+};
+
+// Position of an export in the step history, kept between batches
+struct StepCursor {
+    size_t session {0};
+    size_t step {0};
+    double timestamp {0};
 };
 
 class PedoMeterData {
+  public:
+    enum Field : field_mask_t {
+        FIELD_MAGNETS = 1 << 0,
+        FIELD_DIAMETER = 1 << 1,
+        FIELD_SESSIONS = 1 << 2,
+    };
+
+  private:
     std::vector<SessionSlot> sessions;
+    StepRollups rollups;
     float diameterOfHamsterWheel = 0.19;
     float numOfMagnets = 1;
+    uint32_t generation = 0; // counts resets and replacements of the sessions
+    double lastStep = 0;     // time of the latest step, like the history its session start plus the intervals
 
-  public:
-    static void read(PedoMeterData &settings, JsonObject &root) {
-        root["magnets"] = settings.numOfMagnets;
-        root["diameter"] = settings.diameterOfHamsterWheel;
-        JsonArray sessionsArray = root["sessions"].to<JsonArray>();
-
-        for (auto &session : settings.sessions) {
-            JsonObject newSession = sessionsArray.add<JsonObject>();
-            session.serialize(newSession);
-        }
+    static SessionHeader header(const SessionSlot &session) {
+        return {session.start, session.end, session.steps, session.times.size()};
     }
 
-    static StateUpdateResult update(JsonObject &root, PedoMeterData &settings) {
-        settings.numOfMagnets = root["magnets"] || settings.numOfMagnets;
-        settings.diameterOfHamsterWheel = root["diameter"] || settings.diameterOfHamsterWheel;
-        settings.sessions.clear();
+    void rebuildRollups() {
+        rollups.clear();
+        for (auto &session : sessions) {
+            session.forEachStep([this](long timestamp, float interval) { rollups.add(timestamp, interval); });
+        }
+        lastStep = sessions.empty() ? 0 : sessions.back().lastStep();
+    }
 
-        if (root["sessions"].is<JsonArray>()) {
-            JsonArray sessionsArray = root["sessions"];
+  public:
+    // A missing wheel size keeps the current one, missing sessions clear the history
+    static constexpr auto fields() {
+        return std::make_tuple(field("magnets", &PedoMeterData::numOfMagnets, KEEP_VALUE, FIELD_MAGNETS),
+                               field("diameter", &PedoMeterData::diameterOfHamsterWheel, KEEP_VALUE, FIELD_DIAMETER),
+                               field("sessions", &PedoMeterData::sessions, EMPTY_VALUE, FIELD_SESSIONS));
+    }
 
-            for (auto jsonSession : sessionsArray) {
-                JsonObject sessionJson = jsonSession.as<JsonObject>();
+    static void read(PedoMeterData &settings, JsonObject &root) { field_table::read(settings, root); }
 
-                SessionSlot newSession;
-                if (newSession.deserialize(sessionJson)) {
-                    settings.sessions.push_back(newSession);
-                }
-            }
+    static StateUpdateResult update(JsonObject &root, PedoMeterData &settings) {
+        field_mask_t changed = field_table::update(root, settings);
+        if (changed & FIELD_SESSIONS) {
+            settings.generation++;
+            settings.rebuildRollups();
         }
-
-        return StateUpdateResult::CHANGED;
+        return StateUpdateResult::changed(changed);
     }
+
     void updateSession(float timeElapsed) {
+        if (sessions.empty()) startSession(); // history was reset mid session
         SessionSlot &lastSession = sessions.back();
         lastSession.steps += 1;
         lastSession.times.push_back(timeElapsed);
+        lastStep += timeElapsed;
+        rollups.add((long)lastStep, timeElapsed);
+    }
+
+    // Copies up to max steps after since, starting at the cursor. Returns the number copied, 0 once done.
+    size_t copySteps(StepCursor &cursor, double since, StepRecord *records, size_t max) const {
+        size_t count = 0;
+        while (cursor.session < sessions.size() && count < max) {
+            const SessionSlot &session = sessions[cursor.session];
+            if (cursor.step == 0) cursor.timestamp = session.start;
+            if (cursor.step >= session.times.size() || (session.end && session.end <= since)) {
+                cursor.session++;
+                cursor.step = 0;
+                continue;
+            }
+            float interval = session.times[cursor.step++];
+            cursor.timestamp += interval;
+            if (cursor.timestamp > since) records[count++] = {session.start, cursor.timestamp, interval};
+        }
+        return count;
+    }
+
+    HistoryView view() const {
+        HistoryView view {numOfMagnets, diameterOfHamsterWheel, sessions.size(), {}, generation};
+        if (!sessions.empty()) view.last = header(sessions.back());
+        return view;
+    }
+
+    // Header of a session in the view, false if the sessions were reset or replaced since it was taken
+    bool copySession(const HistoryView &view, size_t index, SessionHeader &session) const {
+        if (view.generation != generation || index >= view.sessions) return false;
+        session = index + 1 == view.sessions ? view.last : header(sessions[index]);
+        return true;
+    }
+
+    // Batches of at most max times the sessions in the view are copied in, one for a session without times
+    size_t countBatches(const HistoryView &view, size_t max) const {
+        size_t batches = 0;
+        for (size_t i = 0; i < view.sessions; i++) {
+            size_t times = i + 1 == view.sessions ? view.last.times : sessions[i].times.size();
+            batches += times ? (times + max - 1) / max : 1;
+        }
+        return batches;
     }
 
-    void startSession() { sessions.push_back(SessionSlot {.start = time(nullptr)}); }
+    // Copies up to max times of a session in the view from offset on. Returns the number copied, 0 if the
+    // sessions were reset or replaced since the view was taken.
+    size_t copyTimes(const HistoryView &view, size_t index, size_t offset, float *times, size_t max) const {
+        SessionHeader session;
+        if (!copySession(view, index, session) || offset >= session.times) return 0;
+        size_t count = std::min(max, session.times - offset);
+        memcpy(times, sessions[index].times.data() + offset, count * sizeof(float));
+        return count;
+    }
+
+    // Latest session with the given start, or the latest session at all for 0
+    const SessionSlot *findSession(long start) const {
+        for (auto it = sessions.rbegin(); it != sessions.rend(); ++it) {
+            if (!start || it->start == start) return &*it;
+        }
+        return nullptr;
+    }
+
+    // Adds the speed of the session started at start (0 for the latest) downsampled to at most points to
+    // out, which has to have room for them. Returns false if there is no such session.
+    bool series(long start, size_t points, bool minMax, SessionHeader &session, std::vector<SeriesPoint> &out) const {
+        const SessionSlot *slot = findSession(start);
+        if (!slot) return false;
+        session = header(*slot);
+        auto emit = [&](SeriesPoint point) { out.push_back(point); };
+        SessionSpeedReader reader {slot->times.data(), circumference()};
+        if (minMax) {
+            downsampleMinMax(reader, slot->times.size(), points, emit);
+        } else {
+            downsampleLttb(reader, slot->times.size(), points, emit);
+        }
+        return true;
+    }
+
+    float circumference() const { return M_PI * diameterOfHamsterWheel / numOfMagnets; }
+
+    size_t sessionCount() const { return sessions.size(); }
+
+    // Walks the whole history, the steps recorded afterwards are added to the totals one by one
+    PedoMeterTotals totals() const {
+        PedoMeterTotals totals;
+        totals.sessions = sessions.size();
+        for (const auto &session : sessions) {
+            totals.steps += session.times.size();
+            for (float interval : session.times) totals.seconds += interval;
+        }
+        totals.distance = totals.steps * circumference();
+        return totals;
+    }
+
+    // Whole hour buckets from an hour on within the rollup window can be aggregated from the rollups
+    bool rollupsCover(long from, long bucketSize) const {
+        return bucketSize % SECONDS_PER_HOUR == 0 && from % SECONDS_PER_HOUR == 0 &&
+               rollups.covers(from / SECONDS_PER_HOUR);
+    }
+
+    // Copies the rollups of count hours from firstHour on, hours without steps stay empty
+    void copyRollups(long firstHour, size_t count, StepBucket *buckets) const {
+        for (size_t i = 0; i < count; i++) {
+            const StepBucket *bucket = rollups.at(firstHour + i);
+            buckets[i] = bucket ? *bucket : StepBucket();
+        }
+    }
+
+    void startSession() {
+        sessions.push_back(SessionSlot {.start = time(nullptr)});
+        lastStep = sessions.back().start;
+    }
 
     void endSession() {
         if (sessions.empty()) return;
@@ -86,5 +257,15 @@ class PedoMeterData {
         lastSession.end = time(nullptr);
     }
 
-    void reset() { sessions.clear(); }
-};
\ No newline at end of file
+    void reset() {
+        generation++;
+        sessions.clear();
+        rollups.clear();
+    }
+};
+
+// Concurrent history, aggregate and export streams share the lock, steps still update exclusively
+template <>
+struct StateLockPolicy<PedoMeterData> {
+    using type = SharedStateLock;
+};
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <field_table.h>
+#include <state_lock.h>
+#include <stdint.h>
+
+// Running totals of the step history, kept next to it so they can be read without walking the sessions
+struct PedoMeterTotals {
+    uint32_t sessions {0};
+    uint32_t steps {0};
+    float seconds {0}; // time in the wheel
+    float distance {0};
+
+    static constexpr auto fields() {
+        return std::make_tuple(field("sessions", &PedoMeterTotals::sessions, 0),
+                               field("steps", &PedoMeterTotals::steps, 0),
+                               field("seconds", &PedoMeterTotals::seconds, 0),
+                               field("distance", &PedoMeterTotals::distance, 0));
+    }
+
+    void addStep(float interval, float circumference) {
+        steps++;
+        seconds += interval;
+        distance = steps * circumference;
+    }
+};
+
+// Steps update the totals several times a second, readers get a copy and never wait for them
+template <>
+struct StateLockPolicy<PedoMeterTotals> {
+    using type = SeqStateLock;
+};
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <json_stream.h>
+
+// Hours of step rollups kept in memory, 12 bytes each, older ranges are aggregated from the raw sessions.
+// Two days cover the hourly chart of the last day wherever its local hours start.
+#ifndef STEP_ROLLUP_HOURS
+#define STEP_ROLLUP_HOURS 48
+#endif
+
+#define SECONDS_PER_HOUR 3600
+
+struct StepBucket {
+    uint32_t steps {0};
+    float seconds {0};     // time in the wheel, sum of the intervals between steps
+    float minInterval {0}; // shortest interval between two steps, 0 if there was none
+
+    bool empty() const { return !steps; }
+
+    void add(float interval) {
+        steps++;
+        seconds += interval;
+        if (interval > 0 && (!minInterval || interval < minInterval)) minInterval = interval;
+    }
+
+    void merge(const StepBucket &other) {
+        steps += other.steps;
+        seconds += other.seconds;
+        if (other.minInterval && (!minInterval || other.minInterval < minInterval)) minInterval = other.minInterval;
+    }
+
+    // [t, distance m, time in wheel s, max speed m/s, average speed m/s]
+    void stream(JsonStreamWriter &json, long t, float circumference) const {
+        float distance = steps * circumference;
+        json.beginArray(5);
+        json.value(t);
+        json.value(distance);
+        json.value(seconds);
+        json.value(minInterval ? circumference / minInterval : 0.0f);
+        json.value(seconds ? distance / seconds : 0.0f);
+        json.endArray();
+    }
+};
+
+/*
+ * Hourly step totals for the last STEP_ROLLUP_HOURS hours, in a ring indexed by hour.
+ * Rebuilt from the sessions when they are loaded and updated with every step. The slots
+ * of the hours the newest one moves past are cleared, so every slot belongs to its hour.
+ */
+class StepRollups {
+  public:
+    StepRollups() { clear(); }
+
+    void add(long timestamp, float interval) {
+        long hour = timestamp / SECONDS_PER_HOUR;
+        if (hour > _newest) advance(hour);
+        if (!covers(hour)) return;
+        _buckets[hour % STEP_ROLLUP_HOURS].add(interval);
+    }
+
+    // true if the hour is recent enough to be answered from the rollups, even if it had no steps
+    bool covers(long hour) const { return hour >= 0 && hour > _newest - STEP_ROLLUP_HOURS; }
+
+    const StepBucket *at(long hour) const {
+        return covers(hour) && hour <= _newest ? &_buckets[hour % STEP_ROLLUP_HOURS] : nullptr;
+    }
+
+    void clear() {
+        for (auto &bucket : _buckets) bucket = StepBucket();
+        _newest = 0;
+    }
+
+  private:
+    StepBucket _buckets[STEP_ROLLUP_HOURS];
+    long _newest {0};
+
+    void advance(long hour) {
+        for (long next = std::max(_newest + 1, hour - STEP_ROLLUP_HOURS + 1); next <= hour; next++) {
+            _buckets[next % STEP_ROLLUP_HOURS] = StepBucket();
+        }
+        _newest = hour;
+    }
+};
+
+/*
+ * Collects steps or hourly rollups in chronological order into fixed size buckets
+ * and streams every non empty bucket as soon as it is complete.
+ */
+class StepAggregator {
+  public:
+    StepAggregator(long from, long to, long bucketSize, float circumference, JsonStreamWriter &json)
+        : _from(from), _to(to), _bucketSize(bucketSize), _circumference(circumference), _json(json) {
+        _start = from;
+    }
+
+    void addStep(long timestamp, float interval) {
+        if (!advance(timestamp)) return;
+        _current.add(interval);
+    }
+
+    void addBucket(long timestamp, const StepBucket &bucket) {
+        if (!advance(timestamp)) return;
+        _current.merge(bucket);
+    }
+
+    void finish() { flush(); }
+
+  private:
+    long _from;
+    long _to;
+    long _bucketSize;
+    float _circumference;
+    JsonStreamWriter &_json;
+    long _start;
+    StepBucket _current;
+
+    bool advance(long timestamp) {
+        if (timestamp < _from || timestamp >= _to) return false;
+        if (timestamp >= _start + _bucketSize) {
+            flush();
+            _start = _from + (timestamp - _from) / _bucketSize * _bucketSize;
+        }
+        return true;
+    }
+
+    void flush() {
+        if (!_current.empty()) _current.stream(_json, _start, _circumference);
+        _current = StepBucket();
+    }
+};
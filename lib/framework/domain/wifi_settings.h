@@ -2,6 +2,8 @@
 
 #include <ArduinoJson.h>
 #include <JsonUtils.h>
+#include <field_table.h>
+#include <state_lock.h>
 #include <stateful_result.h>
 #include <SettingValue.h>
 
@@ -17,11 +19,13 @@
 #define FACTORY_WIFI_HOSTNAME "#{platform}-#{unique_id}"
 #endif
 
+#define WIFI_MAX_NETWORKS 5
+
 #ifndef FACTORY_WIFI_RSSI_THRESHOLD
 #define FACTORY_WIFI_RSSI_THRESHOLD -80
 #endif
 
-typedef struct {
+struct wifi_settings_t {
     String ssid;
     uint8_t bssid[6];
     int32_t channel;
@@ -34,40 +38,26 @@ typedef struct {
     IPAddress dnsIP2;
     bool available;
 
-    void serialize(JsonObject &json) const {
-        json["ssid"] = ssid;
-        json["password"] = password;
-        json["static_ip_config"] = staticIPConfig;
-
-        if (staticIPConfig) {
-            JsonUtils::writeIP(json, "local_ip", localIP);
-            JsonUtils::writeIP(json, "gateway_ip", gatewayIP);
-            JsonUtils::writeIP(json, "subnet_mask", subnetMask);
-            JsonUtils::writeIP(json, "dns_ip_1", dnsIP1);
-            JsonUtils::writeIP(json, "dns_ip_2", dnsIP2);
-        }
+    // bssid, channel and availability come from scans and aren't stored
+    static constexpr auto fields() {
+        return std::make_tuple(field("ssid", &wifi_settings_t::ssid, ""),
+                               field("password", &wifi_settings_t::password, ""),
+                               field("static_ip_config", &wifi_settings_t::staticIPConfig, false),
+                               optionalField("local_ip", &wifi_settings_t::localIP, EMPTY_VALUE),
+                               optionalField("gateway_ip", &wifi_settings_t::gatewayIP, EMPTY_VALUE),
+                               optionalField("subnet_mask", &wifi_settings_t::subnetMask, EMPTY_VALUE),
+                               optionalField("dns_ip_1", &wifi_settings_t::dnsIP1, EMPTY_VALUE),
+                               optionalField("dns_ip_2", &wifi_settings_t::dnsIP2, EMPTY_VALUE));
     }
 
-    bool deserialize(const JsonObject &json) {
-        String newSsid = json["ssid"].as<String>();
-        String newPassword = json["password"].as<String>();
-
-        if (newSsid.length() < 1 || newSsid.length() > 31 || newPassword.length() > 64) {
+    // Called for every network decoded from JSON, which is dropped on false
+    bool validate() {
+        if (ssid.length() < 1 || ssid.length() > 31 || password.length() > 64) {
             ESP_LOGE("WiFiSettings", "SSID or password length is invalid");
             return false;
         }
 
-        ssid = newSsid;
-        password = newPassword;
-        staticIPConfig = json["static_ip_config"] | false;
-
         if (staticIPConfig) {
-            JsonUtils::readIP(json, "local_ip", localIP);
-            JsonUtils::readIP(json, "gateway_ip", gatewayIP);
-            JsonUtils::readIP(json, "subnet_mask", subnetMask);
-            JsonUtils::readIP(json, "dns_ip_1", dnsIP1);
-            JsonUtils::readIP(json, "dns_ip_2", dnsIP2);
-
             if (IPUtils::isNotSet(dnsIP1) && IPUtils::isSet(dnsIP2)) {
                 dnsIP1 = dnsIP2;
                 dnsIP2 = INADDR_NONE;
@@ -79,11 +69,11 @@ typedef struct {
             }
         }
 
-        available = false;
+        // unset addresses aren't written, so DHCP networks are stored without any
+        if (!staticIPConfig) localIP = gatewayIP = subnetMask = dnsIP1 = dnsIP2 = INADDR_NONE;
         return true;
     }
-
-} wifi_settings_t;
+};
 
 inline wifi_settings_t createDefaultWiFiSettings() {
     return wifi_settings_t {.ssid = FACTORY_WIFI_SSID,
@@ -97,51 +87,53 @@ inline wifi_settings_t createDefaultWiFiSettings() {
                             .available = false};
 }
 
+inline std::vector<wifi_settings_t> createDefaultNetworks() {
+    if (String(FACTORY_WIFI_SSID).length() == 0) return {};
+    return {createDefaultWiFiSettings()};
+}
+
 class WiFiSettings {
   public:
+    enum Field : field_mask_t {
+        FIELD_HOSTNAME = 1 << 0,
+        FIELD_PRIORITY_RSSI = 1 << 1,
+        FIELD_NETWORKS = 1 << 2,
+    };
+
     String hostname;
     bool priorityBySignalStrength;
     std::vector<wifi_settings_t> wifiSettings;
 
-    static void read(WiFiSettings &settings, JsonObject &root) {
-        root["hostname"] = settings.hostname;
-        root["priority_RSSI"] = settings.priorityBySignalStrength;
-
-        JsonArray wifiNetworks = root["wifi_networks"].to<JsonArray>();
-        for (const auto &wifi : settings.wifiSettings) {
-            JsonObject wifiNetwork = wifiNetworks.add<JsonObject>();
-            wifi.serialize(wifiNetwork);
-        }
+    static constexpr auto fields() {
+        return std::make_tuple(
+            field(
+                "hostname", &WiFiSettings::hostname, [] { return SettingValue::format(FACTORY_WIFI_HOSTNAME); },
+                FIELD_HOSTNAME),
+            field("priority_RSSI", &WiFiSettings::priorityBySignalStrength, true, FIELD_PRIORITY_RSSI),
+            field("wifi_networks", &WiFiSettings::wifiSettings, createDefaultNetworks, FIELD_NETWORKS));
+    }
 
+    static void read(WiFiSettings &settings, JsonObject &root) {
+        field_table::read(settings, root);
         ESP_LOGV("WiFiSettings", "WiFi Settings read");
     }
 
     static StateUpdateResult update(JsonObject &root, WiFiSettings &settings) {
-        settings.hostname = root["hostname"] | SettingValue::format(FACTORY_WIFI_HOSTNAME);
-        settings.priorityBySignalStrength = root["priority_RSSI"] | true;
-        settings.wifiSettings.clear();
-
-        if (root["wifi_networks"].is<JsonArray>()) {
-            JsonArray wifiNetworks = root["wifi_networks"];
-            int networkCount = 0;
-
-            for (JsonObject wifiNetwork : wifiNetworks) {
-                if (networkCount >= 5) {
-                    ESP_LOGE("WiFiSettings", "Too many wifi networks");
-                    break;
-                }
-
-                wifi_settings_t newSettings;
-                if (newSettings.deserialize(wifiNetwork)) {
-                    settings.wifiSettings.push_back(newSettings);
-                    networkCount++;
-                }
-            }
-        } else if (String(FACTORY_WIFI_SSID).length() > 0) {
-            settings.wifiSettings.push_back(createDefaultWiFiSettings());
+        // the networks are compared once the surplus is dropped, so a list cut to the stored one is unchanged
+        std::vector<wifi_settings_t> networks = settings.wifiSettings;
+        field_mask_t changed = field_table::update(root, settings) & ~FIELD_NETWORKS;
+        if (settings.wifiSettings.size() > WIFI_MAX_NETWORKS) {
+            ESP_LOGE("WiFiSettings", "Too many wifi networks");
+            settings.wifiSettings.resize(WIFI_MAX_NETWORKS);
         }
-
+        if (!field_table::equals(networks, settings.wifiSettings)) changed |= FIELD_NETWORKS;
         ESP_LOGV("WiFiSettings", "WiFi Settings updated");
-        return StateUpdateResult::CHANGED;
+        return StateUpdateResult::changed(changed);
     }
-};
\ No newline at end of file
+};
+
+// Read on every status request and reconnect attempt, changed only from the settings page
+template <>
+struct StateLockPolicy<WiFiSettings> {
+    using type = SharedStateLock;
+};
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <math.h>
+#include <stddef.h>
+
+/*
+ * Shape preserving downsampling of time series, without allocations.
+ *
+ * Points are pulled from a Reader, a small copyable object whose next() returns the
+ * following point. Copies are used to look ahead, so each point is read at most three
+ * times and x may be computed on the fly, e.g. by adding up step intervals.
+ * Only depends on the C library, test/test_downsample checks and times it on the host.
+ */
+
+struct SeriesPoint {
+    float x;
+    float y;
+};
+
+template <typename Reader>
+void skipPoints(Reader &reader, size_t count) {
+    for (size_t i = 0; i < count; i++) reader.next();
+}
+
+// Largest-Triangle-Three-Buckets (Steinarsson 2013), emits exactly threshold points if count > threshold
+template <typename Reader, typename Emit>
+void downsampleLttb(Reader reader, size_t count, size_t threshold, Emit &&emit) {
+    if (threshold >= count || threshold < 3) {
+        for (size_t i = 0; i < count; i++) emit(reader.next());
+        return;
+    }
+
+    double every = double(count - 2) / (threshold - 2);
+    SeriesPoint selected = reader.next();
+    emit(selected);
+
+    size_t index = 1;
+    for (size_t bucket = 0; bucket < threshold - 2; bucket++) {
+        size_t end = size_t((bucket + 1) * every) + 1;
+        size_t nextEnd = size_t((bucket + 2) * every) + 1;
+        if (nextEnd > count) nextEnd = count;
+
+        // average of the next bucket, the third corner of the triangle
+        Reader ahead = reader;
+        skipPoints(ahead, end - index);
+        double avgX = 0, avgY = 0;
+        for (size_t i = end; i < nextEnd; i++) {
+            SeriesPoint point = ahead.next();
+            avgX += point.x;
+            avgY += point.y;
+        }
+        avgX /= nextEnd - end;
+        avgY /= nextEnd - end;
+
+        SeriesPoint best = selected;
+        double bestArea = -1;
+        for (; index < end; index++) {
+            SeriesPoint point = reader.next();
+            double area =
+                fabs((selected.x - avgX) * (point.y - selected.y) - (selected.x - point.x) * (avgY - selected.y));
+            if (area > bestArea) {
+                bestArea = area;
+                best = point;
+            }
+        }
+        emit(best);
+        selected = best;
+    }
+
+    skipPoints(reader, count - 1 - index);
+    emit(reader.next());
+}
+
+// Minimum and maximum of every bucket in x order, emits at most threshold points
+template <typename Reader, typename Emit>
+void downsampleMinMax(Reader reader, size_t count, size_t threshold, Emit &&emit) {
+    size_t buckets = threshold / 2;
+    if (threshold >= count || !buckets) {
+        for (size_t i = 0; i < count; i++) emit(reader.next());
+        return;
+    }
+
+    size_t index = 0;
+    for (size_t bucket = 0; bucket < buckets; bucket++) {
+        size_t end = (bucket + 1) * count / buckets;
+        SeriesPoint min = reader.next(), max = min;
+        for (index++; index < end; index++) {
+            SeriesPoint point = reader.next();
+            if (point.y < min.y) min = point;
+            if (point.y > max.y) max = point;
+        }
+        bool minFirst = min.x <= max.x;
+        emit(minFirst ? min : max);
+        if (min.x != max.x || min.y != max.y) emit(minFirst ? max : min);
+    }
+}
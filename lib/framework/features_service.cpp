@@ -39,11 +39,4 @@ void features(JsonObject &root) {
     root["firmware_built_target"] = BUILD_TARGET;
 }
 
-esp_err_t getFeatures(PsychicRequest *request) {
-    PsychicJsonResponse response = PsychicJsonResponse(request, false);
-    JsonObject root = response.getRoot();
-    features(root);
-    return response.send();
-}
-
 } // namespace feature_service
@@ -11,8 +11,6 @@ namespace feature_service {
 
 void features(JsonObject &root);
 
-esp_err_t getFeatures(PsychicRequest *request);
-
 } // namespace feature_service
 
 #endif
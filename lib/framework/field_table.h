@@ -0,0 +1,256 @@
+#pragma once
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <JsonUtils.h>
+#include <json_stream.h>
+#include <stateful_result.h>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+/*
+ * JSON codecs generated from one declaration of the fields of a type.
+ *
+ * A type lists its fields in a static constexpr fields() function, with the JSON key,
+ * the member, the value used when the key is missing and the bit it reports as changed:
+ *
+ *   static constexpr auto fields() {
+ *       return std::make_tuple(field("enabled", &NTPSettings::enabled, true, FIELD_ENABLED),
+ *                              field("server", &NTPSettings::server, "time.google.com", FIELD_SERVER));
+ *   }
+ *
+ * The fallback may also be a function returning it, KEEP_VALUE to leave the member as
+ * it is or EMPTY_VALUE for a default constructed one. Members can be bool, numbers,
+ * String, IPAddress, types with their own fields() and vectors of all of these. Items
+ * of a vector decoded from JSON are dropped if they have a validate() returning false.
+ * IP addresses declared with optionalField() are left out of the JSON while unset.
+ */
+
+struct KeepValue {};
+struct EmptyValue {};
+
+inline constexpr KeepValue KEEP_VALUE {};
+inline constexpr EmptyValue EMPTY_VALUE {};
+
+template <typename T, typename M, typename D>
+struct FieldDescriptor {
+    const char *key;
+    M T::*member;
+    D fallback;
+    field_mask_t bit;
+    bool omitUnset;
+};
+
+template <typename T, typename M, typename D>
+constexpr FieldDescriptor<T, M, D> field(const char *key, M T::*member, D fallback, field_mask_t bit = 0) {
+    return {key, member, fallback, bit, false};
+}
+
+// A field which isn't written while it is unset, like the addresses of a network without a static IP
+template <typename T, typename M, typename D>
+constexpr FieldDescriptor<T, M, D> optionalField(const char *key, M T::*member, D fallback, field_mask_t bit = 0) {
+    return {key, member, fallback, bit, true};
+}
+
+namespace field_table {
+
+template <typename T, typename = void>
+struct HasFields : std::false_type {};
+
+template <typename T>
+struct HasFields<T, std::void_t<decltype(T::fields())>> : std::true_type {};
+
+template <typename T, typename = void>
+struct HasValidate : std::false_type {};
+
+template <typename T>
+struct HasValidate<T, std::void_t<decltype(std::declval<T &>().validate())>> : std::true_type {};
+
+template <typename T>
+struct IsVector : std::false_type {};
+
+template <typename T>
+struct IsVector<std::vector<T>> : std::true_type {};
+
+template <typename T, typename Op>
+inline void forEach(Op &&op) {
+    std::apply([&](const auto &...fields) { (op(fields), ...); }, T::fields());
+}
+
+template <typename M>
+bool equals(const M &a, const M &b);
+
+template <typename T>
+bool equalFields(const T &a, const T &b) {
+    bool equal = true;
+    forEach<T>([&](const auto &field) { equal = equal && equals(a.*field.member, b.*field.member); });
+    return equal;
+}
+
+template <typename M>
+bool equals(const M &a, const M &b) {
+    if constexpr (HasFields<M>::value) {
+        return equalFields(a, b);
+    } else if constexpr (IsVector<M>::value) {
+        if (a.size() != b.size()) return false;
+        for (size_t i = 0; i < a.size(); i++) {
+            if (!equals(a[i], b[i])) return false;
+        }
+        return true;
+    } else {
+        return a == b;
+    }
+}
+
+// JSON
+
+template <typename M>
+bool isSet(const M &value) {
+    if constexpr (std::is_same<M, IPAddress>::value) {
+        return IPUtils::isSet(value);
+    } else {
+        return true;
+    }
+}
+
+template <typename T, typename Field>
+bool isWritten(const T &object, const Field &field) {
+    return !field.omitUnset || isSet(object.*field.member);
+}
+
+template <typename T>
+void read(const T &object, JsonObject &root);
+
+// Variant is a JsonVariant or the proxy of an object member, which is only created when set
+template <typename M, typename Variant>
+void readValue(const M &value, Variant variant) {
+    if constexpr (HasFields<M>::value) {
+        JsonObject child = variant.template to<JsonObject>();
+        read(value, child);
+    } else if constexpr (IsVector<M>::value) {
+        JsonArray array = variant.template to<JsonArray>();
+        for (const auto &item : value) readValue(item, array.add<JsonVariant>());
+    } else if constexpr (std::is_same<M, IPAddress>::value) {
+        variant.set(value.toString());
+    } else {
+        variant.set(value);
+    }
+}
+
+template <typename T>
+void read(const T &object, JsonObject &root) {
+    forEach<T>([&](const auto &field) {
+        if (isWritten(object, field)) readValue(object.*field.member, root[field.key]);
+    });
+}
+
+template <typename T>
+field_mask_t update(JsonObject &root, T &object);
+
+// Decodes a present value, returns false if it is missing or has the wrong type
+template <typename M, typename Variant>
+bool decodeValue(Variant variant, M &value) {
+    if constexpr (HasFields<M>::value) {
+        if (!variant.template is<JsonObject>()) return false;
+        JsonObject child = variant.template as<JsonObject>();
+        update(child, value);
+        return true;
+    } else if constexpr (IsVector<M>::value) {
+        if (!variant.template is<JsonArray>()) return false;
+        value.clear();
+        for (JsonVariant item : variant.template as<JsonArray>()) {
+            typename M::value_type decoded {};
+            if (!decodeValue(item, decoded)) continue;
+            if constexpr (HasValidate<typename M::value_type>::value) {
+                if (!decoded.validate()) continue;
+            }
+            value.push_back(std::move(decoded));
+        }
+        return true;
+    } else if constexpr (std::is_same<M, IPAddress>::value) {
+        return variant.template is<const char *>() && value.fromString(variant.template as<const char *>());
+    } else {
+        if (!variant.template is<M>()) return false;
+        value = variant.template as<M>();
+        return true;
+    }
+}
+
+template <typename M, typename D>
+void fallbackValue(const D &fallback, M &value) {
+    if constexpr (std::is_same<D, EmptyValue>::value) {
+        value = M();
+    } else if constexpr (std::is_invocable<const D &>::value) {
+        value = fallback();
+    } else if constexpr (std::is_same<M, IPAddress>::value) {
+        if (!value.fromString(fallback)) value = INADDR_NONE;
+    } else {
+        value = fallback;
+    }
+}
+
+// Like root[key] | fallback, but for every member type. Returns the bits of the fields which changed.
+template <typename T>
+field_mask_t update(JsonObject &root, T &object) {
+    field_mask_t changed = 0;
+    forEach<T>([&](const auto &field) {
+        using M = std::decay_t<decltype(object.*field.member)>;
+        M value {};
+        if (!decodeValue(root[field.key], value)) {
+            if constexpr (std::is_same<std::decay_t<decltype(field.fallback)>, KeepValue>::value) {
+                return;
+            } else {
+                fallbackValue(field.fallback, value);
+            }
+        }
+        if (equals(object.*field.member, value)) return;
+        object.*field.member = std::move(value);
+        changed |= field.bit;
+    });
+    return changed;
+}
+
+template <typename T>
+void stream(const T &object, JsonStreamWriter &json);
+
+// Number of fields stream writes, unset optional ones are left out
+template <typename T>
+size_t streamSize(const T &object) {
+    size_t size = 0;
+    forEach<T>([&](const auto &field) { size += isWritten(object, field); });
+    return size;
+}
+
+template <typename M>
+void streamValue(const M &value, JsonStreamWriter &json) {
+    if constexpr (HasFields<M>::value) {
+        json.beginObject(streamSize(value));
+        stream(value, json);
+        json.endObject();
+    } else if constexpr (IsVector<M>::value) {
+        json.beginArray(value.size());
+        for (const auto &item : value) streamValue(item, json);
+        json.endArray();
+    } else if constexpr (std::is_same<M, String>::value) {
+        json.value(value.c_str());
+    } else if constexpr (std::is_same<M, IPAddress>::value) {
+        json.value(value.toString().c_str());
+    } else if constexpr (std::is_same<M, bool>::value || std::is_floating_point<M>::value) {
+        json.value(value);
+    } else if constexpr (std::is_signed<M>::value) {
+        json.value((long)value);
+    } else {
+        json.value((unsigned long)value);
+    }
+}
+
+// Writes the fields into an object opened by the caller with streamSize(object) items
+template <typename T>
+void stream(const T &object, JsonStreamWriter &json) {
+    forEach<T>([&](const auto &field) {
+        if (isWritten(object, field)) streamValue(object.*field.member, json.name(field.key));
+    });
+}
+
+} // namespace field_table
@@ -35,6 +35,12 @@
     ARDUINO_VERSION_STR(ESP_ARDUINO_VERSION_MAJOR, ESP_ARDUINO_VERSION_MINOR, ESP_ARDUINO_VERSION_PATCH)
 #endif
 
+// Changes on every boot, so anything counted from 0 again after a restart can be told apart
+inline uint32_t bootNonce() {
+    static const uint32_t nonce = esp_random();
+    return nonce;
+}
+
 /*
  * I2C software connection
  */
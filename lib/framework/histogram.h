@@ -0,0 +1,53 @@
+#pragma once
+
+#include <ArduinoJson.h>
+
+/*
+ * Fixed size histogram with power of two buckets.
+ *
+ * Bucket 0 holds the value 0, bucket i holds values in [2^(i-1), 2^i) and the last
+ * bucket everything above. Recording is a count-leading-zeros and an increment, so
+ * it is cheap enough to keep on in production builds. Not thread safe, callers
+ * record under their own lock.
+ */
+template <size_t N = 16>
+class Log2Histogram {
+  public:
+    void record(uint32_t value) {
+        size_t bucket = value ? 32 - __builtin_clz(value) : 0;
+        _buckets[bucket < N ? bucket : N - 1]++;
+        _count++;
+        if (value > _max) _max = value;
+    }
+
+    uint32_t count() const { return _count; }
+
+    uint32_t max() const { return _max; }
+
+    // Upper bound of the bucket holding the given percentile (0-100)
+    uint32_t percentile(uint8_t p) const {
+        if (!_count) return 0;
+        uint32_t rank = ((uint64_t)_count * p + 99) / 100;
+        uint32_t seen = 0;
+        for (size_t i = 0; i < N; i++) {
+            seen += _buckets[i];
+            if (seen >= rank) return i == N - 1 ? _max : (1UL << i) - 1;
+        }
+        return _max;
+    }
+
+    void serialize(JsonObject &root, bool withBuckets = true) const {
+        root["count"] = _count;
+        root["p50"] = percentile(50);
+        root["p99"] = percentile(99);
+        root["max"] = _max;
+        if (!withBuckets) return;
+        JsonArray buckets = root["buckets"].to<JsonArray>();
+        for (size_t i = 0; i < N; i++) buckets.add(_buckets[i]);
+    }
+
+  private:
+    uint32_t _buckets[N] {};
+    uint32_t _count {0};
+    uint32_t _max {0};
+};
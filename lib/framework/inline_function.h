@@ -0,0 +1,92 @@
+#pragma once
+
+#include <stddef.h>
+#include <string.h>
+#include <type_traits>
+#include <utility>
+
+/*
+ * std::function without the heap: the callable is stored inside the object.
+ *
+ * Only trivially copyable callables of at most Size bytes are accepted, e.g. function
+ * pointers and lambdas capturing a few pointers or numbers. Anything larger fails to
+ * compile, capture a pointer to it instead.
+ */
+template <typename Signature, size_t Size = 2 * sizeof(void *)>
+class InlineFunction;
+
+template <typename R, typename... Args, size_t Size>
+class InlineFunction<R(Args...), Size> {
+  public:
+    InlineFunction() = default;
+    InlineFunction(std::nullptr_t) {}
+
+    template <typename F, typename Callable = std::decay_t<F>,
+              typename = std::enable_if_t<!std::is_same<Callable, InlineFunction>::value &&
+                                          std::is_invocable_r<R, Callable &, Args...>::value>>
+    InlineFunction(F &&callable) {
+        static_assert(sizeof(Callable) <= Size, "callable too large for InlineFunction, capture a pointer instead");
+        static_assert(alignof(Callable) <= alignof(void *), "callable alignment not supported by InlineFunction");
+        static_assert(std::is_trivially_copyable<Callable>::value,
+                      "InlineFunction only stores trivially copyable callables");
+        Callable copy(std::forward<F>(callable));
+        if constexpr (std::is_pointer<Callable>::value) {
+            if (!copy) return;
+        }
+        memcpy(_storage, &copy, sizeof(Callable));
+        _invoke = [](void *storage, Args... args) -> R {
+            return (*reinterpret_cast<Callable *>(storage))(std::forward<Args>(args)...);
+        };
+    }
+
+    R operator()(Args... args) const { return _invoke(_storage, std::forward<Args>(args)...); }
+
+    explicit operator bool() const { return _invoke != nullptr; }
+
+  private:
+    alignas(void *) mutable unsigned char _storage[Size] {};
+    R (*_invoke)(void *storage, Args... args) {nullptr};
+};
+
+/*
+ * Fixed capacity list of callbacks in the order they were added, each with an id
+ * to remove it by. Adding to a full table fails and returns 0.
+ */
+template <typename Signature, size_t N>
+class CallbackTable {
+  public:
+    typedef InlineFunction<Signature> Callback;
+
+    size_t add(Callback callback, bool allowRemove = true) {
+        if (!callback || _count == N) return 0;
+        _entries[_count++] = {++_lastId, allowRemove, callback};
+        return _lastId;
+    }
+
+    void remove(size_t id) {
+        for (size_t i = 0; i < _count; i++) {
+            if (_entries[i].id != id || !_entries[i].allowRemove) continue;
+            for (size_t j = i + 1; j < _count; j++) _entries[j - 1] = _entries[j];
+            _count--;
+            return;
+        }
+    }
+
+    template <typename... Args>
+    void call(Args &&...args) const {
+        for (size_t i = 0; i < _count; i++) _entries[i].callback(args...);
+    }
+
+    size_t size() const { return _count; }
+
+  private:
+    struct Entry {
+        size_t id;
+        bool allowRemove;
+        Callback callback;
+    };
+
+    Entry _entries[N] {};
+    size_t _count {0};
+    size_t _lastId {0};
+};
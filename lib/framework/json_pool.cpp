@@ -0,0 +1,232 @@
+#include <json_pool.h>
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace json_pool {
+
+// Precedes every block, the size is needed to count the bytes freed and to find the top of an arena
+struct alignas(8) Header {
+    uint32_t size;
+};
+
+struct Arena {
+    alignas(8) uint8_t memory[JSON_POOL_ARENA_SIZE];
+    TaskHandle_t owner;
+    size_t used;
+    size_t peak;
+    uint32_t live; // blocks not freed yet
+};
+
+struct SiteStats {
+    uint32_t current;
+    uint32_t peak;
+    uint64_t total;
+    uint32_t allocations;
+    uint32_t heap; // allocations which didn't fit into an arena
+};
+
+class SiteAllocator : public ArduinoJson::Allocator {
+  public:
+    constexpr SiteAllocator(Site site) : _site(site) {}
+
+    void *allocate(size_t size) override;
+    void deallocate(void *pointer) override;
+    void *reallocate(void *pointer, size_t size) override;
+
+  private:
+    Site _site;
+};
+
+static const char *const siteNames[SITE_COUNT] = {"http", "event", "socket", "mqtt", "persistence", "batch"};
+
+static portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
+static Arena arenas[JSON_POOL_ARENAS ? JSON_POOL_ARENAS : 1];
+static SiteStats stats[SITE_COUNT];
+static SiteAllocator allocators[SITE_COUNT] = {SITE_HTTP, SITE_EVENT,       SITE_SOCKET,
+                                               SITE_MQTT, SITE_PERSISTENCE, SITE_BATCH};
+
+static inline size_t blockSize(size_t size) { return (sizeof(Header) + size + 7) & ~(size_t)7; }
+
+static inline bool isTop(const Arena &arena, const Header *header) {
+    return (const uint8_t *)header + blockSize(header->size) == arena.memory + arena.used;
+}
+
+// All arena functions run under the mux
+
+static Arena *findArena(const Header *header) {
+    for (size_t i = 0; i < JSON_POOL_ARENAS; i++) {
+        const uint8_t *block = (const uint8_t *)header;
+        if (block >= arenas[i].memory && block < arenas[i].memory + JSON_POOL_ARENA_SIZE) return &arenas[i];
+    }
+    return nullptr;
+}
+
+// Bumps the arena of the calling task or lends it a free one, nullptr if the block doesn't fit
+static Header *arenaAllocate(size_t size) {
+    TaskHandle_t task = xTaskGetCurrentTaskHandle();
+    if (!task) return nullptr; // global constructors run before the scheduler
+    Arena *arena = nullptr;
+    for (size_t i = 0; i < JSON_POOL_ARENAS; i++) {
+        if (arenas[i].owner == task) {
+            arena = &arenas[i];
+            break;
+        }
+        if (!arena && !arenas[i].owner) arena = &arenas[i];
+    }
+    if (!arena || arena->used + blockSize(size) > JSON_POOL_ARENA_SIZE) return nullptr;
+    arena->owner = task;
+    Header *header = (Header *)(arena->memory + arena->used);
+    header->size = size;
+    arena->used += blockSize(size);
+    arena->live++;
+    if (arena->used > arena->peak) arena->peak = arena->used;
+    return header;
+}
+
+// Only the top block can grow, any block can shrink in place
+static bool arenaResize(Arena &arena, Header *header, size_t size) {
+    if (isTop(arena, header)) {
+        size_t end = (uint8_t *)header - arena.memory + blockSize(size);
+        if (end > JSON_POOL_ARENA_SIZE) return false;
+        arena.used = end;
+        if (arena.used > arena.peak) arena.peak = arena.used;
+    } else if (size > header->size) {
+        return false;
+    }
+    header->size = size;
+    return true;
+}
+
+// The top block is given back right away, the rest once the arena is empty, which also returns it to the pool
+static void arenaFree(Arena &arena, Header *header) {
+    if (isTop(arena, header)) arena.used = (uint8_t *)header - arena.memory;
+    if (--arena.live) return;
+    arena.used = 0;
+    arena.owner = nullptr;
+}
+
+static void countAllocation(SiteStats &site, size_t size, bool heap) {
+    site.current += size;
+    site.total += size;
+    site.allocations++;
+    if (heap) site.heap++;
+    if (site.current > site.peak) site.peak = site.current;
+}
+
+static void countResize(SiteStats &site, size_t from, size_t to) {
+    site.current += to - from;
+    if (to > from) site.total += to - from;
+    if (site.current > site.peak) site.peak = site.current;
+}
+
+void *SiteAllocator::allocate(size_t size) {
+    portENTER_CRITICAL(&mux);
+    Header *header = arenaAllocate(size);
+    if (header) countAllocation(stats[_site], size, false);
+    portEXIT_CRITICAL(&mux);
+    if (header) return header + 1;
+
+    header = (Header *)malloc(sizeof(Header) + size);
+    if (!header) return nullptr;
+    header->size = size;
+    portENTER_CRITICAL(&mux);
+    countAllocation(stats[_site], size, true);
+    portEXIT_CRITICAL(&mux);
+    return header + 1;
+}
+
+void SiteAllocator::deallocate(void *pointer) {
+    if (!pointer) return;
+    Header *header = (Header *)pointer - 1;
+    portENTER_CRITICAL(&mux);
+    stats[_site].current -= header->size;
+    Arena *arena = findArena(header);
+    if (arena) arenaFree(*arena, header);
+    portEXIT_CRITICAL(&mux);
+    if (!arena) free(header);
+}
+
+void *SiteAllocator::reallocate(void *pointer, size_t size) {
+    if (!pointer) return allocate(size);
+    Header *header = (Header *)pointer - 1;
+    size_t oldSize = header->size;
+
+    portENTER_CRITICAL(&mux);
+    Arena *arena = findArena(header);
+    bool resized = arena && arenaResize(*arena, header, size);
+    if (resized) countResize(stats[_site], oldSize, size);
+    portEXIT_CRITICAL(&mux);
+    if (resized) return pointer;
+
+    if (!arena) {
+        Header *moved = (Header *)realloc(header, sizeof(Header) + size);
+        if (!moved) return nullptr;
+        moved->size = size;
+        portENTER_CRITICAL(&mux);
+        countResize(stats[_site], oldSize, size);
+        portEXIT_CRITICAL(&mux);
+        return moved + 1;
+    }
+
+    // an arena block which can't grow in place moves, to the heap if the arena is full
+    void *copy = allocate(size);
+    if (!copy) return nullptr;
+    memcpy(copy, pointer, oldSize < size ? oldSize : size);
+    deallocate(pointer);
+    return copy;
+}
+
+ArduinoJson::Allocator *allocator(Site site) { return &allocators[site]; }
+
+Serialized::Serialized(JsonVariantConst json, Site site) : _allocator(allocator(site)), _length(measureJson(json)) {
+    _data = (char *)_allocator->allocate(_length + 1);
+    if (_data) {
+        serializeJson(json, _data, _length + 1);
+    } else {
+        _length = 0;
+    }
+}
+
+Serialized::~Serialized() {
+    if (_data) _allocator->deallocate(_data);
+}
+
+void metrics(JsonObject &root) {
+    // copied first, the json document may allocate which isn't allowed in a critical section
+    struct ArenaCopy {
+        size_t used;
+        size_t peak;
+        bool lent;
+    } arenaCopies[JSON_POOL_ARENAS ? JSON_POOL_ARENAS : 1];
+    SiteStats statsCopy[SITE_COUNT];
+    portENTER_CRITICAL(&mux);
+    for (size_t i = 0; i < JSON_POOL_ARENAS; i++) {
+        arenaCopies[i] = {arenas[i].used, arenas[i].peak, arenas[i].owner != nullptr};
+    }
+    memcpy(statsCopy, stats, sizeof(stats));
+    portEXIT_CRITICAL(&mux);
+
+    root["arena_size"] = JSON_POOL_ARENA_SIZE;
+    JsonArray arenaArray = root["arenas"].to<JsonArray>();
+    for (size_t i = 0; i < JSON_POOL_ARENAS; i++) {
+        JsonObject arena = arenaArray.add<JsonObject>();
+        arena["used"] = arenaCopies[i].used;
+        arena["peak"] = arenaCopies[i].peak;
+        arena["lent"] = arenaCopies[i].lent;
+    }
+    JsonObject sites = root["sites"].to<JsonObject>();
+    for (size_t i = 0; i < SITE_COUNT; i++) {
+        JsonObject site = sites[siteNames[i]].to<JsonObject>();
+        site["current"] = statsCopy[i].current;
+        site["peak"] = statsCopy[i].peak;
+        site["total"] = statsCopy[i].total;
+        site["allocations"] = statsCopy[i].allocations;
+        site["heap"] = statsCopy[i].heap;
+    }
+}
+
+} // namespace json_pool
@@ -0,0 +1,74 @@
+#ifndef JsonPool_h
+#define JsonPool_h
+
+#include <ArduinoJson.h>
+
+// Arenas lent to tasks building documents, 0 sends every allocation to the heap but keeps the statistics
+#ifndef JSON_POOL_ARENAS
+#define JSON_POOL_ARENAS 4
+#endif
+
+#ifndef JSON_POOL_ARENA_SIZE
+#define JSON_POOL_ARENA_SIZE 4096
+#endif
+
+/*
+ * Allocator for the short lived JsonDocuments of the request, event and persistence
+ * paths, instead of each one growing and freeing its own heap blocks:
+ *
+ *   JsonDocument doc(json_pool::allocator(json_pool::SITE_MQTT));
+ *
+ * The arenas are static memory. A task gets one with its first allocation and keeps
+ * it until all of its blocks are freed, allocating is bumping a pointer. Blocks which
+ * don't fit, or allocations while every arena is in use, go to the heap. A document
+ * must be freed on the task which created it while it holds blocks in an arena, which
+ * holds for documents on the stack.
+ *
+ * Bytes in use, peak, total and heap fallbacks are counted per call site.
+ */
+namespace json_pool {
+
+enum Site : uint8_t {
+    SITE_HTTP,        // HttpEndpoint request bodies and replies
+    SITE_EVENT,       // EventEndpoint state syncs
+    SITE_SOCKET,      // EventSocket incoming events
+    SITE_MQTT,        // MqttEndpoint publishes and received messages
+    SITE_PERSISTENCE, // FSPersistence reads and writes
+    SITE_BATCH,       // batch readers without a stream reader
+    SITE_COUNT,
+};
+
+ArduinoJson::Allocator *allocator(Site site);
+
+/*
+ * A document serialized into a block of the same allocator, for handing the text to
+ * something which copies it. Declared after the document it stays on top of the
+ * arena, so it is given back as soon as it goes out of scope:
+ *
+ *   json_pool::Serialized payload(doc, json_pool::SITE_MQTT);
+ *   publish(topic, payload.c_str(), payload.length());
+ */
+class Serialized {
+  public:
+    Serialized(JsonVariantConst json, Site site);
+    ~Serialized();
+
+    Serialized(const Serialized &) = delete;
+    Serialized &operator=(const Serialized &) = delete;
+
+    // Empty if not even the heap had room
+    const char *c_str() const { return _data ? _data : ""; }
+    size_t length() const { return _length; }
+
+  private:
+    ArduinoJson::Allocator *_allocator;
+    char *_data;
+    size_t _length;
+};
+
+// Arena use and the allocation statistics per call site
+void metrics(JsonObject &root);
+
+} // namespace json_pool
+
+#endif
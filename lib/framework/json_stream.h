@@ -0,0 +1,263 @@
+#pragma once
+
+#include <ArduinoJson.h>
+#include <Print.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <type_traits>
+
+enum class StreamFormat : uint8_t { JSON, MSGPACK };
+
+/*
+ * Writes JSON straight to a Print without building a JsonDocument first.
+ *
+ * Commas are inserted automatically. Inside an object every call takes a key,
+ * inside an array the key is left out:
+ *
+ *   json.beginObject();
+ *   json.value("steps", 12);
+ *   json.beginArray("times");
+ *   json.value(0.42f);
+ *   json.endArray();
+ *   json.endObject();
+ *
+ * The same calls can write MessagePack instead. MessagePack needs the number of
+ * items before every object and array, so for it every container has to be opened
+ * with its size, e.g. json.beginArray("times", times.size()). JSON ignores the size.
+ *
+ * Nesting is tracked in a bit mask, so at most 32 levels are supported.
+ *
+ * A writer which finds the state changed under it halfway can't take back what it
+ * sent, it calls abort() instead. Nothing is written afterwards and the response
+ * must be dropped rather than ended, so the client sees a broken body and retries.
+ */
+class JsonStreamWriter {
+  public:
+    JsonStreamWriter(Print &out, StreamFormat format = StreamFormat::JSON) : _out(out), _format(format) {}
+
+    // size is the number of items, which MessagePack writes first
+    void beginObject(size_t size) { open(nullptr, '{', size); }
+    void beginObject(const char *key, size_t size) { open(key, '{', size); }
+    void endObject() { close('}'); }
+    void beginArray(size_t size) { open(nullptr, '[', size); }
+    void beginArray(const char *key, size_t size) { open(key, '[', size); }
+    void endArray() { close(']'); }
+
+    // Containers of yet unknown size, JSON only
+    void beginObject(const char *key = nullptr) { open(key, '{', 0); }
+    void beginArray(const char *key = nullptr) { open(key, '[', 0); }
+
+    void value(const char *key, const char *value) {
+        this->key(key);
+        string(value);
+    }
+    void value(const char *key, bool value) {
+        this->key(key);
+        if (_format == StreamFormat::MSGPACK) return put(value ? 0xc3 : 0xc2);
+        value ? write("true", 4) : write("false", 5);
+    }
+    void value(const char *key, int value) { integer(key, value); }
+    void value(const char *key, long value) { integer(key, value); }
+    void value(const char *key, unsigned int value) { integer(key, value); }
+    void value(const char *key, unsigned long value) { integer(key, value); }
+    void value(const char *key, float value) { number(key, value, true); }
+    void value(const char *key, double value) { number(key, value, false); }
+
+    template <typename V>
+    void value(V value) {
+        this->value(nullptr, value);
+    }
+
+    // Key of the next value, for writers which only know how to write a value, e.g. json.name("steps").beginObject()
+    JsonStreamWriter &name(const char *key) {
+        _name = key;
+        return *this;
+    }
+
+    // Writes a value built with ArduinoJson, in the format of the writer
+    void variant(const char *key, JsonVariantConst value) {
+        this->key(key);
+        if (_aborted) return;
+        _written += _format == StreamFormat::MSGPACK ? serializeMsgPack(value, _out) : serializeJson(value, _out);
+    }
+    void variant(JsonVariantConst value) { variant(nullptr, value); }
+
+    size_t bytesWritten() const { return _written; }
+
+    void abort() { _aborted = true; }
+    bool aborted() const { return _aborted; }
+
+  private:
+    Print &_out;
+    StreamFormat _format;
+    uint32_t _hasItems {0}; // bit per nesting level, set once the container has an item
+    uint8_t _depth {0};
+    size_t _written {0};
+    const char *_name {nullptr};
+    bool _aborted {false};
+
+    void key(const char *key) {
+        if (!key) key = _name;
+        _name = nullptr;
+        if (_format == StreamFormat::MSGPACK) {
+            if (key) string(key);
+            return;
+        }
+        if (_depth && (_hasItems & (1UL << _depth))) write(",", 1);
+        _hasItems |= 1UL << _depth;
+        if (!key) return;
+        string(key);
+        write(":", 1);
+    }
+
+    void open(const char *key, char bracket, size_t size) {
+        this->key(key);
+        if (_format == StreamFormat::MSGPACK) {
+            bracket == '{' ? header(size, 0x80, 0xde) : header(size, 0x90, 0xdc);
+            _depth++;
+            return;
+        }
+        write(&bracket, 1);
+        _depth++;
+        _hasItems &= ~(1UL << _depth);
+    }
+
+    void close(char bracket) {
+        if (_format == StreamFormat::JSON) write(&bracket, 1);
+        _depth--;
+    }
+
+    template <typename I>
+    void integer(const char *key, I value) {
+        this->key(key);
+        if (_format == StreamFormat::MSGPACK) {
+            if constexpr (std::is_signed<I>::value) {
+                if (value < 0) return negative(value);
+            }
+            return positive(value);
+        }
+        if (!_aborted) _written += _out.print(value);
+    }
+
+    void number(const char *key, double value, bool single) {
+        this->key(key);
+        if (_format == StreamFormat::MSGPACK) {
+            if (single) {
+                float f = value;
+                uint32_t bits;
+                memcpy(&bits, &f, 4);
+                put(0xca);
+                return bigEndian(bits, 4);
+            }
+            uint64_t bits;
+            memcpy(&bits, &value, 8);
+            put(0xcb);
+            return bigEndian(bits, 8);
+        }
+        if (isnan(value) || isinf(value)) {
+            write("null", 4);
+            return;
+        }
+        // the shortest text which reads back as the same value, at most 9 digits for a float and 17 for a double
+        char buffer[32];
+        int len = 0;
+        for (int digits = single ? 6 : 15; digits <= (single ? 9 : 17); digits++) {
+            len = snprintf(buffer, sizeof(buffer), "%.*g", digits, value);
+            if (single ? strtof(buffer, nullptr) == (float)value : strtod(buffer, nullptr) == value) break;
+        }
+        write(buffer, len);
+    }
+
+    void string(const char *value) {
+        if (_format == StreamFormat::MSGPACK) {
+            size_t len = strlen(value);
+            if (len < 32) {
+                put(0xa0 | len);
+            } else if (len <= 0xff) {
+                put(0xd9);
+                bigEndian(len, 1);
+            } else if (len <= 0xffff) {
+                put(0xda);
+                bigEndian(len, 2);
+            } else {
+                put(0xdb);
+                bigEndian(len, 4);
+            }
+            return write(value, len);
+        }
+        write("\"", 1);
+        const char *start = value;
+        for (const char *c = value; *c; c++) {
+            if (*c != '"' && *c != '\\' && (uint8_t)*c >= 0x20) continue;
+            write(start, c - start);
+            char escaped[7];
+            int len = *c == '"' || *c == '\\' ? snprintf(escaped, sizeof(escaped), "\\%c", *c)
+                                               : snprintf(escaped, sizeof(escaped), "\\u%04x", *c);
+            write(escaped, len);
+            start = c + 1;
+        }
+        write(start, strlen(start));
+        write("\"", 1);
+    }
+
+    // MessagePack map or array header, fix is the marker of the short form, wide the one with a 16 bit size
+    void header(uint32_t size, uint8_t fix, uint8_t wide) {
+        if (size < 16) return put(fix | size);
+        if (size <= 0xffff) {
+            put(wide);
+            return bigEndian(size, 2);
+        }
+        put(wide + 1);
+        bigEndian(size, 4);
+    }
+
+    void positive(unsigned long long value) {
+        if (value < 0x80) return put(value);
+        if (value <= 0xff) {
+            put(0xcc);
+            return bigEndian(value, 1);
+        }
+        if (value <= 0xffff) {
+            put(0xcd);
+            return bigEndian(value, 2);
+        }
+        if (value <= 0xffffffff) {
+            put(0xce);
+            return bigEndian(value, 4);
+        }
+        put(0xcf);
+        bigEndian(value, 8);
+    }
+
+    void negative(long long value) {
+        if (value >= -32) return put((uint8_t)value);
+        if (value >= INT8_MIN) {
+            put(0xd0);
+            return bigEndian(value, 1);
+        }
+        if (value >= INT16_MIN) {
+            put(0xd1);
+            return bigEndian(value, 2);
+        }
+        if (value >= INT32_MIN) {
+            put(0xd2);
+            return bigEndian(value, 4);
+        }
+        put(0xd3);
+        bigEndian(value, 8);
+    }
+
+    void bigEndian(uint64_t value, size_t len) {
+        uint8_t buffer[8];
+        for (size_t i = 0; i < len; i++) buffer[i] = value >> (8 * (len - 1 - i));
+        write((const char *)buffer, len);
+    }
+
+    void put(uint8_t value) { write((const char *)&value, 1); }
+
+    void write(const char *data, size_t len) {
+        if (_aborted) return;
+        _written += _out.write((const uint8_t *)data, len);
+    }
+};
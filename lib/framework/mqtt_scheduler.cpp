@@ -0,0 +1,263 @@
+#include <mqtt_scheduler.h>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#include <histogram.h>
+#include <mqtt_spool.h>
+
+namespace mqtt_scheduler {
+
+static const char *TAG = "MqttScheduler";
+
+struct Class {
+    uint32_t rate;  // tokens per second
+    uint32_t burst; // tokens
+    bool coalesce;
+    const char *name;
+};
+
+static const Class classes[PRIORITY_COUNT] = {
+    {MQTT_SCHEDULER_TELEMETRY_RATE, MQTT_SCHEDULER_TELEMETRY_BURST, false, "telemetry"},
+    {MQTT_SCHEDULER_STATE_RATE, MQTT_SCHEDULER_STATE_BURST, true, "state"},
+    {MQTT_SCHEDULER_DIAGNOSTICS_RATE, MQTT_SCHEDULER_DIAGNOSTICS_BURST, true, "diagnostics"},
+};
+
+struct Slot {
+    char *data {nullptr}; // topic, '\0' and the payload
+    size_t capacity {0};
+    size_t topicLen {0};
+    size_t payloadLen {0};
+    uint8_t qos {0};
+    bool retain {false};
+    uint32_t queuedAt {0}; // micros() of the first message, coalescing keeps it
+    Slot *next {nullptr};
+};
+
+struct Queue {
+    Slot *head {nullptr};
+    Slot *tail {nullptr};
+    uint32_t tokens {0}; // in 1/1000 of a message
+    size_t depth {0};
+    uint32_t published {0};
+    uint32_t coalesced {0};
+    uint32_t dropped {0};
+    uint32_t failed {0};      // refused by the client
+    Log2Histogram<24> latency; // us from queued to handed to the client
+};
+
+static SemaphoreHandle_t mutex = xSemaphoreCreateMutex();
+static TaskHandle_t task = nullptr;
+static PsychicMqttClient *mqttClient = nullptr;
+
+static Slot slots[MQTT_SCHEDULER_SLOTS];
+static Slot *freeSlots = nullptr;
+static Queue queues[PRIORITY_COUNT];
+static uint32_t refilledAt = 0; // millis()
+
+static void push(Queue &queue, Slot *slot) {
+    slot->next = nullptr;
+    if (queue.tail) {
+        queue.tail->next = slot;
+    } else {
+        queue.head = slot;
+    }
+    queue.tail = slot;
+    queue.depth++;
+}
+
+static Slot *pop(Queue &queue) {
+    Slot *slot = queue.head;
+    queue.head = slot->next;
+    if (!queue.head) queue.tail = nullptr;
+    queue.depth--;
+    return slot;
+}
+
+static void release(Slot *slot) {
+    if (slot->capacity > MQTT_SCHEDULER_SLOT_KEEP) {
+        free(slot->data);
+        slot->data = nullptr;
+        slot->capacity = 0;
+    }
+    slot->next = freeSlots;
+    freeSlots = slot;
+}
+
+static bool store(Slot *slot, const char *topic, size_t topicLen, const char *payload, size_t len) {
+    size_t size = topicLen + 1 + len;
+    if (size > slot->capacity) {
+        char *data = (char *)realloc(slot->data, size);
+        if (!data) return false;
+        slot->data = data;
+        slot->capacity = size;
+    }
+    memcpy(slot->data, topic, topicLen + 1);
+    memcpy(slot->data + topicLen + 1, payload, len);
+    slot->topicLen = topicLen;
+    slot->payloadLen = len;
+    return true;
+}
+
+static void wake() {
+    if (task) xTaskNotifyGive(task);
+}
+
+// Under the mutex, tops up the buckets by the time since the last call
+static void refill() {
+    uint32_t now = millis();
+    uint32_t elapsed = now - refilledAt;
+    refilledAt = now;
+    for (size_t i = 0; i < PRIORITY_COUNT; i++) {
+        uint32_t tokens = queues[i].tokens + elapsed * classes[i].rate;
+        uint32_t burst = classes[i].burst * 1000;
+        queues[i].tokens = tokens < burst && tokens >= queues[i].tokens ? tokens : burst;
+    }
+}
+
+// Sends what the buckets allow, returns the ticks until the next message may go
+static TickType_t dispatch() {
+    for (;;) {
+        xSemaphoreTake(mutex, portMAX_DELAY);
+        refill();
+        bool connected = mqttClient->connected();
+        TickType_t wait = portMAX_DELAY;
+        size_t priority = PRIORITY_COUNT;
+        for (size_t i = 0; i < PRIORITY_COUNT && priority == PRIORITY_COUNT; i++) {
+            Queue &queue = queues[i];
+            // the others are sent again by their publishers once connected
+            if (!queue.head || (!connected && i != PRIORITY_TELEMETRY)) continue;
+            if (queue.tokens >= 1000) {
+                priority = i;
+            } else {
+                uint32_t ms = (1000 - queue.tokens + classes[i].rate - 1) / classes[i].rate;
+                TickType_t ticks = pdMS_TO_TICKS(ms) ? pdMS_TO_TICKS(ms) : 1;
+                if (ticks < wait) wait = ticks;
+            }
+        }
+        if (priority == PRIORITY_COUNT) {
+            xSemaphoreGive(mutex);
+            return wait;
+        }
+        Queue &queue = queues[priority];
+        queue.tokens -= 1000;
+        Slot *slot = pop(queue);
+        xSemaphoreGive(mutex);
+
+        // the slot is neither queued nor free, so it is published without holding the mutex
+        const char *topic = slot->data;
+        const char *payload = slot->data + slot->topicLen + 1;
+        bool sent = priority == PRIORITY_TELEMETRY
+                        ? mqtt_spool::publish(topic, slot->qos, slot->retain, payload, slot->payloadLen)
+                        : mqttClient->publish(topic, slot->qos, slot->retain, payload, slot->payloadLen) >= 0;
+        uint32_t latency = micros() - slot->queuedAt;
+        if (!sent) ESP_LOGW(TAG, "Failed to publish %u bytes to %s", slot->payloadLen, topic);
+
+        xSemaphoreTake(mutex, portMAX_DELAY);
+        if (sent) {
+            queue.published++;
+            queue.latency.record(latency);
+        } else {
+            queue.failed++;
+        }
+        release(slot);
+        xSemaphoreGive(mutex);
+    }
+}
+
+static void worker(void *) {
+    for (;;) {
+        TickType_t wait = dispatch();
+        ulTaskNotifyTake(pdTRUE, wait);
+    }
+}
+
+void begin(PsychicMqttClient *client) {
+    mqttClient = client;
+    xSemaphoreTake(mutex, portMAX_DELAY);
+    for (size_t i = 0; i < MQTT_SCHEDULER_SLOTS; i++) release(&slots[i]);
+    for (size_t i = 0; i < PRIORITY_COUNT; i++) queues[i].tokens = classes[i].burst * 1000;
+    refilledAt = millis();
+    xSemaphoreGive(mutex);
+    mqttClient->onConnect([](bool sessionPresent) { wake(); });
+    xTaskCreatePinnedToCore(worker, "MQTT Scheduler", MQTT_SCHEDULER_STACK_SIZE, nullptr, (tskIDLE_PRIORITY + 1),
+                            &task, 0);
+}
+
+bool publish(Priority priority, const char *topic, int qos, bool retain, const char *payload, size_t len) {
+    if (priority >= PRIORITY_COUNT) return false;
+    size_t topicLen = strlen(topic);
+    Queue &queue = queues[priority];
+
+    xSemaphoreTake(mutex, portMAX_DELAY);
+    Slot *slot = nullptr;
+    if (classes[priority].coalesce) {
+        for (Slot *queued = queue.head; queued; queued = queued->next) {
+            if (queued->topicLen == topicLen && !memcmp(queued->data, topic, topicLen)) {
+                slot = queued;
+                break;
+            }
+        }
+    }
+    if (slot) {
+        bool stored = store(slot, topic, topicLen, payload, len);
+        if (stored) {
+            slot->qos = qos;
+            slot->retain = retain;
+            queue.coalesced++;
+        } else {
+            queue.dropped++;
+        }
+        xSemaphoreGive(mutex);
+        return stored;
+    }
+
+    slot = freeSlots;
+    if (slot) {
+        freeSlots = slot->next;
+    } else {
+        // push out the oldest message of the lowest class below this one
+        for (size_t i = PRIORITY_COUNT - 1; i > (size_t)priority && !slot; i--) {
+            if (!queues[i].head) continue;
+            slot = pop(queues[i]);
+            queues[i].dropped++;
+        }
+    }
+    if (!slot || !store(slot, topic, topicLen, payload, len)) {
+        if (slot) release(slot);
+        queue.dropped++;
+        xSemaphoreGive(mutex);
+        ESP_LOGW(TAG, "Dropped %u bytes to %s", len, topic);
+        return false;
+    }
+    slot->qos = qos;
+    slot->retain = retain;
+    slot->queuedAt = micros();
+    push(queue, slot);
+    xSemaphoreGive(mutex);
+    wake();
+    return true;
+}
+
+void metrics(JsonObject &root) {
+    Queue copies[PRIORITY_COUNT];
+    xSemaphoreTake(mutex, portMAX_DELAY);
+    for (size_t i = 0; i < PRIORITY_COUNT; i++) {
+        copies[i] = queues[i];
+    }
+    xSemaphoreGive(mutex);
+
+    for (size_t i = 0; i < PRIORITY_COUNT; i++) {
+        JsonObject queue = root[classes[i].name].to<JsonObject>();
+        queue["queued"] = copies[i].depth;
+        queue["published"] = copies[i].published;
+        queue["coalesced"] = copies[i].coalesced;
+        queue["dropped"] = copies[i].dropped;
+        queue["failed"] = copies[i].failed;
+        queue["tokens"] = copies[i].tokens / 1000;
+        JsonObject latency = queue["latency"].to<JsonObject>();
+        copies[i].latency.serialize(latency, false);
+    }
+}
+
+} // namespace mqtt_scheduler
@@ -0,0 +1,78 @@
+#ifndef MqttScheduler_h
+#define MqttScheduler_h
+
+#include <ArduinoJson.h>
+#include <PsychicMqttClient.h>
+
+// Messages waiting to be published, of all classes together
+#ifndef MQTT_SCHEDULER_SLOTS
+#define MQTT_SCHEDULER_SLOTS 16
+#endif
+
+// Slots keep their buffer for the next message unless it grew larger than this
+#ifndef MQTT_SCHEDULER_SLOT_KEEP
+#define MQTT_SCHEDULER_SLOT_KEEP 512
+#endif
+
+#ifndef MQTT_SCHEDULER_STACK_SIZE
+#define MQTT_SCHEDULER_STACK_SIZE 4096
+#endif
+
+// Messages per second and burst of each class
+#ifndef MQTT_SCHEDULER_TELEMETRY_RATE
+#define MQTT_SCHEDULER_TELEMETRY_RATE 10
+#endif
+
+#ifndef MQTT_SCHEDULER_TELEMETRY_BURST
+#define MQTT_SCHEDULER_TELEMETRY_BURST 10
+#endif
+
+#ifndef MQTT_SCHEDULER_STATE_RATE
+#define MQTT_SCHEDULER_STATE_RATE 5
+#endif
+
+#ifndef MQTT_SCHEDULER_STATE_BURST
+#define MQTT_SCHEDULER_STATE_BURST 5
+#endif
+
+#ifndef MQTT_SCHEDULER_DIAGNOSTICS_RATE
+#define MQTT_SCHEDULER_DIAGNOSTICS_RATE 1
+#endif
+
+#ifndef MQTT_SCHEDULER_DIAGNOSTICS_BURST
+#define MQTT_SCHEDULER_DIAGNOSTICS_BURST 2
+#endif
+
+/*
+ * Publishes on a worker task instead of the task which produced the message.
+ *
+ * Every priority class has its own queue and token bucket. The worker sends the
+ * oldest message of the highest class that has a token left, so a burst in one class
+ * neither exceeds its rate nor delays the classes above it. A state or diagnostics
+ * message replaces a queued one with the same topic, which keeps its place in the
+ * queue, telemetry is never coalesced. Telemetry is handed to mqtt_spool, the other
+ * classes wait for the connection. If all slots are taken a new message pushes out
+ * the oldest one of the lowest class below it, or is dropped.
+ */
+namespace mqtt_scheduler {
+
+// Highest priority first
+enum Priority {
+    PRIORITY_TELEMETRY,   // steps and sessions, spooled while offline
+    PRIORITY_STATE,       // MqttEndpoint, the latest state of a topic is enough
+    PRIORITY_DIAGNOSTICS, // status and metrics
+    PRIORITY_COUNT
+};
+
+// Starts the worker, called by MqttSettingsService::begin()
+void begin(PsychicMqttClient *client);
+
+// Queues a message, false if it was dropped
+bool publish(Priority priority, const char *topic, int qos, bool retain, const char *payload, size_t len);
+
+// Queue depth, published, coalesced and dropped messages and the queue latency per class
+void metrics(JsonObject &root);
+
+} // namespace mqtt_scheduler
+
+#endif
@@ -0,0 +1,283 @@
+#include <mqtt_spool.h>
+
+#include <ESPFS.h>
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+namespace mqtt_spool {
+
+static const char *TAG = "MqttSpool";
+
+// No QoS, spooled messages are all sent with QoS 1
+struct Header {
+    uint16_t topicLen;
+    uint16_t payloadLen;
+    uint8_t retain;
+};
+
+struct RamStorage {
+    uint8_t data[MQTT_SPOOL_RAM_SIZE];
+
+    bool read(size_t offset, void *out, size_t len) {
+        memcpy(out, data + offset, len);
+        return true;
+    }
+
+    bool write(size_t offset, const void *in, size_t len) {
+        memcpy(data + offset, in, len);
+        return true;
+    }
+};
+
+struct FileStorage {
+    File file;
+
+    bool read(size_t offset, void *out, size_t len) {
+        return file && file.seek(offset) && file.read((uint8_t *)out, len) == len;
+    }
+
+    bool write(size_t offset, const void *in, size_t len) {
+        return file && file.seek(offset) && file.write((const uint8_t *)in, len) == len;
+    }
+};
+
+/*
+ * Messages of variable size in a ring. A message never wraps: if it doesn't fit
+ * before the end it starts over at 0, and the end of the data is remembered.
+ */
+template <typename Storage>
+class Ring {
+  public:
+    Ring(Storage &storage, size_t capacity) : _storage(storage), _capacity(capacity) {}
+
+    bool push(const Header &header, const char *topic, const char *payload) {
+        size_t size = sizeof(Header) + header.topicLen + header.payloadLen;
+        size_t at = _head;
+        if (!_wrapped && _capacity - _head < size) {
+            if (_tail < size) return false;
+            at = 0;
+        } else if (_wrapped && _tail - _head < size) {
+            return false;
+        }
+        if (!_storage.write(at, &header, sizeof(Header)) ||
+            !_storage.write(at + sizeof(Header), topic, header.topicLen) ||
+            !_storage.write(at + sizeof(Header) + header.topicLen, payload, header.payloadLen)) {
+            return false;
+        }
+        if (at != _head) {
+            _end = _head;
+            _wrapped = true;
+        }
+        _head = at + size;
+        _count++;
+        _bytes += size;
+        return true;
+    }
+
+    // Copies the oldest message, topic and payload one after the other
+    bool front(Header &header, char *buffer) {
+        return _count && _storage.read(_tail, &header, sizeof(Header)) &&
+               _storage.read(_tail + sizeof(Header), buffer, header.topicLen + header.payloadLen);
+    }
+
+    void pop() {
+        Header header;
+        if (!_count || !_storage.read(_tail, &header, sizeof(Header))) return clear();
+        size_t size = sizeof(Header) + header.topicLen + header.payloadLen;
+        _tail += size;
+        _bytes -= size;
+        if (--_count == 0) return clear();
+        if (_wrapped && _tail == _end) {
+            _tail = 0;
+            _wrapped = false;
+        }
+    }
+
+    void clear() {
+        _head = _tail = _end = _count = _bytes = 0;
+        _wrapped = false;
+    }
+
+    size_t count() const { return _count; }
+    size_t bytes() const { return _bytes; }
+
+  private:
+    Storage &_storage;
+    size_t _capacity;
+    size_t _head {0};
+    size_t _tail {0};
+    size_t _end {0}; // end of the data before _head started over at 0
+    bool _wrapped {false};
+    size_t _count {0};
+    size_t _bytes {0};
+};
+
+static SemaphoreHandle_t mutex = xSemaphoreCreateMutex();
+static PsychicMqttClient *mqttClient = nullptr;
+
+static RamStorage ramStorage;
+static FileStorage fileStorage;
+static Ring<RamStorage> ram(ramStorage, MQTT_SPOOL_RAM_SIZE);
+static Ring<FileStorage> file(fileStorage, MQTT_SPOOL_FILE_SIZE);
+
+// The message being drained, kept until the broker acknowledged it
+static Header inflight;
+static char inflightData[MQTT_SPOOL_MAX_MESSAGE];
+static bool hasInflight = false;
+static uint32_t sentAt = 0;
+
+// Message id the inflight message was last published with, ACKED once the broker acknowledged it.
+// Set to ACKED on the MQTT task, which never takes the mutex.
+#define ACKED 0
+static std::atomic<int> awaitedId {-1};
+
+// Latest acks, for one which arrives before publish() returned the id it belongs to
+#define RECENT_ACKS 4
+static std::atomic<int> recentAcks[RECENT_ACKS];
+static std::atomic<uint8_t> nextAck {0};
+static std::atomic<bool> reconnected {false};
+
+static uint32_t spooled = 0;
+static uint32_t overflowed = 0; // messages which went to the file
+static uint32_t dropped = 0;
+static uint32_t drained = 0;
+static uint32_t resent = 0;
+static uint32_t failed = 0; // sends the client refused, the message is sent again after the ack timeout
+static uint64_t drainedBytes = 0;
+static uint32_t drainStart = 0; // millis() the current or last drain started, 0 if nothing was drained yet
+static uint32_t drainTime = 0;  // ms the last finished drain took
+static uint64_t drainStartBytes = 0;
+static bool draining = false;
+
+static bool empty() { return !hasInflight && !ram.count() && !file.count(); }
+
+// Under the mutex. Once the file holds messages new ones go there as well, so they stay in order.
+static bool spool(const Header &header, const char *topic, const char *payload) {
+    if (!file.count() && ram.push(header, topic, payload)) return true;
+    while (!file.push(header, topic, payload)) {
+        if (!file.count() || !fileStorage.file) return false;
+        file.pop();
+        dropped++;
+    }
+    overflowed++;
+    return true;
+}
+
+void begin(PsychicMqttClient *client) {
+    mqttClient = client;
+    fileStorage.file = ESPFS.open(MQTT_SPOOL_FILE, "w+");
+    if (!fileStorage.file) ESP_LOGE(TAG, "Failed to open %s, spooling to RAM only", MQTT_SPOOL_FILE);
+    mqttClient->onConnect([](bool sessionPresent) { reconnected = true; });
+    // acks of messages which didn't come from the spool carry other ids and are ignored
+    mqttClient->onPublish([](int msgId) {
+        if (msgId <= 0) return;
+        recentAcks[nextAck++ % RECENT_ACKS] = msgId;
+        awaitedId.compare_exchange_strong(msgId, ACKED);
+    });
+}
+
+bool publish(const char *topic, int qos, bool retain, const char *payload, size_t len) {
+    xSemaphoreTake(mutex, portMAX_DELAY);
+    if (mqttClient && mqttClient->connected() && empty() &&
+        mqttClient->publish(topic, qos, retain, payload, len) >= 0) {
+        xSemaphoreGive(mutex);
+        return true;
+    }
+    size_t topicLen = strlen(topic);
+    bool queued = topicLen + len <= MQTT_SPOOL_MAX_MESSAGE &&
+                  spool({(uint16_t)topicLen, (uint16_t)len, retain}, topic, payload);
+    if (queued) {
+        spooled++;
+    } else {
+        dropped++;
+    }
+    xSemaphoreGive(mutex);
+    if (!queued) ESP_LOGW(TAG, "Dropped %u bytes to %s", len, topic);
+    return queued;
+}
+
+// Under the mutex, publishes the inflight message again or the next spooled one
+static void send() {
+    if (!hasInflight) {
+        hasInflight = ram.front(inflight, inflightData) || file.front(inflight, inflightData);
+        if (!hasInflight) return;
+        if (ram.count()) {
+            ram.pop();
+        } else {
+            file.pop();
+        }
+    } else {
+        resent++;
+    }
+    if (!draining) {
+        draining = true;
+        drainStart = millis();
+        drainStartBytes = drainedBytes;
+    }
+    // terminated for the client, the payload is passed with its length
+    static char topic[MQTT_SPOOL_MAX_MESSAGE + 1];
+    memcpy(topic, inflightData, inflight.topicLen);
+    topic[inflight.topicLen] = '\0';
+    awaitedId = -1;
+    // QoS 1 whatever the message was published with, the ack is what lets the spool move on to the next one
+    int msgId = mqttClient->publish(topic, 1, inflight.retain, inflightData + inflight.topicLen, inflight.payloadLen);
+    if (msgId > 0) {
+        // the callback records the ack before it compares, so one racing this store is seen by either side
+        awaitedId = msgId;
+        for (auto &ack : recentAcks) {
+            int expected = msgId;
+            if (ack == msgId) awaitedId.compare_exchange_strong(expected, ACKED);
+        }
+    } else {
+        failed++;
+    }
+    sentAt = millis();
+}
+
+void loop() {
+    if (!mqttClient) return;
+    xSemaphoreTake(mutex, portMAX_DELAY);
+    if (hasInflight && awaitedId.load() == ACKED) {
+        hasInflight = false;
+        awaitedId = -1;
+        drained++;
+        drainedBytes += inflight.topicLen + inflight.payloadLen;
+        if (empty()) {
+            draining = false;
+            drainTime = millis() - drainStart;
+        }
+    }
+    // sent again right away after a reconnect, the broker may never have got it
+    if (reconnected.exchange(false)) sentAt = millis() - MQTT_SPOOL_ACK_TIMEOUT;
+    uint32_t wait = hasInflight ? MQTT_SPOOL_ACK_TIMEOUT : MQTT_SPOOL_DRAIN_INTERVAL;
+    if (!empty() && mqttClient->connected() && millis() - sentAt >= wait) send();
+    xSemaphoreGive(mutex);
+}
+
+void metrics(JsonObject &root) {
+    xSemaphoreTake(mutex, portMAX_DELAY);
+    size_t ramCount = ram.count(), ramBytes = ram.bytes(), fileCount = file.count(), fileBytes = file.bytes();
+    uint32_t spooledCopy = spooled, overflowedCopy = overflowed, droppedCopy = dropped, drainedCopy = drained;
+    uint32_t resentCopy = resent, failedCopy = failed;
+    uint32_t elapsed = draining ? millis() - drainStart : drainTime;
+    uint64_t bytes = drainedBytes - drainStartBytes;
+    bool drainingCopy = draining;
+    xSemaphoreGive(mutex);
+
+    root["ram_messages"] = ramCount;
+    root["ram_bytes"] = ramBytes;
+    root["file_messages"] = fileCount;
+    root["file_bytes"] = fileBytes;
+    root["spooled"] = spooledCopy;
+    root["overflowed"] = overflowedCopy;
+    root["dropped"] = droppedCopy;
+    root["drained"] = drainedCopy;
+    root["resent"] = resentCopy;
+    root["failed"] = failedCopy;
+    root["draining"] = drainingCopy;
+    // of the current drain, or the last one if the spool is empty
+    root["drain_bytes_per_s"] = elapsed ? (uint32_t)(bytes * 1000 / elapsed) : 0;
+}
+
+} // namespace mqtt_spool
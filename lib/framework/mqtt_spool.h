@@ -0,0 +1,58 @@
+#ifndef MqttSpool_h
+#define MqttSpool_h
+
+#include <ArduinoJson.h>
+#include <PsychicMqttClient.h>
+
+// Bytes of messages held in RAM, further ones go to MQTT_SPOOL_FILE
+#ifndef MQTT_SPOOL_RAM_SIZE
+#define MQTT_SPOOL_RAM_SIZE 4096
+#endif
+
+// Size of the ring file, the oldest messages in it are dropped when it is full
+#ifndef MQTT_SPOOL_FILE_SIZE
+#define MQTT_SPOOL_FILE_SIZE 65536
+#endif
+
+// Topic and payload of a message, larger ones are never spooled
+#ifndef MQTT_SPOOL_MAX_MESSAGE
+#define MQTT_SPOOL_MAX_MESSAGE 512
+#endif
+
+// Time between two spooled messages while draining, and until a message without an acknowledgement is sent again
+#ifndef MQTT_SPOOL_DRAIN_INTERVAL
+#define MQTT_SPOOL_DRAIN_INTERVAL 50
+#endif
+
+#ifndef MQTT_SPOOL_ACK_TIMEOUT
+#define MQTT_SPOOL_ACK_TIMEOUT 5000
+#endif
+
+/*
+ * Store and forward for messages published while the broker can't be reached.
+ *
+ * publish() sends right away while connected and nothing is spooled, otherwise the
+ * message is queued in RAM and, once that is full, in a ring file. After reconnecting
+ * the spool is drained in order, one message at a time with QoS 1, and each one is
+ * only dropped once the broker acknowledged it. That holds for messages published with
+ * QoS 0 as well, which are then delivered at least once and may arrive twice like any
+ * resent one. The ring file is started empty on every boot, so messages are kept
+ * across outages but not across restarts.
+ */
+namespace mqtt_spool {
+
+// Opens the ring file and hooks into the client
+void begin(PsychicMqttClient *client);
+
+// Sends or spools a message, false if it was dropped
+bool publish(const char *topic, int qos, bool retain, const char *payload, size_t len);
+
+// Drains the spool, call regularly
+void loop();
+
+// Spooled messages and bytes, drops and the drain throughput
+void metrics(JsonObject &root);
+
+} // namespace mqtt_spool
+
+#endif
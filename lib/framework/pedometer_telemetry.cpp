@@ -0,0 +1,120 @@
+#include <pedometer_telemetry.h>
+
+#include <SettingValue.h>
+#include <global.h>
+#include <mqtt_scheduler.h>
+
+void PedoMeterTelemetry::begin(PsychicMqttClient *mqttClient) {
+    _mqttClient = mqttClient;
+    _topic = SettingValue::format(PEDOMETER_TELEMETRY_TOPIC);
+    _mqttClient->onConnect([this](bool sessionPresent) { onConnect(); });
+    _mqttClient->onMessage(std::bind(&PedoMeterTelemetry::onMessage, this, std::placeholders::_1,
+                                     std::placeholders::_2, std::placeholders::_3, std::placeholders::_4,
+                                     std::placeholders::_5));
+}
+
+void PedoMeterTelemetry::add(const StepEvent &event) {
+    char payload[112];
+    size_t len;
+    switch (event.type) {
+        case StepEventType::STEP: {
+            if (_pending && event.seq != _firstSeq + _pending) flush();
+            if (!_pending) {
+                _firstSeq = event.seq;
+                _firstAt = millis();
+            }
+            float ms = event.timeElapsed * 1000;
+            _intervals[_pending++] = ms < 0 ? 0 : ms > UINT16_MAX ? UINT16_MAX : (uint16_t)(ms + 0.5f);
+            _sessionSteps++;
+            if (_pending == PEDOMETER_TELEMETRY_BATCH) flush();
+            return;
+        }
+        case StepEventType::SESSION_START:
+            flush();
+            _sessionStart = event.timestamp;
+            _sessionSteps = 0;
+            len = snprintf(payload, sizeof(payload), "{\"seq\":%lu,\"boot\":%lu,\"start\":%ld}",
+                           (unsigned long)event.seq, (unsigned long)bootNonce(), event.timestamp);
+            break;
+        case StepEventType::SESSION_END:
+            flush();
+            len = snprintf(payload, sizeof(payload),
+                           "{\"seq\":%lu,\"boot\":%lu,\"start\":%ld,\"end\":%ld,\"steps\":%lu}",
+                           (unsigned long)event.seq, (unsigned long)bootNonce(), _sessionStart, event.timestamp,
+                           (unsigned long)_sessionSteps);
+            break;
+        default: return;
+    }
+    publish("/session", 1, false, payload, len);
+}
+
+void PedoMeterTelemetry::loop() {
+    if (_pending && millis() - _firstAt >= PEDOMETER_TELEMETRY_FLUSH_MS) flush();
+}
+
+void PedoMeterTelemetry::flush() {
+    if (!_pending) return;
+    // "65535," per step
+    char payload[48 + PEDOMETER_TELEMETRY_BATCH * 6];
+    size_t len = snprintf(payload, sizeof(payload), "{\"seq\":%lu,\"start\":%ld,\"ms\":[", (unsigned long)_firstSeq,
+                          _sessionStart);
+    for (size_t i = 0; i < _pending; i++) {
+        len += snprintf(payload + len, sizeof(payload) - len, i ? ",%u" : "%u", _intervals[i]);
+    }
+    len += snprintf(payload + len, sizeof(payload) - len, "]}");
+    _pending = 0;
+    publish("/steps", 0, false, payload, len);
+}
+
+bool PedoMeterTelemetry::publishSnapshotHeader(uint32_t seq, uint32_t parts, float magnets, float diameter) {
+    char payload[128];
+    size_t len = snprintf(payload, sizeof(payload),
+                          "{\"boot\":%lu,\"seq\":%lu,\"part\":0,\"parts\":%lu,\"magnets\":%g,\"diameter\":%g}",
+                          (unsigned long)bootNonce(), (unsigned long)seq, (unsigned long)parts, magnets, diameter);
+    return publishSnapshot(payload, len);
+}
+
+bool PedoMeterTelemetry::publishSnapshotPart(uint32_t seq, uint32_t part, const SessionHeader &session,
+                                             size_t offset, const float *times, size_t count) {
+    // "65535," per step
+    char payload[160 + PEDOMETER_SNAPSHOT_BATCH * 6];
+    size_t len = snprintf(payload, sizeof(payload),
+                          "{\"boot\":%lu,\"seq\":%lu,\"part\":%lu,\"start\":%ld,\"end\":%ld,\"steps\":%d,"
+                          "\"offset\":%u,\"ms\":[",
+                          (unsigned long)bootNonce(), (unsigned long)seq, (unsigned long)part, session.start,
+                          session.end, session.steps, offset);
+    for (size_t i = 0; i < count && i < PEDOMETER_SNAPSHOT_BATCH; i++) {
+        float ms = times[i] * 1000;
+        len += snprintf(payload + len, sizeof(payload) - len, i ? ",%u" : "%u",
+                        ms < 0 ? 0 : ms > UINT16_MAX ? UINT16_MAX : (unsigned)(ms + 0.5f));
+    }
+    len += snprintf(payload + len, sizeof(payload) - len, "]}");
+    return publishSnapshot(payload, len);
+}
+
+// Parts fit the spool, so like steps they are sent in order and late rather than lost
+bool PedoMeterTelemetry::publishSnapshot(const char *payload, size_t len) {
+    if (!_mqttClient) return false;
+    String topic = _topic + "/snapshot";
+    return mqtt_scheduler::publish(mqtt_scheduler::PRIORITY_TELEMETRY, topic.c_str(), 1, false, payload, len);
+}
+
+void PedoMeterTelemetry::publish(const char *subtopic, int qos, bool retain, const char *payload, size_t len) {
+    if (!_mqttClient) return;
+    String topic = _topic + subtopic;
+    mqtt_scheduler::publish(mqtt_scheduler::PRIORITY_TELEMETRY, topic.c_str(), qos, retain, payload, len);
+}
+
+void PedoMeterTelemetry::onConnect() {
+    String topic = _topic + "/snapshot/get";
+    _mqttClient->subscribe(topic.c_str(), 1);
+}
+
+// A retained request would trigger a snapshot on every connect, so only live ones count
+void PedoMeterTelemetry::onMessage(char *topic, char *payload, int retain, int qos, bool dup) {
+    if (retain || !_topic.length() || strncmp(topic, _topic.c_str(), _topic.length()) ||
+        strcmp(topic + _topic.length(), "/snapshot/get")) {
+        return;
+    }
+    _snapshotRequested = true;
+}
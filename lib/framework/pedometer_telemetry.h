@@ -0,0 +1,89 @@
+#pragma once
+
+#include <Arduino.h>
+#include <PsychicMqttClient.h>
+#include <atomic>
+#include <domain/pedometer_data.h>
+#include <step_event_log.h>
+
+// Base of the telemetry topics, placeholders are substituted like in the MQTT settings
+#ifndef PEDOMETER_TELEMETRY_TOPIC
+#define PEDOMETER_TELEMETRY_TOPIC "pedometer/#{unique_id}"
+#endif
+
+// Steps sent in one message at most, and the time a step waits for more before it is sent anyway
+#ifndef PEDOMETER_TELEMETRY_BATCH
+#define PEDOMETER_TELEMETRY_BATCH 32
+#endif
+
+#ifndef PEDOMETER_TELEMETRY_FLUSH_MS
+#define PEDOMETER_TELEMETRY_FLUSH_MS 2000
+#endif
+
+// Steps in one snapshot part, which has to fit MQTT_SPOOL_MAX_MESSAGE with "65535," per step
+#ifndef PEDOMETER_SNAPSHOT_BATCH
+#define PEDOMETER_SNAPSHOT_BATCH 48
+#endif
+
+/*
+ * Publishes steps and sessions on their own MQTT topics as they happen, instead of
+ * the whole history on every step:
+ *
+ *   <topic>/steps             {"seq":41,"start":1700000000,"ms":[512,498,530]}
+ *   <topic>/session           {"seq":40,"boot":3735928559,"start":1700000000} or
+ *                             {"seq":90,"boot":3735928559,"start":1700000000,"end":1700000031,"steps":49}
+ *   <topic>/snapshot          {"boot":3735928559,"seq":90,"part":0,"parts":3,"magnets":1,"diameter":0.19} then
+ *                             {"boot":3735928559,"seq":90,"part":1,"start":1700000000,"end":1700000031,
+ *                              "steps":49,"offset":0,"ms":[512,498,530]}
+ *   <topic>/snapshot/get      any message requests a snapshot
+ *
+ * A steps message holds the intervals in ms of consecutive steps, seq is the one of
+ * the first, so every step costs at most 6 bytes. Session events flush the pending
+ * steps first and the sequence numbers match the Event Socket ones, which lets a
+ * subscriber spot lost messages. Sequence numbers start over on every boot, a session
+ * event with a new boot nonce tells a subscriber to forget the old ones. Steps and
+ * session events are QoS 0 and 1 and are queued as telemetry in mqtt_scheduler, which
+ * hands them to mqtt_spool, so they are sent late instead of lost while disconnected.
+ *
+ * A snapshot is the history as of seq, split into parts of at most
+ * PEDOMETER_SNAPSHOT_BATCH steps of one session, which are queued as telemetry too.
+ *
+ * All calls but the snapshot request, which arrives on the MQTT task, are made from
+ * the pedometer task.
+ */
+class PedoMeterTelemetry {
+  public:
+    void begin(PsychicMqttClient *mqttClient);
+
+    void add(const StepEvent &event);
+
+    // Sends the pending steps once they waited PEDOMETER_TELEMETRY_FLUSH_MS
+    void loop();
+
+    // True once per request on <topic>/snapshot/get
+    bool snapshotRequested() { return _snapshotRequested.exchange(false); }
+
+    // Parts of a snapshot, false if the part wasn't queued and has to be sent again
+    bool publishSnapshotHeader(uint32_t seq, uint32_t parts, float magnets, float diameter);
+    bool publishSnapshotPart(uint32_t seq, uint32_t part, const SessionHeader &session, size_t offset,
+                             const float *times, size_t count);
+
+  private:
+    PsychicMqttClient *_mqttClient {nullptr};
+    String _topic;
+    std::atomic<bool> _snapshotRequested {false};
+
+    uint16_t _intervals[PEDOMETER_TELEMETRY_BATCH]; // ms
+    size_t _pending {0};
+    uint32_t _firstSeq {0};
+    uint32_t _firstAt {0}; // millis() the first pending step was added
+
+    long _sessionStart {0};
+    uint32_t _sessionSteps {0};
+
+    void flush();
+    bool publishSnapshot(const char *payload, size_t len);
+    void publish(const char *subtopic, int qos, bool retain, const char *payload, size_t len);
+    void onConnect();
+    void onMessage(char *topic, char *payload, int retain, int qos, bool dup);
+};
@@ -0,0 +1,43 @@
+#ifndef RawBodyHandler_h
+#define RawBodyHandler_h
+
+#include <PsychicHttp.h>
+#include <functional>
+#include <memory>
+
+// Largest request body a RawBodyHandler reads, larger requests are answered with 413
+#ifndef RAW_BODY_MAX_SIZE
+#define RAW_BODY_MAX_SIZE (16 * 1024)
+#endif
+
+typedef std::function<esp_err_t(PsychicRequest *request, const uint8_t *body, size_t len)> RawBodyCallback;
+
+/*
+ * Passes the request body to the callback as bytes. PsychicWebHandler keeps the body
+ * as a C string, which cuts binary formats like MessagePack off at the first 0 byte.
+ */
+class RawBodyHandler : public PsychicHandler {
+  public:
+    RawBodyHandler(RawBodyCallback callback) : _callback(callback) {}
+
+    esp_err_t handleRequest(PsychicRequest *request) override {
+        size_t len = request->contentLength();
+        if (len > RAW_BODY_MAX_SIZE) return request->reply(413);
+
+        std::unique_ptr<uint8_t[]> body(new (std::nothrow) uint8_t[len ? len : 1]);
+        if (!body) return request->reply(500);
+        size_t received = 0;
+        while (received < len) {
+            int chunk = httpd_req_recv(request->request(), (char *)body.get() + received, len - received);
+            if (chunk == HTTPD_SOCK_ERR_TIMEOUT) continue;
+            if (chunk <= 0) return ESP_FAIL;
+            received += chunk;
+        }
+        return _callback(request, body.get(), len);
+    }
+
+  private:
+    RawBodyCallback _callback;
+};
+
+#endif
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <string.h>
+#include <type_traits>
+
+// Optimistic attempts of a SeqStateLock reader before it waits for the writer instead
+#ifndef SEQ_STATE_LOCK_RETRIES
+#define SEQ_STATE_LOCK_RETRIES 8
+#endif
+
+/*
+ * Lock policies of StatefulService. read() runs a reader on the state, lock() and
+ * unlock() enclose an update. A state type picks its policy by specializing
+ * StateLockPolicy, which keeps StatefulService<T> the same type for every endpoint:
+ *
+ *   template <>
+ *   struct StateLockPolicy<LightState> {
+ *       using type = SharedStateLock;
+ *   };
+ */
+
+// One recursive mutex for readers and writers, so readers queue behind each other
+class RecursiveStateLock {
+  public:
+    RecursiveStateLock() : _mutex(xSemaphoreCreateRecursiveMutex()) {}
+
+    template <typename T, typename Reader>
+    void read(T &state, Reader &&reader) {
+        lock();
+        reader(state);
+        unlock();
+    }
+
+    void lock() { xSemaphoreTakeRecursive(_mutex, portMAX_DELAY); }
+    void unlock() { xSemaphoreGiveRecursive(_mutex); }
+
+  private:
+    SemaphoreHandle_t _mutex;
+};
+
+/*
+ * Readers share the state and run in parallel on both cores. A writer waits for the
+ * readers inside to leave and holds new ones back meanwhile, so a steady stream of
+ * readers can't starve it. Not recursive: a reader must not read or update the same
+ * service again.
+ */
+class SharedStateLock {
+  public:
+    SharedStateLock()
+        : _turnstile(xSemaphoreCreateMutex()), _counter(xSemaphoreCreateMutex()), _writer(xSemaphoreCreateBinary()) {
+        xSemaphoreGive(_writer);
+    }
+
+    template <typename T, typename Reader>
+    void read(T &state, Reader &&reader) {
+        xSemaphoreTake(_turnstile, portMAX_DELAY);
+        xSemaphoreGive(_turnstile);
+        xSemaphoreTake(_counter, portMAX_DELAY);
+        if (++_readers == 1) xSemaphoreTake(_writer, portMAX_DELAY);
+        xSemaphoreGive(_counter);
+
+        reader(state);
+
+        xSemaphoreTake(_counter, portMAX_DELAY);
+        if (--_readers == 0) xSemaphoreGive(_writer);
+        xSemaphoreGive(_counter);
+    }
+
+    void lock() {
+        xSemaphoreTake(_turnstile, portMAX_DELAY);
+        xSemaphoreTake(_writer, portMAX_DELAY);
+    }
+
+    void unlock() {
+        xSemaphoreGive(_writer);
+        xSemaphoreGive(_turnstile);
+    }
+
+  private:
+    SemaphoreHandle_t _turnstile; // held by a waiting writer to stop new readers
+    SemaphoreHandle_t _counter;   // guards _readers
+    SemaphoreHandle_t _writer;    // binary, held by the readers as a group or by one writer
+    uint32_t _readers {0};
+};
+
+/*
+ * Readers never take a lock. They copy the state and retry if a writer was active
+ * meanwhile, after SEQ_STATE_LOCK_RETRIES attempts they wait for the writer mutex so
+ * a preempted writer can't be starved. For small trivially copyable states only, the
+ * reader is given the copy.
+ */
+class SeqStateLock {
+  public:
+    SeqStateLock() : _mutex(xSemaphoreCreateMutex()) {}
+
+    template <typename T, typename Reader>
+    void read(T &state, Reader &&reader) {
+        static_assert(std::is_trivially_copyable<T>::value, "SeqStateLock needs a trivially copyable state");
+        alignas(T) unsigned char copy[sizeof(T)];
+        for (int attempt = 0; attempt < SEQ_STATE_LOCK_RETRIES; attempt++) {
+            uint32_t sequence = _sequence.load(std::memory_order_acquire);
+            if (sequence & 1) continue;
+            memcpy(copy, &state, sizeof(T));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (_sequence.load(std::memory_order_relaxed) == sequence) {
+                reader(*reinterpret_cast<T *>(copy));
+                return;
+            }
+        }
+        xSemaphoreTake(_mutex, portMAX_DELAY);
+        memcpy(copy, &state, sizeof(T));
+        xSemaphoreGive(_mutex);
+        reader(*reinterpret_cast<T *>(copy));
+    }
+
+    void lock() {
+        xSemaphoreTake(_mutex, portMAX_DELAY);
+        _sequence.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+
+    void unlock() {
+        _sequence.fetch_add(1, std::memory_order_release);
+        xSemaphoreGive(_mutex);
+    }
+
+  private:
+    SemaphoreHandle_t _mutex;
+    std::atomic<uint32_t> _sequence {0}; // odd while a writer is active
+};
+
+template <typename T>
+struct StateLockPolicy {
+    using type = RecursiveStateLock;
+};
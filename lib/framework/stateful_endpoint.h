@@ -3,21 +3,81 @@
 
 #include <PsychicHttp.h>
 #include <functional>
+#include <global.h>
+#include <json_pool.h>
+#include <json_stream.h>
 
-#define HTTP_ENDPOINT_ORIGIN_ID "http"
-#define HTTPS_ENDPOINT_ORIGIN_ID "https"
+#define HTTP_ENDPOINT_ORIGIN_ID ORIGIN_HTTP
+#define HTTPS_ENDPOINT_ORIGIN_ID ORIGIN_HTTPS
+
+#define MSGPACK_CONTENT_TYPE "application/msgpack"
+
+// Writes the whole state, taking the lock itself so it can release it between batches
+typedef std::function<void(JsonStreamWriter &json)> JsonStreamReader;
 
 template <class T>
 class HttpEndpoint {
   protected:
     JsonStateReader<T> _stateReader;
     JsonStateUpdater<T> _stateUpdater;
+    JsonStreamReader _streamReader;
     StatefulService<T> *_statefulService;
 
+    static bool isMsgPack(const String &mediaType) { return mediaType.indexOf(MSGPACK_CONTENT_TYPE) >= 0; }
+
+    // Writes the state into a chunked response, with a stream reader peak memory is the chunk buffer
+    esp_err_t sendState(PsychicRequest *request, const String &tag, bool msgPack) {
+        uint32_t start = micros();
+        PsychicStreamResponse response =
+            PsychicStreamResponse(request, msgPack ? MSGPACK_CONTENT_TYPE : "application/json");
+        addCacheHeaders(response, tag);
+        esp_err_t err = response.beginSend();
+        if (err != ESP_OK) return err;
+        uint32_t firstByte = micros() - start;
+
+        JsonStreamWriter json(response, msgPack ? StreamFormat::MSGPACK : StreamFormat::JSON);
+        write(json);
+        // without the last chunk the client sees the body broken off
+        if (json.aborted()) return ESP_FAIL;
+        err = response.endSend();
+
+        ESP_LOGD("HttpEndpoint", "%s sent %u bytes, first byte %lu us, total %lu us", request->uri().c_str(),
+                 json.bytesWritten(), firstByte, micros() - start);
+        return err;
+    }
+
+    // Both representations share the version, the suffix keeps a cached JSON body from validating a MessagePack one
+    String etag(bool msgPack) {
+        char tag[32];
+        snprintf(tag, sizeof(tag), "\"%08lx-%lu%s\"", (unsigned long)bootNonce(),
+                 (unsigned long)_statefulService->version(), msgPack ? "-m" : "");
+        return tag;
+    }
+
+    // The browser has to revalidate every time, which costs a 304 as long as the state is unchanged
+    void addCacheHeaders(PsychicResponse &response, const String &tag) {
+        response.addHeader("ETag", tag.c_str());
+        response.addHeader("Cache-Control", "no-cache");
+        response.addHeader("Vary", "Accept");
+    }
+
   public:
     HttpEndpoint(JsonStateReader<T> stateReader, JsonStateUpdater<T> stateUpdater, StatefulService<T> *statefulService)
         : _stateReader(stateReader), _stateUpdater(stateUpdater), _statefulService(statefulService) {}
 
+    // Serves GET and POST replies in streaming mode, for states too large to build as a JsonDocument or to be
+    // sent under one lock
+    void setStreamReader(JsonStreamReader streamReader) { _streamReader = streamReader; }
+
+    // Writes the state as one value, for GET and POST replies as well as one entry of a batch response
+    void write(JsonStreamWriter &json) {
+        if (_streamReader) return _streamReader(json);
+        JsonDocument doc(json_pool::allocator(json_pool::SITE_HTTP));
+        JsonObject root = doc.to<JsonObject>();
+        _statefulService->read(root, _stateReader);
+        json.variant(doc);
+    }
+
     esp_err_t handleStateUpdate(PsychicRequest *request, JsonVariant &json) {
         if (!json.is<JsonObject>()) {
             return request->reply(400);
@@ -30,22 +90,34 @@ class HttpEndpoint {
             return request->reply(400);
         } else if ((outcome == StateUpdateResult::CHANGED)) {
             // persist the changes to the FS
-            _statefulService->callUpdateHandlers(HTTP_ENDPOINT_ORIGIN_ID);
+            _statefulService->dispatchUpdateHandlers(HTTP_ENDPOINT_ORIGIN_ID, outcome.fields());
         }
 
-        PsychicJsonResponse response = PsychicJsonResponse(request, false);
-        jsonObject = response.getRoot();
-
-        _statefulService->read(jsonObject, _stateReader);
+        bool msgPack = isMsgPack(request->header("Accept"));
+        return sendState(request, etag(msgPack), msgPack);
+    }
 
-        return response.send();
+    // Parses a JSON or, with Content-Type: application/msgpack, a MessagePack body
+    esp_err_t handleStateUpdate(PsychicRequest *request, const uint8_t *body, size_t len) {
+        JsonDocument doc(json_pool::allocator(json_pool::SITE_HTTP));
+        DeserializationError error = isMsgPack(request->contentType()) ? deserializeMsgPack(doc, body, len)
+                                                                       : deserializeJson(doc, body, len);
+        if (error) return request->reply(400);
+        JsonVariant json = doc.as<JsonVariant>();
+        return handleStateUpdate(request, json);
     }
 
     esp_err_t getState(PsychicRequest *request) {
-        PsychicJsonResponse response = PsychicJsonResponse(request, false);
-        JsonObject jsonObject = response.getRoot();
-        _statefulService->read(jsonObject, _stateReader);
-        return response.send();
+        // the version is read before the state, a racing update only makes the tag older than the body
+        bool msgPack = isMsgPack(request->header("Accept"));
+        String tag = etag(msgPack);
+        if (request->hasHeader("If-None-Match") && request->header("If-None-Match").indexOf(tag) >= 0) {
+            PsychicResponse response = PsychicResponse(request);
+            response.setCode(304);
+            addCacheHeaders(response, tag);
+            return response.send();
+        }
+        return sendState(request, tag, msgPack);
     }
 };
 
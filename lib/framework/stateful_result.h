@@ -1,3 +1,60 @@
 #pragma once
 
-enum class StateUpdateResult { CHANGED = 0, UNCHANGED, ERROR };
\ No newline at end of file
+#include <stdint.h>
+
+// Bit per top-level field of a state, declared by the state type, e.g. MqttSettings::FIELD_URI
+typedef uint32_t field_mask_t;
+
+#define ALL_FIELDS ((field_mask_t)~0UL)
+
+/*
+ * Outcome of an update. Compares equal to CHANGED, UNCHANGED or ERROR by kind only,
+ * a CHANGED result also carries the fields the update changed. Plain CHANGED means
+ * all of them, for states which don't track their fields.
+ */
+class StateUpdateResult {
+  public:
+    static const StateUpdateResult CHANGED;
+    static const StateUpdateResult UNCHANGED;
+    static const StateUpdateResult ERROR;
+
+    // CHANGED with just these fields, UNCHANGED if there are none
+    static constexpr StateUpdateResult changed(field_mask_t fields) {
+        return fields ? StateUpdateResult(Kind::CHANGED, fields) : StateUpdateResult(Kind::UNCHANGED, 0);
+    }
+
+    constexpr field_mask_t fields() const { return _fields; }
+
+    constexpr bool operator==(const StateUpdateResult &other) const { return _kind == other._kind; }
+    constexpr bool operator!=(const StateUpdateResult &other) const { return _kind != other._kind; }
+
+  private:
+    enum class Kind : uint8_t { CHANGED, UNCHANGED, ERROR };
+
+    constexpr StateUpdateResult(Kind kind, field_mask_t fields) : _kind(kind), _fields(fields) {}
+
+    Kind _kind;
+    field_mask_t _fields;
+};
+
+inline constexpr StateUpdateResult StateUpdateResult::CHANGED {Kind::CHANGED, ALL_FIELDS};
+inline constexpr StateUpdateResult StateUpdateResult::UNCHANGED {Kind::UNCHANGED, 0};
+inline constexpr StateUpdateResult StateUpdateResult::ERROR {Kind::ERROR, 0};
+
+// Assigns value to field if it differs and marks the field as changed
+template <typename F, typename V>
+inline void updateField(F &field, const V &value, field_mask_t bit, field_mask_t &changed) {
+    if (field == value) return;
+    field = value;
+    changed |= bit;
+}
+
+// Who caused an update. Event Socket clients are identified by their socket, which is never negative.
+typedef int origin_id_t;
+
+enum : origin_id_t {
+    ORIGIN_NONE = -1,
+    ORIGIN_HTTP = -2,
+    ORIGIN_HTTPS = -3,
+    ORIGIN_MQTT = -4,
+};
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+#define EVENT_STEP "step"
+#define EVENT_SESSION "session"
+
+// Number of events copied out of the log per lock while replaying
+#define STEP_EVENT_REPLAY_BATCH 16
+
+enum class StepEventType : uint8_t { STEP = 0, SESSION_START, SESSION_END };
+
+struct StepEvent {
+    uint32_t seq;
+    StepEventType type;
+    long timestamp;
+    float timeElapsed;
+
+    const char *name() const { return type == StepEventType::STEP ? EVENT_STEP : EVENT_SESSION; }
+
+    size_t serialize(char *buffer, size_t len) const {
+        switch (type) {
+            case StepEventType::STEP:
+                return snprintf(buffer, len, "{\"seq\":%lu,\"time_elapsed\":%g}", (unsigned long)seq, timeElapsed);
+            case StepEventType::SESSION_START:
+                return snprintf(buffer, len, "{\"seq\":%lu,\"start\":%ld}", (unsigned long)seq, timestamp);
+            case StepEventType::SESSION_END:
+                return snprintf(buffer, len, "{\"seq\":%lu,\"end\":%ld}", (unsigned long)seq, timestamp);
+        }
+        return 0;
+    }
+};
+
+/*
+ * Bounded replay buffer of step and session events.
+ *
+ * Every appended event gets the next sequence number. Clients remember the last
+ * sequence number they have seen and can replay everything after it, as long as
+ * those events are still in the buffer.
+ */
+template <size_t N>
+class StepEventLog {
+  public:
+    StepEventLog() : _mutex(xSemaphoreCreateMutex()) {}
+
+    StepEvent append(StepEventType type, long timestamp, float timeElapsed = 0) {
+        xSemaphoreTake(_mutex, portMAX_DELAY);
+        StepEvent &event = _events[++_head % N];
+        event = {.seq = _head, .type = type, .timestamp = timestamp, .timeElapsed = timeElapsed};
+        if (_count < N) _count++;
+        xSemaphoreGive(_mutex);
+        return event;
+    }
+
+    uint32_t head() {
+        xSemaphoreTake(_mutex, portMAX_DELAY);
+        uint32_t head = _head;
+        xSemaphoreGive(_mutex);
+        return head;
+    }
+
+    // Drops all buffered events but keeps counting, so any older sequence number becomes a gap
+    void clear() {
+        xSemaphoreTake(_mutex, portMAX_DELAY);
+        _count = 0;
+        xSemaphoreGive(_mutex);
+    }
+
+    // Calls callback for every event after since. Returns false if those events are no
+    // longer buffered (or never existed, e.g. after a restart) and the client has to reload.
+    template <typename Callback>
+    bool replay(uint32_t since, Callback &&callback) {
+        StepEvent batch[STEP_EVENT_REPLAY_BATCH];
+        uint32_t next = since + 1;
+
+        while (true) {
+            size_t batchSize = 0;
+            xSemaphoreTake(_mutex, portMAX_DELAY);
+            uint32_t oldest = _head - _count + 1;
+            if (since > _head || next < oldest) {
+                xSemaphoreGive(_mutex);
+                return false;
+            }
+            while (next <= _head && batchSize < STEP_EVENT_REPLAY_BATCH) {
+                batch[batchSize++] = _events[next++ % N];
+            }
+            xSemaphoreGive(_mutex);
+
+            if (!batchSize) return true;
+            for (size_t i = 0; i < batchSize; i++) callback(batch[i]);
+        }
+    }
+
+  private:
+    SemaphoreHandle_t _mutex;
+    StepEvent _events[N];
+    uint32_t _head {0};
+    size_t _count {0};
+};
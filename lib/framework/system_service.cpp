@@ -4,6 +4,9 @@ namespace system_service {
 
 static const char *TAG = "SystemService";
 
+static portMUX_TYPE loopMux = portMUX_INITIALIZER_UNLOCKED;
+static Log2Histogram<24> loopTimes;
+
 esp_err_t handleReset(PsychicRequest *request) {
     reset();
     return request->reply(200);
@@ -19,20 +22,6 @@ esp_err_t handleSleep(PsychicRequest *request) {
     return request->reply(200);
 }
 
-esp_err_t getStatus(PsychicRequest *request) {
-    PsychicJsonResponse response = PsychicJsonResponse(request, false);
-    JsonObject root = response.getRoot();
-    status(root);
-    return response.send();
-}
-
-esp_err_t getMetrics(PsychicRequest *request) {
-    PsychicJsonResponse response = PsychicJsonResponse(request, false);
-    JsonObject root = response.getRoot();
-    metrics(root);
-    return response.send();
-}
-
 void reset() {
     ESP_LOGI(TAG, "Resetting device");
     File root = ESPFS.open(FS_CONFIG_DIRECTORY);
@@ -119,6 +108,33 @@ void metrics(JsonObject &root) {
     root["fs_used"] = ESPFS.usedBytes();
     root["fs_total"] = ESPFS.totalBytes();
     root["core_temp"] = temperatureRead();
+    root["ws_clients"] = socket.clientCount();
+    root["ws_evicted"] = socket.evictedClients();
+    JsonObject eventSocket = root["event_socket"].to<JsonObject>();
+    socket.metrics(eventSocket);
+    JsonObject http = root["http"].to<JsonObject>();
+    connection_manager::metrics(http);
+    JsonObject updates = root["update_dispatch"].to<JsonObject>();
+    update_dispatcher::metrics(updates);
+    JsonObject jsonPool = root["json_pool"].to<JsonObject>();
+    json_pool::metrics(jsonPool);
+#if FT_ENABLED(USE_MQTT)
+    JsonObject mqttSpool = root["mqtt_spool"].to<JsonObject>();
+    mqtt_spool::metrics(mqttSpool);
+    JsonObject mqttScheduler = root["mqtt_scheduler"].to<JsonObject>();
+    mqtt_scheduler::metrics(mqttScheduler);
+#endif
+    portENTER_CRITICAL(&loopMux);
+    Log2Histogram<24> loopCopy = loopTimes;
+    portEXIT_CRITICAL(&loopMux);
+    JsonObject loop = root["loop"].to<JsonObject>();
+    loopCopy.serialize(loop, false);
+}
+
+void recordLoop(uint32_t us) {
+    portENTER_CRITICAL(&loopMux);
+    loopTimes.record(us);
+    portEXIT_CRITICAL(&loopMux);
 }
 
 const char *resetReason(int reason) {
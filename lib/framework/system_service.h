@@ -3,16 +3,21 @@
 
 #include <ESPFS.h>
 #include <ESPmDNS.h>
+#include <EventSocket.h>
 #include <PsychicHttp.h>
 #include <WiFi.h>
+#include <connection_manager.h>
 #include <global.h>
+#include <histogram.h>
+#include <json_pool.h>
+#include <mqtt_scheduler.h>
+#include <mqtt_spool.h>
+#include <update_dispatcher.h>
 
 namespace system_service {
 esp_err_t handleReset(PsychicRequest *request);
 esp_err_t handleRestart(PsychicRequest *request);
 esp_err_t handleSleep(PsychicRequest *request);
-esp_err_t getStatus(PsychicRequest *request);
-esp_err_t getMetrics(PsychicRequest *request);
 
 void reset();
 void restart();
@@ -20,6 +25,9 @@ void sleep();
 void status(JsonObject &root);
 void metrics(JsonObject &root);
 const char *resetReason(int reason);
+
+// Time in us one iteration of the framework loop took, reported under "loop"
+void recordLoop(uint32_t us);
 } // namespace system_service
 
 #endif
\ No newline at end of file
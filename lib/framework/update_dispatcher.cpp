@@ -0,0 +1,101 @@
+#include <update_dispatcher.h>
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <histogram.h>
+
+namespace update_dispatcher {
+
+static const char *TAG = "UpdateDispatcher";
+
+static QueueHandle_t queue = nullptr;
+static portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
+
+static uint32_t dispatched = 0;
+static uint32_t coalesced = 0;
+static uint32_t inlined = 0;       // updates run on the caller, before begin() or with a full queue
+static Log2Histogram<24> waiting;  // us from the first queued update to the dispatch
+static Log2Histogram<24> handlers; // us the handlers of a dispatch ran
+
+static void worker(void *) {
+    PendingUpdate *pending;
+    for (;;) {
+        if (xQueueReceive(queue, &pending, portMAX_DELAY) != pdTRUE) continue;
+        // cleared before the handlers run, so an update they don't see yet is queued again
+        portENTER_CRITICAL(&mux);
+        origin_id_t originId = pending->originId;
+        field_mask_t fields = pending->fields;
+        uint32_t queuedAt = pending->queuedAt;
+        pending->queued = false;
+        portEXIT_CRITICAL(&mux);
+
+        uint32_t start = micros();
+        pending->dispatch(originId, fields);
+        uint32_t end = micros();
+
+        portENTER_CRITICAL(&mux);
+        dispatched++;
+        waiting.record(start - queuedAt);
+        handlers.record(end - start);
+        portEXIT_CRITICAL(&mux);
+    }
+}
+
+void begin() {
+    queue = xQueueCreate(UPDATE_DISPATCH_QUEUE_SIZE, sizeof(PendingUpdate *));
+    xTaskCreatePinnedToCore(worker, "Update Dispatch", UPDATE_DISPATCH_STACK_SIZE, nullptr, (tskIDLE_PRIORITY + 1),
+                            NULL, 0);
+}
+
+void schedule(PendingUpdate &pending, origin_id_t originId, field_mask_t fields) {
+    portENTER_CRITICAL(&mux);
+    if (pending.queued) {
+        if (pending.originId != originId) pending.originId = ORIGIN_NONE;
+        pending.fields |= fields;
+        coalesced++;
+        portEXIT_CRITICAL(&mux);
+        return;
+    }
+    bool running = queue != nullptr;
+    if (running) {
+        pending.queued = true;
+        pending.originId = originId;
+        pending.fields = fields;
+        pending.queuedAt = micros();
+    }
+    portEXIT_CRITICAL(&mux);
+
+    PendingUpdate *item = &pending;
+    if (running && xQueueSend(queue, &item, 0) == pdTRUE) return;
+    if (running) {
+        ESP_LOGW(TAG, "Dispatch queue full, raise UPDATE_DISPATCH_QUEUE_SIZE");
+        portENTER_CRITICAL(&mux);
+        pending.queued = false;
+        originId = pending.originId;
+        fields = pending.fields;
+        portEXIT_CRITICAL(&mux);
+    }
+    portENTER_CRITICAL(&mux);
+    inlined++;
+    portEXIT_CRITICAL(&mux);
+    pending.dispatch(originId, fields);
+}
+
+void metrics(JsonObject &root) {
+    // copied first, the json document may allocate which isn't allowed in a critical section
+    portENTER_CRITICAL(&mux);
+    uint32_t dispatchedCopy = dispatched, coalescedCopy = coalesced, inlinedCopy = inlined;
+    Log2Histogram<24> waitingCopy = waiting;
+    Log2Histogram<24> handlersCopy = handlers;
+    portEXIT_CRITICAL(&mux);
+    root["dispatched"] = dispatchedCopy;
+    root["coalesced"] = coalescedCopy;
+    root["inlined"] = inlinedCopy;
+    JsonObject waitingObject = root["waiting"].to<JsonObject>();
+    waitingCopy.serialize(waitingObject, false);
+    JsonObject handlersObject = root["handlers"].to<JsonObject>();
+    handlersCopy.serialize(handlersObject, false);
+}
+
+} // namespace update_dispatcher
@@ -0,0 +1,48 @@
+#ifndef UpdateDispatcher_h
+#define UpdateDispatcher_h
+
+#include <ArduinoJson.h>
+#include <inline_function.h>
+#include <stateful_result.h>
+
+// Services with deferred update handlers that can be waiting at the same time
+#ifndef UPDATE_DISPATCH_QUEUE_SIZE
+#define UPDATE_DISPATCH_QUEUE_SIZE 8
+#endif
+
+#ifndef UPDATE_DISPATCH_STACK_SIZE
+#define UPDATE_DISPATCH_STACK_SIZE 4096
+#endif
+
+/*
+ * Runs the update handlers of opted in services on a worker task instead of the task
+ * which made the update, see StatefulService::deferUpdateHandlers().
+ *
+ * A service is queued at most once. Updates made while it waits are coalesced into
+ * the pending dispatch, which gets the changed fields of all of them and keeps the
+ * origin if all of them came from the same one, ORIGIN_NONE otherwise. The handlers
+ * read the state when they run, so they always see the latest one.
+ */
+namespace update_dispatcher {
+
+// One per service, owned by the service
+struct PendingUpdate {
+    InlineFunction<void(origin_id_t originId, field_mask_t fields)> dispatch;
+    origin_id_t originId {ORIGIN_NONE};
+    field_mask_t fields {0};
+    uint32_t queuedAt {0};
+    bool queued {false};
+};
+
+// Starts the worker, services scheduled before run their handlers inline
+void begin();
+
+// Queues the handlers of a service or merges the update into its pending dispatch
+void schedule(PendingUpdate &pending, origin_id_t originId, field_mask_t fields);
+
+// Dispatches, coalesced updates and the wait and run time of the handlers
+void metrics(JsonObject &root);
+
+} // namespace update_dispatcher
+
+#endif
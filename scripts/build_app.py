@@ -17,6 +17,7 @@ from shutil import copytree, rmtree, copyfileobj
 from os.path import exists, getmtime
 import os
 import gzip
+import hashlib
 import mimetypes
 import glob
 from datetime import datetime
@@ -88,8 +89,135 @@ def build_webapp():
         )
 
 
+def fnv1a(seed, text):
+    # Must match WWWData::hash in the generated header
+    h = (2166136261 ^ seed) & 0xFFFFFFFF
+    for byte in text.encode():
+        h = ((h ^ byte) * 16777619) & 0xFFFFFFFF
+    return h
+
+
+def perfect_hash(keys):
+    """Hash and displace: keys are grouped into buckets by hash(0, key), then every bucket,
+    largest first, gets the smallest seed which puts all of its keys into free slots."""
+    size = len(keys)
+    buckets = [[] for _ in range(max(1, size // 2))]
+    for key in keys:
+        buckets[fnv1a(0, key) % len(buckets)].append(key)
+
+    seeds = [0] * len(buckets)
+    slots = [None] * size
+    for index in sorted(range(len(buckets)), key=lambda i: -len(buckets[i])):
+        bucket = buckets[index]
+        if not bucket:
+            continue
+        seed = 1
+        while True:
+            positions = [fnv1a(seed, key) % size for key in bucket]
+            if len(set(positions)) == len(positions) and all(slots[p] is None for p in positions):
+                break
+            seed += 1
+        seeds[index] = seed
+        for key, position in zip(bucket, positions):
+            slots[position] = key
+    return seeds, slots
+
+
+def write_asset_table(progmem, assetMap):
+    seeds, slots = perfect_hash([f"/{asset_path}" for asset_path in assetMap])
+
+    progmem.write("struct WWWAsset {\n")
+    progmem.write("\tconst char *uri;\n")
+    progmem.write("\tconst char *contentType;\n")
+    progmem.write("\tconst uint8_t *content; // gzip\n")
+    progmem.write("\tsize_t len;\n")
+    progmem.write("\tconst char *etag; // quoted content hash of the uncompressed file, tagged with the encoding\n")
+    progmem.write("\tconst uint8_t *brotli; // nullptr unless built with EMBED_WWW_BROTLI\n")
+    progmem.write("\tsize_t brotliLen;\n")
+    progmem.write("\tconst char *brotliEtag;\n")
+    progmem.write("};\n\n")
+
+    progmem.write(
+        "typedef std::function<void(const String& uri, const String& contentType, const uint8_t * content, size_t len)> RouteRegistrationHandler;\n\n"
+    )
+    progmem.write("class WWWData {\n")
+    progmem.write("\tpublic:\n")
+    progmem.write(f"\t\tstatic constexpr size_t assetCount = {len(slots)};\n\n")
+
+    # O(1) lookup: the bucket seed picks the slot, the uri is compared once to reject unknown paths
+    progmem.write("\t\tstatic const WWWAsset *find(const char *uri, size_t len) {\n")
+    progmem.write("\t\t\tif (!assetCount) return nullptr;\n")
+    progmem.write(
+        "\t\t\tconst WWWAsset &asset = assets[hash(seeds[hash(0, uri, len) % seedCount], uri, len) % assetCount];\n"
+    )
+    progmem.write(
+        "\t\t\treturn strlen(asset.uri) == len && !strncmp(asset.uri, uri, len) ? &asset : nullptr;\n"
+    )
+    progmem.write("\t\t}\n\n")
+
+    progmem.write("\t\tstatic void registerRoutes(RouteRegistrationHandler handler) {\n")
+    progmem.write("\t\t\tfor (const WWWAsset &asset : assets) {\n")
+    progmem.write("\t\t\t\thandler(asset.uri, asset.contentType, asset.content, asset.len);\n")
+    progmem.write("\t\t\t}\n")
+    progmem.write("\t\t}\n\n")
+
+    progmem.write("\tprivate:\n")
+    progmem.write(f"\t\tstatic constexpr size_t seedCount = {len(seeds)};\n")
+    progmem.write("\t\tstatic constexpr uint32_t seeds[seedCount] = {")
+    progmem.write(", ".join(str(seed) for seed in seeds))
+    progmem.write("};\n")
+    progmem.write("\t\tstatic constexpr WWWAsset assets[assetCount] = {\n")
+    for uri in slots:
+        asset = assetMap[uri[1:]]
+        brotli = asset.get("brotli_name", "nullptr")
+        # each encoding is a different body, so they can't share a strong tag
+        brotli_etag = f'"\\"{asset["etag"]}-br\\""' if "brotli_name" in asset else "nullptr"
+        progmem.write(
+            f'\t\t\t{{"{uri}", "{asset["mime"]}", {asset["name"]}, {asset["size"]}, "\\"{asset["etag"]}-gz\\"", '
+            f'{brotli}, {asset.get("brotli_size", 0)}, {brotli_etag}}},\n'
+        )
+    progmem.write("\t\t};\n\n")
+
+    progmem.write("\t\tstatic constexpr uint32_t hash(uint32_t seed, const char *text, size_t len) {\n")
+    progmem.write("\t\t\tuint32_t h = 2166136261u ^ seed;\n")
+    progmem.write("\t\t\tfor (size_t i = 0; i < len; i++) h = (h ^ (uint8_t)text[i]) * 16777619u;\n")
+    progmem.write("\t\t\treturn h;\n")
+    progmem.write("\t\t}\n")
+    progmem.write("};\n\n")
+
+
+def write_bytes(progmem, name, data):
+    progmem.write(f"const uint8_t {name}[] = {{\n\t")
+    for i, byte in enumerate(data):
+        if i and not (i % 16):
+            progmem.write("\n\t")
+        progmem.write(f"0x{byte:02X},")
+    progmem.write("\n};\n\n")
+
+
+def content_hash(data):
+    return hashlib.sha256(data).hexdigest()[:16]
+
+
+def report_footprint(assetMap):
+    gzip_size = sum(asset["size"] for asset in assetMap.values())
+    brotli_size = sum(asset.get("brotli_size", 0) for asset in assetMap.values())
+    footprint = f"gzip {gzip_size} bytes"
+    if brotli_size:
+        footprint += f", brotli {brotli_size} bytes, total {gzip_size + brotli_size} bytes"
+    print(f"Embedded {len(assetMap)} assets: {footprint}")
+    return footprint
+
+
 def build_progmem():
     mimetypes.init()
+    brotli = None
+    if flag_exists("EMBED_WWW_BROTLI"):
+        try:
+            import brotli
+        except ImportError:
+            print("EMBED_WWW_BROTLI is set but the brotli module is missing (pip install brotli), embedding gzip only")
+
     with open(output_file, "w") as progmem:
         progmem.write("#include <functional>\n")
         progmem.write("#include <Arduino.h>\n")
@@ -103,39 +231,30 @@ def build_progmem():
             )
             print(f"Converting {asset_path}")
 
+            raw_data = path.read_bytes()
             asset_var = f"ESP_SVELTEKIT_DATA_{idx}"
             progmem.write(f"// {asset_path}\n")
-            progmem.write(f"const uint8_t {asset_var}[] = {{\n\t")
-            file_data = gzip.compress(path.read_bytes())
-
-            for i, byte in enumerate(file_data):
-                if i and not (i % 16):
-                    progmem.write("\n\t")
-                progmem.write(f"0x{byte:02X},")
-
-            progmem.write("\n};\n\n")
+            # mtime=0 keeps the output identical between builds of the same app
+            file_data = gzip.compress(raw_data, mtime=0)
+            write_bytes(progmem, asset_var, file_data)
             assetMap[asset_path] = {
                 "name": asset_var,
                 "mime": asset_mime,
                 "size": len(file_data),
+                "etag": content_hash(raw_data),
             }
 
-        progmem.write(
-            "typedef std::function<void(const String& uri, const String& contentType, const uint8_t * content, size_t len)> RouteRegistrationHandler;\n\n"
-        )
-        progmem.write("class WWWData {\n")
-        progmem.write("\tpublic:\n")
-        progmem.write(
-            "\t\tstatic void registerRoutes(RouteRegistrationHandler handler) {\n"
-        )
-
-        for asset_path, asset in assetMap.items():
-            progmem.write(
-                f'\t\t\thandler("/{asset_path}", "{asset["mime"]}", {asset["name"]}, {asset["size"]});\n'
-            )
-
-        progmem.write("\t\t}\n")
-        progmem.write("};\n\n")
+            # Only worth the flash if it beats gzip
+            if brotli:
+                brotli_data = brotli.compress(raw_data, quality=11)
+                if len(brotli_data) < len(file_data):
+                    brotli_var = f"ESP_SVELTEKIT_BROTLI_{idx}"
+                    write_bytes(progmem, brotli_var, brotli_data)
+                    assetMap[asset_path]["brotli_name"] = brotli_var
+                    assetMap[asset_path]["brotli_size"] = len(brotli_data)
+
+        progmem.write(f"// Footprint: {report_footprint(assetMap)}\n\n")
+        write_asset_table(progmem, assetMap)
 
 
 def add_app_to_filesystem():
@@ -0,0 +1,108 @@
+"""Minimal MQTT 3.1.1 broker stand-in for trying the offline spool without a real broker.
+
+Accepts any client and acknowledges CONNECT, PUBLISH with QoS 0 and 1, SUBSCRIBE and PINGREQ.
+Every publish is appended to the log as "<topic> <payload>", nothing is forwarded to subscribers.
+Stop and start it again to drop the connection like a broker restart.
+
+    python3 scripts/mqtt_broker.py --port 1883 --log broker.log
+    python3 scripts/mqtt_broker.py --log broker.log --check
+
+--check reports the messages in the log, the duplicates among them, the gaps in their sequence
+numbers and whether they first arrived in order. Messages without the key are left out.
+"""
+
+import argparse
+import asyncio
+import json
+import sys
+
+
+async def read_packet(reader):
+    header = (await reader.readexactly(1))[0]
+    multiplier, length = 1, 0
+    while True:
+        byte = (await reader.readexactly(1))[0]
+        length += (byte & 127) * multiplier
+        multiplier *= 128
+        if not byte & 128:
+            break
+    return header, await reader.readexactly(length)
+
+
+def serve(port, log):
+    async def client(reader, writer):
+        try:
+            while True:
+                header, body = await read_packet(reader)
+                kind = header >> 4
+                if kind == 1:  # CONNECT
+                    writer.write(bytes([0x20, 2, 0, 0]))
+                elif kind == 3:  # PUBLISH
+                    qos = (header >> 1) & 3
+                    topic_length = int.from_bytes(body[:2], "big")
+                    topic = body[2 : 2 + topic_length].decode()
+                    payload = 2 + topic_length
+                    if qos:
+                        writer.write(bytes([0x40, 2]) + body[payload : payload + 2])
+                        payload += 2
+                    log.write(f"{topic} {body[payload:].decode(errors='replace')}\n")
+                elif kind == 8:  # SUBSCRIBE, granted with QoS 1
+                    writer.write(bytes([0x90, 3]) + body[:2] + bytes([1]))
+                elif kind == 12:  # PINGREQ
+                    writer.write(bytes([0xD0, 0]))
+                elif kind == 14:  # DISCONNECT
+                    break
+                await writer.drain()
+        except (asyncio.IncompleteReadError, ConnectionResetError):
+            pass
+        writer.close()
+
+    async def main():
+        server = await asyncio.start_server(client, "0.0.0.0", port)
+        print(f"Listening on port {port}, logging to {log.name}")
+        async with server:
+            await server.serve_forever()
+
+    try:
+        asyncio.run(main())
+    except KeyboardInterrupt:
+        pass
+
+
+def check(path, key, topic):
+    received, seen, first = 0, set(), []
+    for line in open(path):
+        name, _, payload = line.rstrip("\n").partition(" ")
+        if topic and topic not in name:
+            continue
+        try:
+            seq = json.loads(payload)[key]
+        except (ValueError, KeyError, TypeError):
+            continue
+        received += 1
+        if (name, payload) in seen:
+            continue
+        seen.add((name, payload))
+        first.append(seq)
+    if not first:
+        print("no messages")
+        return 1
+    numbers = set(first)
+    missing = len(set(range(min(numbers), max(numbers) + 1)) - numbers)
+    in_order = all(a <= b for a, b in zip(first, first[1:]))
+    print(f"received {received} unique {len(seen)} duplicates {received - len(seen)} "
+          f"missing {missing} in order {in_order}")
+    return 0 if in_order and not missing else 1
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--port", type=int, default=1883)
+    parser.add_argument("--log", default="broker.log")
+    parser.add_argument("--check", action="store_true", help="report on the log instead of serving")
+    parser.add_argument("--key", default="seq", help="sequence number in the JSON payloads")
+    parser.add_argument("--topic", help="only check topics containing this")
+    args = parser.parse_args()
+    if args.check:
+        sys.exit(check(args.log, args.key, args.topic))
+    serve(args.port, open(args.log, "a", buffering=1))
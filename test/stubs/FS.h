@@ -0,0 +1,46 @@
+#pragma once
+
+// Host stand-in for the Arduino file system API, the files of an FS live in a directory of the host
+
+#include <memory>
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+
+namespace fs {
+
+class File {
+  public:
+    File() {}
+    explicit File(FILE *file) : _file(file, fclose) {}
+
+    operator bool() const { return (bool)_file; }
+
+    bool seek(uint32_t position) { return _file && fseek(_file.get(), position, SEEK_SET) == 0; }
+    size_t read(uint8_t *buffer, size_t size) { return _file ? fread(buffer, 1, size, _file.get()) : 0; }
+    size_t write(const uint8_t *buffer, size_t size) { return _file ? fwrite(buffer, 1, size, _file.get()) : 0; }
+    void close() { _file.reset(); }
+
+  private:
+    std::shared_ptr<FILE> _file;
+};
+
+class FS {
+  public:
+    explicit FS(const char *root) : _root(root) {}
+
+    File open(const char *path, const char *mode = "r") {
+        FILE *file = fopen((_root + path).c_str(), mode);
+        return file ? File(file) : File();
+    }
+    bool exists(const char *path) { return File(fopen((_root + path).c_str(), "r")); }
+    bool remove(const char *path) { return ::remove((_root + path).c_str()) == 0; }
+
+  private:
+    std::string _root;
+};
+
+} // namespace fs
+
+using fs::File;
+using fs::FS;
@@ -0,0 +1,41 @@
+#pragma once
+
+// Host stand-in for the IPAddress of the ESP32 Arduino core, IPv4 only
+
+#include <Arduino.h>
+#include <stdint.h>
+#include <stdio.h>
+
+class IPAddress {
+  public:
+    IPAddress() {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : _address(a | b << 8 | c << 16 | (uint32_t)d << 24) {}
+    IPAddress(uint32_t address) : _address(address) {}
+
+    operator uint32_t() const { return _address; }
+    bool operator==(const IPAddress &other) const { return _address == other._address; }
+    bool operator!=(const IPAddress &other) const { return _address != other._address; }
+
+    bool fromString(const char *text) {
+        unsigned int a, b, c, d;
+        char end;
+        if (sscanf(text, "%u.%u.%u.%u%c", &a, &b, &c, &d, &end) != 4 || a > 255 || b > 255 || c > 255 || d > 255) {
+            return false;
+        }
+        *this = IPAddress(a, b, c, d);
+        return true;
+    }
+    bool fromString(const String &text) { return fromString(text.c_str()); }
+
+    String toString() const {
+        char text[16];
+        snprintf(text, sizeof(text), "%u.%u.%u.%u", (unsigned)(_address & 0xff), (unsigned)(_address >> 8 & 0xff),
+                 (unsigned)(_address >> 16 & 0xff), (unsigned)(_address >> 24));
+        return text;
+    }
+
+  private:
+    uint32_t _address {0};
+};
+
+const IPAddress INADDR_NONE(0, 0, 0, 0);
@@ -0,0 +1,7 @@
+#pragma once
+
+// Host stand-in for LittleFS, its root is the temporary directory of the host
+
+#include <FS.h>
+
+inline fs::FS LittleFS(P_tmpdir);
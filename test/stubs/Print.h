@@ -0,0 +1,30 @@
+#pragma once
+
+// Host stand-in for the Arduino Print, subclasses only implement the buffer write
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <stdio.h>
+
+class Print {
+  public:
+    virtual ~Print() {}
+
+    virtual size_t write(const uint8_t *buffer, size_t size) = 0;
+    virtual size_t write(uint8_t c) { return write(&c, 1); }
+
+    size_t print(long value) { return printf("%ld", value); }
+    size_t print(unsigned long value) { return printf("%lu", value); }
+    size_t print(int value) { return print((long)value); }
+    size_t print(unsigned int value) { return print((unsigned long)value); }
+
+    size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3))) {
+        char buffer[64];
+        va_list args;
+        va_start(args, format);
+        int len = vsnprintf(buffer, sizeof(buffer), format, args);
+        va_end(args);
+        return write((const uint8_t *)buffer, len < (int)sizeof(buffer) ? len : sizeof(buffer) - 1);
+    }
+};
@@ -0,0 +1,94 @@
+#pragma once
+
+// Host stand-in for PsychicMqttClient. Publishes and subscriptions are recorded instead of sent, the test
+// connects, disconnects, refuses publishes, acknowledges them and delivers messages.
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class PsychicMqttClient {
+  public:
+    struct Message {
+        std::string topic;
+        int qos;
+        bool retain;
+        std::string payload;
+        int msgId;
+    };
+
+    typedef std::function<void(bool sessionPresent)> OnConnectUserCallback;
+    typedef std::function<void(int msgId)> OnPublishUserCallback;
+    typedef std::function<void(char *topic, char *payload, int retain, int qos, bool dup)> OnMessageUserCallback;
+
+    PsychicMqttClient &onConnect(OnConnectUserCallback callback) {
+        _onConnect.push_back(callback);
+        return *this;
+    }
+
+    PsychicMqttClient &onPublish(OnPublishUserCallback callback) {
+        _onPublish.push_back(callback);
+        return *this;
+    }
+
+    PsychicMqttClient &onMessage(OnMessageUserCallback callback) {
+        _onMessage.push_back(callback);
+        return *this;
+    }
+
+    bool connected() { return _connected; }
+
+    int subscribe(const char *topic, int qos) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        subscriptions.push_back(topic);
+        return ++_lastId;
+    }
+
+    // The message id for QoS 1 and 2, 0 for QoS 0 and -1 if the client refused it
+    int publish(const char *topic, int qos, bool retain, const char *payload = nullptr, int length = 0,
+                bool async = true) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_connected || refuse) return -1;
+        int msgId = qos ? ++_lastId : 0;
+        published.push_back({topic, qos, retain, std::string(payload, length), msgId});
+        return msgId;
+    }
+
+    void connect() {
+        _connected = true;
+        for (auto &callback : _onConnect) callback(false);
+    }
+
+    void disconnect() { _connected = false; }
+
+    void acknowledge(int msgId) {
+        for (auto &callback : _onPublish) callback(msgId);
+    }
+
+    void receive(const char *topic, const char *payload, bool retain = false) {
+        std::string topicCopy(topic), payloadCopy(payload);
+        for (auto &callback : _onMessage) callback(&topicCopy[0], &payloadCopy[0], retain, 0, false);
+    }
+
+    // Taken from the published messages, so a test only sees the ones since it last asked
+    std::vector<Message> take() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        std::vector<Message> messages;
+        messages.swap(published);
+        return messages;
+    }
+
+    std::atomic<bool> refuse {false};
+    std::vector<Message> published;
+    std::vector<std::string> subscriptions;
+
+  private:
+    std::mutex _mutex;
+    std::vector<OnConnectUserCallback> _onConnect;
+    std::vector<OnPublishUserCallback> _onPublish;
+    std::vector<OnMessageUserCallback> _onMessage;
+    std::atomic<bool> _connected {false};
+    int _lastId {0};
+};
@@ -0,0 +1,8 @@
+#pragma once
+
+// Host stand-in for the Arduino String. std::string shares the members the modules under test use, and
+// ArduinoJson reads and writes it natively.
+
+#include <string>
+
+typedef std::string String;
@@ -0,0 +1,13 @@
+#pragma once
+
+// Host stand-in for the parts of the ESP32 HAL and sdkconfig used by the modules under test
+
+#include <random>
+#include <stdint.h>
+
+#define CONFIG_IDF_TARGET_ESP32 1
+
+inline uint32_t esp_random() {
+    static std::random_device device;
+    return device();
+}
@@ -0,0 +1,3 @@
+#pragma once
+
+// Included by global.h for the reset reasons, which no host test uses
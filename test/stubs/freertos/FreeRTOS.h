@@ -0,0 +1,75 @@
+#pragma once
+
+// Host stand-in for the FreeRTOS semaphores, queues, tasks and critical sections, built on the C++ thread library.
+// One tick is one millisecond.
+
+#include <Arduino.h>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS pdTRUE
+#define portMAX_DELAY ((TickType_t)0xffffffffUL)
+#define portTICK_PERIOD_MS 1
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+#define tskIDLE_PRIORITY 0
+
+namespace freertos_host {
+
+// Waits on the condition until the predicate holds or the ticks passed, portMAX_DELAY waits forever
+template <typename Predicate>
+bool waitFor(std::condition_variable &condition, std::unique_lock<std::mutex> &lock, TickType_t ticks,
+             Predicate predicate) {
+    if (ticks == portMAX_DELAY) {
+        condition.wait(lock, predicate);
+        return true;
+    }
+    return condition.wait_for(lock, std::chrono::milliseconds(ticks), predicate);
+}
+
+struct Semaphore {
+    std::mutex mutex;
+    std::condition_variable condition;
+    unsigned count;
+    bool recursive;
+    std::thread::id holder;
+    unsigned depth {0};
+
+    Semaphore(unsigned count, bool recursive) : count(count), recursive(recursive) {}
+};
+
+struct Queue {
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::deque<std::vector<uint8_t>> items;
+    size_t length;
+    size_t itemSize;
+};
+
+struct Task {
+    std::mutex mutex;
+    std::condition_variable condition;
+    uint32_t notifications {0};
+};
+
+inline Task *currentTask() {
+    static thread_local Task task;
+    return &task;
+}
+
+} // namespace freertos_host
+
+// Critical sections nest across muxes on ESP32, a recursive mutex per mux is close enough for tests
+typedef std::recursive_mutex portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED {}
+#define portENTER_CRITICAL(mux) (mux)->lock()
+#define portEXIT_CRITICAL(mux) (mux)->unlock()
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <freertos/FreeRTOS.h>
+
+typedef freertos_host::Queue *QueueHandle_t;
+
+inline QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize) {
+    QueueHandle_t queue = new freertos_host::Queue();
+    queue->length = length;
+    queue->itemSize = itemSize;
+    return queue;
+}
+
+inline BaseType_t xQueueSend(QueueHandle_t queue, const void *item, TickType_t ticks) {
+    std::unique_lock<std::mutex> lock(queue->mutex);
+    if (!freertos_host::waitFor(queue->condition, lock, ticks, [&] { return queue->items.size() < queue->length; })) {
+        return pdFALSE;
+    }
+    const uint8_t *bytes = (const uint8_t *)item;
+    queue->items.emplace_back(bytes, bytes + queue->itemSize);
+    queue->condition.notify_all();
+    return pdTRUE;
+}
+
+inline BaseType_t xQueueReceive(QueueHandle_t queue, void *item, TickType_t ticks) {
+    std::unique_lock<std::mutex> lock(queue->mutex);
+    if (!freertos_host::waitFor(queue->condition, lock, ticks, [&] { return !queue->items.empty(); })) {
+        return pdFALSE;
+    }
+    memcpy(item, queue->items.front().data(), queue->itemSize);
+    queue->items.pop_front();
+    queue->condition.notify_all();
+    return pdTRUE;
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <freertos/FreeRTOS.h>
+
+typedef freertos_host::Semaphore *SemaphoreHandle_t;
+
+inline SemaphoreHandle_t xSemaphoreCreateMutex() { return new freertos_host::Semaphore(1, false); }
+inline SemaphoreHandle_t xSemaphoreCreateBinary() { return new freertos_host::Semaphore(0, false); }
+inline SemaphoreHandle_t xSemaphoreCreateRecursiveMutex() { return new freertos_host::Semaphore(1, true); }
+
+inline BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks) {
+    std::unique_lock<std::mutex> lock(semaphore->mutex);
+    if (!freertos_host::waitFor(semaphore->condition, lock, ticks, [&] { return semaphore->count > 0; })) {
+        return pdFALSE;
+    }
+    semaphore->count--;
+    return pdTRUE;
+}
+
+inline BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore) {
+    std::lock_guard<std::mutex> lock(semaphore->mutex);
+    semaphore->count++;
+    semaphore->condition.notify_one();
+    return pdTRUE;
+}
+
+inline BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t semaphore, TickType_t ticks) {
+    std::unique_lock<std::mutex> lock(semaphore->mutex);
+    std::thread::id self = std::this_thread::get_id();
+    if (semaphore->depth && semaphore->holder == self) {
+        semaphore->depth++;
+        return pdTRUE;
+    }
+    if (!freertos_host::waitFor(semaphore->condition, lock, ticks, [&] { return semaphore->depth == 0; })) {
+        return pdFALSE;
+    }
+    semaphore->holder = self;
+    semaphore->depth = 1;
+    return pdTRUE;
+}
+
+inline BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t semaphore) {
+    std::lock_guard<std::mutex> lock(semaphore->mutex);
+    if (!semaphore->depth || semaphore->holder != std::this_thread::get_id()) return pdFALSE;
+    if (--semaphore->depth == 0) semaphore->condition.notify_one();
+    return pdTRUE;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <freertos/FreeRTOS.h>
+
+typedef freertos_host::Task *TaskHandle_t;
+typedef void (*TaskFunction_t)(void *);
+
+inline TaskHandle_t xTaskGetCurrentTaskHandle() { return freertos_host::currentTask(); }
+
+// The task runs on a detached thread, core and priority are ignored
+inline BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char *name, uint32_t stackSize,
+                                          void *parameter, UBaseType_t priority, TaskHandle_t *handle, int core) {
+    std::mutex started;
+    std::condition_variable condition;
+    TaskHandle_t task = nullptr;
+    std::thread([&, function, parameter] {
+        {
+            std::lock_guard<std::mutex> lock(started);
+            task = freertos_host::currentTask();
+            condition.notify_one();
+        }
+        function(parameter);
+    }).detach();
+    std::unique_lock<std::mutex> lock(started);
+    condition.wait(lock, [&] { return task != nullptr; });
+    if (handle) *handle = task;
+    return pdPASS;
+}
+
+inline BaseType_t xTaskCreate(TaskFunction_t function, const char *name, uint32_t stackSize, void *parameter,
+                              UBaseType_t priority, TaskHandle_t *handle) {
+    return xTaskCreatePinnedToCore(function, name, stackSize, parameter, priority, handle, 0);
+}
+
+inline void xTaskNotifyGive(TaskHandle_t task) {
+    std::lock_guard<std::mutex> lock(task->mutex);
+    task->notifications++;
+    task->condition.notify_one();
+}
+
+inline uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t ticks) {
+    TaskHandle_t task = freertos_host::currentTask();
+    std::unique_lock<std::mutex> lock(task->mutex);
+    freertos_host::waitFor(task->condition, lock, ticks, [&] { return task->notifications > 0; });
+    uint32_t notifications = task->notifications;
+    if (notifications) task->notifications = clear ? 0 : notifications - 1;
+    return notifications;
+}
+
+inline TickType_t xTaskGetTickCount() { return millis(); }
+
+inline void vTaskDelay(TickType_t ticks) { delay(ticks); }
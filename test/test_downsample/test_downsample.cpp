@@ -0,0 +1,121 @@
+#include <chrono>
+#include <downsample.h>
+#include <stdio.h>
+#include <unity.h>
+#include <vector>
+
+// Downsampling a session of 100k steps like GET /api/v1/steps/series, with the timings printed for comparison
+
+#define STEPS 100000
+#define RUNS 20
+
+// The same as SessionSpeedReader in pedometer_data.h, x adds up the intervals and y is the speed
+struct IntervalReader {
+    const float *times;
+    float circumference;
+    double elapsed {0};
+
+    SeriesPoint next() {
+        float interval = *times++;
+        elapsed += interval;
+        return {(float)elapsed, interval > 0 ? circumference / interval : 0};
+    }
+};
+
+// A run with speed ups and pauses, deterministic so every run downsamples the same session
+static std::vector<float> session() {
+    std::vector<float> times(STEPS);
+    uint32_t seed = 1;
+    for (size_t i = 0; i < times.size(); i++) {
+        seed = seed * 1664525u + 1013904223u;
+        float pace = 0.15f + 0.1f * sinf(i / 500.0f);
+        times[i] = pace + (seed >> 8) / float(1 << 24) * 0.05f + (i % 7919 == 0 ? 5 : 0);
+    }
+    return times;
+}
+
+template <typename Downsample>
+static double benchmark(const char *name, const std::vector<float> &times, size_t points, Downsample &&downsample) {
+    std::vector<SeriesPoint> out;
+    out.reserve(points);
+    auto start = std::chrono::steady_clock::now();
+    for (int run = 0; run < RUNS; run++) {
+        out.clear();
+        downsample(IntervalReader {times.data(), 0.6f}, times.size(), points,
+                   [&out](SeriesPoint point) { out.push_back(point); });
+    }
+    double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / RUNS;
+    printf("%-8s %6u steps -> %4u points  %8.0f us  %6.2f ns/step\n", name, STEPS, (unsigned)out.size(), us,
+           us * 1000 / STEPS);
+    return us;
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_lttb_keeps_ends_and_count() {
+    std::vector<float> times = session();
+    std::vector<SeriesPoint> out;
+    downsampleLttb(IntervalReader {times.data(), 0.6f}, times.size(), 200,
+                   [&out](SeriesPoint point) { out.push_back(point); });
+    TEST_ASSERT_EQUAL_size_t(200, out.size());
+
+    IntervalReader reader {times.data(), 0.6f};
+    SeriesPoint first = reader.next(), last = first;
+    for (size_t i = 1; i < times.size(); i++) last = reader.next();
+    TEST_ASSERT_EQUAL_FLOAT(first.x, out.front().x);
+    TEST_ASSERT_EQUAL_FLOAT(last.x, out.back().x);
+    for (size_t i = 1; i < out.size(); i++) TEST_ASSERT_TRUE(out[i].x > out[i - 1].x);
+}
+
+static void test_minmax_keeps_extremes() {
+    std::vector<float> times = session();
+    std::vector<SeriesPoint> out;
+    downsampleMinMax(IntervalReader {times.data(), 0.6f}, times.size(), 200,
+                     [&out](SeriesPoint point) { out.push_back(point); });
+    TEST_ASSERT_TRUE(out.size() <= 200);
+
+    float minY = INFINITY, maxY = -INFINITY, outMin = INFINITY, outMax = -INFINITY;
+    IntervalReader reader {times.data(), 0.6f};
+    for (size_t i = 0; i < times.size(); i++) {
+        SeriesPoint point = reader.next();
+        minY = fminf(minY, point.y);
+        maxY = fmaxf(maxY, point.y);
+    }
+    for (const SeriesPoint &point : out) {
+        outMin = fminf(outMin, point.y);
+        outMax = fmaxf(outMax, point.y);
+    }
+    TEST_ASSERT_EQUAL_FLOAT(minY, outMin);
+    TEST_ASSERT_EQUAL_FLOAT(maxY, outMax);
+    for (size_t i = 1; i < out.size(); i++) TEST_ASSERT_TRUE(out[i].x >= out[i - 1].x);
+}
+
+static void test_short_series_pass_through() {
+    float times[] = {0.2f, 0.3f, 0.4f};
+    size_t emitted = 0;
+    downsampleLttb(IntervalReader {times, 0.6f}, 3, 200, [&emitted](SeriesPoint point) { emitted++; });
+    downsampleMinMax(IntervalReader {times, 0.6f}, 3, 200, [&emitted](SeriesPoint point) { emitted++; });
+    TEST_ASSERT_EQUAL_size_t(6, emitted);
+}
+
+static void test_benchmark() {
+    std::vector<float> times = session();
+    for (size_t points : {200, 1000}) {
+        benchmark("lttb", times, points, [](auto reader, size_t count, size_t threshold, auto &&emit) {
+            downsampleLttb(reader, count, threshold, emit);
+        });
+        benchmark("minmax", times, points, [](auto reader, size_t count, size_t threshold, auto &&emit) {
+            downsampleMinMax(reader, count, threshold, emit);
+        });
+    }
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_lttb_keeps_ends_and_count);
+    RUN_TEST(test_minmax_keeps_extremes);
+    RUN_TEST(test_short_series_pass_through);
+    RUN_TEST(test_benchmark);
+    return UNITY_END();
+}
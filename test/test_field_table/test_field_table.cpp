@@ -0,0 +1,242 @@
+#include <chrono>
+#include <unity.h>
+
+#include <domain/ap_settings.h>
+#include <domain/ntp_settings.h>
+#include <domain/wifi_settings.h>
+
+// The settings read and updated through their field tables and through the code the tables replaced, which has to
+// produce the same JSON. The timings are printed for comparison.
+
+#define RUNS 20000
+
+String SettingValue::format(String value) { return value; }
+
+// The hand-written read and update before the field tables
+namespace handwritten {
+
+void readNTP(NTPSettings &settings, JsonObject &root) {
+    root["enabled"] = settings.enabled;
+    root["server"] = settings.server;
+    root["tz_label"] = settings.tzLabel;
+    root["tz_format"] = settings.tzFormat;
+}
+
+StateUpdateResult updateNTP(JsonObject &root, NTPSettings &settings) {
+    field_mask_t changed = 0;
+    updateField(settings.enabled, root["enabled"] | FACTORY_NTP_ENABLED, NTPSettings::FIELD_ENABLED, changed);
+    updateField(settings.server, root["server"] | FACTORY_NTP_SERVER, NTPSettings::FIELD_SERVER, changed);
+    updateField(settings.tzLabel, root["tz_label"] | FACTORY_NTP_TIME_ZONE_LABEL, NTPSettings::FIELD_TZ_LABEL,
+                changed);
+    updateField(settings.tzFormat, root["tz_format"] | FACTORY_NTP_TIME_ZONE_FORMAT, NTPSettings::FIELD_TZ_FORMAT,
+                changed);
+    return StateUpdateResult::changed(changed);
+}
+
+void readAP(APSettings &settings, JsonObject &root) {
+    root["provision_mode"] = settings.provisionMode;
+    root["ssid"] = settings.ssid;
+    root["password"] = settings.password;
+    root["channel"] = settings.channel;
+    root["ssid_hidden"] = settings.ssidHidden;
+    root["max_clients"] = settings.maxClients;
+    root["local_ip"] = settings.localIP.toString();
+    root["gateway_ip"] = settings.gatewayIP.toString();
+    root["subnet_mask"] = settings.subnetMask.toString();
+}
+
+StateUpdateResult updateAP(JsonObject &root, APSettings &settings) {
+    field_mask_t changed = 0;
+    updateField(settings.provisionMode, root["provision_mode"] | FACTORY_AP_PROVISION_MODE,
+                APSettings::FIELD_PROVISION_MODE, changed);
+    updateField(settings.ssid, root["ssid"] | SettingValue::format(FACTORY_AP_SSID), APSettings::FIELD_SSID, changed);
+    updateField(settings.password, root["password"] | FACTORY_AP_PASSWORD, APSettings::FIELD_PASSWORD, changed);
+    updateField(settings.channel, root["channel"] | FACTORY_AP_CHANNEL, APSettings::FIELD_CHANNEL, changed);
+    updateField(settings.ssidHidden, root["ssid_hidden"] | FACTORY_AP_SSID_HIDDEN, APSettings::FIELD_SSID_HIDDEN,
+                changed);
+    updateField(settings.maxClients, root["max_clients"] | FACTORY_AP_MAX_CLIENTS, APSettings::FIELD_MAX_CLIENTS,
+                changed);
+    IPAddress ip;
+    JsonUtils::readIP(root, "local_ip", ip, FACTORY_AP_LOCAL_IP);
+    updateField(settings.localIP, ip, APSettings::FIELD_LOCAL_IP, changed);
+    JsonUtils::readIP(root, "gateway_ip", ip, FACTORY_AP_GATEWAY_IP);
+    updateField(settings.gatewayIP, ip, APSettings::FIELD_GATEWAY_IP, changed);
+    JsonUtils::readIP(root, "subnet_mask", ip, FACTORY_AP_SUBNET_MASK);
+    updateField(settings.subnetMask, ip, APSettings::FIELD_SUBNET_MASK, changed);
+    return StateUpdateResult::changed(changed);
+}
+
+void readWiFi(WiFiSettings &settings, JsonObject &root) {
+    root["hostname"] = settings.hostname;
+    root["priority_RSSI"] = settings.priorityBySignalStrength;
+    JsonArray wifiNetworks = root["wifi_networks"].to<JsonArray>();
+    for (const auto &wifi : settings.wifiSettings) {
+        JsonObject json = wifiNetworks.add<JsonObject>();
+        json["ssid"] = wifi.ssid;
+        json["password"] = wifi.password;
+        json["static_ip_config"] = wifi.staticIPConfig;
+        if (wifi.staticIPConfig) {
+            JsonUtils::writeIP(json, "local_ip", wifi.localIP);
+            JsonUtils::writeIP(json, "gateway_ip", wifi.gatewayIP);
+            JsonUtils::writeIP(json, "subnet_mask", wifi.subnetMask);
+            JsonUtils::writeIP(json, "dns_ip_1", wifi.dnsIP1);
+            JsonUtils::writeIP(json, "dns_ip_2", wifi.dnsIP2);
+        }
+    }
+}
+
+} // namespace handwritten
+
+template <typename T, typename Reader>
+static std::string serialized(T &settings, Reader reader) {
+    JsonDocument doc;
+    JsonObject root = doc.to<JsonObject>();
+    reader(settings, root);
+    std::string json;
+    serializeJson(doc, json);
+    return json;
+}
+
+struct StringPrint : Print {
+    std::string text;
+
+    size_t write(const uint8_t *buffer, size_t size) override {
+        text.append((const char *)buffer, size);
+        return size;
+    }
+};
+
+template <typename T>
+static std::string streamed(T &settings) {
+    StringPrint out;
+    JsonStreamWriter json(out);
+    field_table::streamValue(settings, json);
+    return out.text;
+}
+
+template <typename T>
+static T defaults() {
+    JsonDocument doc;
+    JsonObject root = doc.to<JsonObject>();
+    T settings {};
+    T::update(root, settings);
+    return settings;
+}
+
+static std::vector<wifi_settings_t> networks(size_t count) {
+    std::vector<wifi_settings_t> networks;
+    for (size_t i = 0; i < count; i++) {
+        wifi_settings_t network = createDefaultWiFiSettings();
+        network.ssid = "network " + std::to_string(i);
+        network.password = "secret";
+        if (i % 2) {
+            network.staticIPConfig = true;
+            network.localIP = IPAddress(192, 168, 1, 10 + i);
+            network.gatewayIP = IPAddress(192, 168, 1, 1);
+            network.subnetMask = IPAddress(255, 255, 255, 0);
+            network.dnsIP1 = IPAddress(192, 168, 1, 1);
+        }
+        networks.push_back(network);
+    }
+    return networks;
+}
+
+template <typename T>
+static double nanoseconds(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / RUNS;
+}
+
+// Reads into a document and serializes it, then applies the serialized settings back, like GET and POST do
+template <typename T, typename Reader, typename Updater>
+static void benchmark(const char *name, T settings, Reader reader, Updater updater) {
+    std::string json = serialized(settings, reader);
+    JsonDocument request;
+    deserializeJson(request, json);
+    JsonObject root = request.as<JsonObject>();
+
+    auto start = std::chrono::steady_clock::now();
+    size_t bytes = 0;
+    for (int i = 0; i < RUNS; i++) bytes += serialized(settings, reader).size();
+    double read = nanoseconds<T>(start);
+
+    start = std::chrono::steady_clock::now();
+    field_mask_t changed = 0;
+    for (int i = 0; i < RUNS; i++) changed |= updater(root, settings).fields();
+    double update = nanoseconds<T>(start);
+
+    printf("%-24s read %7.0f ns  update %7.0f ns  %zu bytes\n", name, read, update, bytes / RUNS);
+    TEST_ASSERT_EQUAL_UINT32(0, changed);
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_ap_json_is_unchanged() {
+    APSettings settings = defaults<APSettings>();
+    TEST_ASSERT_EQUAL_STRING(serialized(settings, handwritten::readAP).c_str(),
+                             serialized(settings, APSettings::read).c_str());
+    TEST_ASSERT_EQUAL_STRING(serialized(settings, APSettings::read).c_str(), streamed(settings).c_str());
+
+    // unset addresses were written too, the UI shows them as 0.0.0.0
+    settings.gatewayIP = INADDR_NONE;
+    std::string json = serialized(settings, APSettings::read);
+    TEST_ASSERT_EQUAL_STRING(serialized(settings, handwritten::readAP).c_str(), json.c_str());
+    TEST_ASSERT_TRUE(json.find("\"gateway_ip\":\"0.0.0.0\"") != std::string::npos);
+    TEST_ASSERT_EQUAL_STRING(json.c_str(), streamed(settings).c_str());
+}
+
+static void test_wifi_json_is_unchanged() {
+    WiFiSettings settings = defaults<WiFiSettings>();
+    settings.wifiSettings = networks(WIFI_MAX_NETWORKS);
+    std::string json = serialized(settings, WiFiSettings::read);
+    TEST_ASSERT_EQUAL_STRING(serialized(settings, handwritten::readWiFi).c_str(), json.c_str());
+    TEST_ASSERT_EQUAL_STRING(json.c_str(), streamed(settings).c_str());
+    // networks without a static IP have no addresses, the DNS servers of static ones only if set
+    TEST_ASSERT_TRUE(json.find("\"static_ip_config\":false,\"local_ip\"") == std::string::npos);
+    TEST_ASSERT_TRUE(json.find("dns_ip_2") == std::string::npos);
+}
+
+static void test_ntp_json_is_unchanged() {
+    NTPSettings settings = defaults<NTPSettings>();
+    TEST_ASSERT_EQUAL_STRING(serialized(settings, handwritten::readNTP).c_str(),
+                             serialized(settings, NTPSettings::read).c_str());
+}
+
+static void test_wifi_networks_compared_after_the_cut() {
+    WiFiSettings settings = defaults<WiFiSettings>();
+    settings.wifiSettings = networks(WIFI_MAX_NETWORKS);
+
+    // the stored networks and two more, which are dropped
+    WiFiSettings posted = settings;
+    posted.wifiSettings = networks(WIFI_MAX_NETWORKS + 2);
+    JsonDocument doc;
+    deserializeJson(doc, serialized(posted, WiFiSettings::read));
+    JsonObject root = doc.as<JsonObject>();
+    StateUpdateResult result = WiFiSettings::update(root, settings);
+    TEST_ASSERT_EQUAL_size_t(WIFI_MAX_NETWORKS, settings.wifiSettings.size());
+    TEST_ASSERT_TRUE(result == StateUpdateResult::UNCHANGED);
+
+    // a change within the kept networks is still reported
+    posted.wifiSettings[0].password = "changed";
+    deserializeJson(doc, serialized(posted, WiFiSettings::read));
+    root = doc.as<JsonObject>();
+    result = WiFiSettings::update(root, settings);
+    TEST_ASSERT_EQUAL_UINT32(WiFiSettings::FIELD_NETWORKS, result.fields());
+}
+
+static void test_benchmark() {
+    benchmark("NTP field table", defaults<NTPSettings>(), NTPSettings::read, NTPSettings::update);
+    benchmark("NTP hand-written", defaults<NTPSettings>(), handwritten::readNTP, handwritten::updateNTP);
+    benchmark("AP field table", defaults<APSettings>(), APSettings::read, APSettings::update);
+    benchmark("AP hand-written", defaults<APSettings>(), handwritten::readAP, handwritten::updateAP);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_ap_json_is_unchanged);
+    RUN_TEST(test_wifi_json_is_unchanged);
+    RUN_TEST(test_ntp_json_is_unchanged);
+    RUN_TEST(test_wifi_networks_compared_after_the_cut);
+    RUN_TEST(test_benchmark);
+    return UNITY_END();
+}
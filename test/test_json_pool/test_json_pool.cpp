@@ -0,0 +1,224 @@
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <unity.h>
+#include <vector>
+
+#include <json_pool.cpp>
+
+// The arenas lent to tasks, blocks freed out of order and in other tasks, and a stress run of several
+// tasks sharing the arenas with the heap fallbacks printed
+
+#define STRESS_TASKS 6
+#define STRESS_ROUNDS 20000
+
+using namespace json_pool;
+
+static void totals(uint32_t &allocations, uint32_t &heap) {
+    allocations = heap = 0;
+    for (const SiteStats &site : stats) {
+        allocations += site.allocations;
+        heap += site.heap;
+    }
+}
+
+static Arena *arenaOf(const void *pointer) { return findArena((const Header *)pointer - 1); }
+
+// Runs the function on a task of its own and waits for it
+template <typename Function>
+static void onTask(Function function) {
+    std::thread(function).join();
+}
+
+static bool returned() {
+    for (const Arena &arena : arenas) {
+        if (arena.owner || arena.used || arena.live) return false;
+    }
+    return true;
+}
+
+void setUp() {}
+void tearDown() { TEST_ASSERT_TRUE(returned()); }
+
+static void test_stack_use_stays_in_the_arena() {
+    ArduinoJson::Allocator *allocator = json_pool::allocator(SITE_HTTP);
+    uint32_t heap = stats[SITE_HTTP].heap;
+    char *first = (char *)allocator->allocate(100);
+    char *second = (char *)allocator->allocate(200);
+    memset(first, 1, 100);
+    TEST_ASSERT_NOT_NULL(arenaOf(first));
+    TEST_ASSERT_TRUE(arenaOf(first) == arenaOf(second));
+
+    // the top block grows in place, any block shrinks in place, others move
+    TEST_ASSERT_TRUE(allocator->reallocate(second, 400) == second);
+    TEST_ASSERT_TRUE(allocator->reallocate(first, 50) == first);
+    char *moved = (char *)allocator->reallocate(first, 500);
+    TEST_ASSERT_TRUE(moved != first);
+    TEST_ASSERT_EQUAL_INT(1, moved[49]);
+
+    // too large for an arena
+    void *large = allocator->allocate(JSON_POOL_ARENA_SIZE);
+    TEST_ASSERT_NULL(arenaOf(large));
+    TEST_ASSERT_EQUAL_UINT32(heap + 1, stats[SITE_HTTP].heap);
+
+    allocator->deallocate(second);
+    allocator->deallocate(moved);
+    allocator->deallocate(large);
+    TEST_ASSERT_EQUAL_UINT32(0, stats[SITE_HTTP].current);
+}
+
+static void test_blocks_freed_below_the_top() {
+    ArduinoJson::Allocator *allocator = json_pool::allocator(SITE_EVENT);
+    char *a = (char *)allocator->allocate(64);
+    char *b = (char *)allocator->allocate(64);
+    char *c = (char *)allocator->allocate(64);
+    memset(a, 'a', 64);
+    memset(c, 'c', 64);
+    Arena *arena = arenaOf(a);
+    size_t used = arena->used;
+
+    // below the top the space stays taken until the arena is empty
+    allocator->deallocate(b);
+    TEST_ASSERT_EQUAL_size_t(used, arena->used);
+    TEST_ASSERT_EQUAL_UINT32(2, arena->live);
+    TEST_ASSERT_EQUAL_INT('a', a[63]);
+    TEST_ASSERT_EQUAL_INT('c', c[0]);
+
+    // the top is given back right away and taken by the next block
+    allocator->deallocate(c);
+    char *d = (char *)allocator->allocate(64);
+    TEST_ASSERT_TRUE(d == c);
+
+    // the rest once the arena is empty
+    allocator->deallocate(d);
+    char *e = (char *)allocator->allocate(64);
+    allocator->deallocate(e);
+    allocator->deallocate(a);
+    TEST_ASSERT_EQUAL_size_t(0, arena->used);
+    TEST_ASSERT_NULL(arena->owner);
+}
+
+static void test_arena_handed_to_the_next_task() {
+    ArduinoJson::Allocator *allocator = json_pool::allocator(SITE_MQTT);
+    void *mine = allocator->allocate(32);
+    Arena *myArena = arenaOf(mine);
+    TEST_ASSERT_TRUE(myArena->owner == xTaskGetCurrentTaskHandle());
+
+    // another task gets an arena of its own and gives it back once its blocks are freed
+    Arena *otherArena = nullptr;
+    onTask([&] {
+        void *other = allocator->allocate(32);
+        otherArena = arenaOf(other);
+        allocator->deallocate(other);
+    });
+    TEST_ASSERT_NOT_NULL(otherArena);
+    TEST_ASSERT_TRUE(otherArena != myArena);
+    TEST_ASSERT_NULL(otherArena->owner);
+
+    // a task keeps its arena while it holds blocks, the next task gets the one given back
+    void *more = allocator->allocate(32);
+    TEST_ASSERT_TRUE(arenaOf(more) == myArena);
+    Arena *nextArena = nullptr;
+    onTask([&] {
+        void *other = allocator->allocate(32);
+        nextArena = arenaOf(other);
+        allocator->deallocate(other);
+    });
+    TEST_ASSERT_TRUE(nextArena == otherArena);
+
+    // a block freed by another task still counts, the last one returns the arena
+    onTask([&] { allocator->deallocate(mine); });
+    TEST_ASSERT_TRUE(myArena->owner == xTaskGetCurrentTaskHandle());
+    allocator->deallocate(more);
+    TEST_ASSERT_NULL(myArena->owner);
+}
+
+static void test_heap_while_every_arena_is_lent() {
+    ArduinoJson::Allocator *allocator = json_pool::allocator(SITE_PERSISTENCE);
+    std::vector<void *> blocks;
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool done = false;
+    std::vector<std::thread> tasks;
+    for (int i = 0; i < JSON_POOL_ARENAS; i++) {
+        tasks.emplace_back([&] {
+            void *block = allocator->allocate(32);
+            std::unique_lock<std::mutex> lock(mutex);
+            blocks.push_back(block);
+            condition.notify_all();
+            condition.wait(lock, [&] { return done; });
+            allocator->deallocate(block);
+        });
+    }
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [&] { return blocks.size() == JSON_POOL_ARENAS; });
+    }
+    for (void *block : blocks) TEST_ASSERT_NOT_NULL(arenaOf(block));
+
+    void *fallback = allocator->allocate(32);
+    TEST_ASSERT_NULL(arenaOf(fallback));
+    allocator->deallocate(fallback);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        done = true;
+        condition.notify_all();
+    }
+    for (auto &task : tasks) task.join();
+}
+
+// Random sizes, reallocations and free orders, every block keeps its contents
+static void test_stress() {
+    uint32_t allocationsBefore, heapBefore;
+    totals(allocationsBefore, heapBefore);
+    std::vector<std::thread> tasks;
+    std::vector<uint32_t> corrupted(STRESS_TASKS);
+    for (int t = 0; t < STRESS_TASKS; t++) {
+        tasks.emplace_back([t, &corrupted] {
+            std::mt19937 random(t);
+            ArduinoJson::Allocator *allocator = json_pool::allocator((Site)(t % SITE_COUNT));
+            for (int round = 0; round < STRESS_ROUNDS; round++) {
+                std::vector<std::pair<uint8_t *, size_t>> blocks;
+                int count = random() % 8 + 1;
+                for (int i = 0; i < count; i++) {
+                    size_t size = random() % 1500 + 1;
+                    uint8_t *block = (uint8_t *)allocator->allocate(size);
+                    uint8_t value = i + t;
+                    memset(block, value, size);
+                    if (random() % 3 == 0) {
+                        size_t resized = random() % 2000 + 1;
+                        block = (uint8_t *)allocator->reallocate(block, resized);
+                        for (size_t k = 0; k < std::min(size, resized); k++) corrupted[t] += block[k] != value;
+                        memset(block, value, resized);
+                        size = resized;
+                    }
+                    blocks.push_back({block, size});
+                }
+                std::shuffle(blocks.begin(), blocks.end(), random);
+                for (auto &[block, size] : blocks) {
+                    for (size_t k = 0; k < size; k++) corrupted[t] += block[k] != block[0];
+                    allocator->deallocate(block);
+                }
+            }
+        });
+    }
+    for (auto &task : tasks) task.join();
+    for (uint32_t count : corrupted) TEST_ASSERT_EQUAL_UINT32(0, count);
+
+    uint32_t allocations, heap;
+    totals(allocations, heap);
+    allocations -= allocationsBefore;
+    heap -= heapBefore;
+    printf("%d tasks on %d arenas: %u allocations, %.1f %% from the heap\n", STRESS_TASKS, JSON_POOL_ARENAS,
+           (unsigned)allocations, 100.0 * heap / allocations);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_stack_use_stays_in_the_arena);
+    RUN_TEST(test_blocks_freed_below_the_top);
+    RUN_TEST(test_arena_handed_to_the_next_task);
+    RUN_TEST(test_heap_while_every_arena_is_lent);
+    RUN_TEST(test_stress);
+    return UNITY_END();
+}
@@ -0,0 +1,81 @@
+#include <json_stream.h>
+#include <stdlib.h>
+#include <string>
+#include <unity.h>
+
+struct StringPrint : Print {
+    std::string text;
+
+    size_t write(const uint8_t *buffer, size_t size) override {
+        text.append((const char *)buffer, size);
+        return size;
+    }
+};
+
+template <typename V>
+static std::string streamed(V value) {
+    StringPrint out;
+    JsonStreamWriter json(out);
+    json.value(value);
+    return out.text;
+}
+
+// Deterministic spread of bit patterns, NaN and infinity are written as null and skipped
+static uint32_t next(uint32_t &seed) { return seed = seed * 1664525u + 1013904223u; }
+
+void setUp() {}
+void tearDown() {}
+
+static void test_floats_read_back_exactly() {
+    uint32_t seed = 1;
+    for (int i = 0; i < 100000; i++) {
+        uint32_t bits = next(seed);
+        float value;
+        memcpy(&value, &bits, sizeof(value));
+        if (isnan(value) || isinf(value)) continue;
+        std::string text = streamed(value);
+        TEST_ASSERT_TRUE_MESSAGE(strtof(text.c_str(), nullptr) == value, text.c_str());
+    }
+}
+
+static void test_doubles_read_back_exactly() {
+    uint32_t seed = 2;
+    for (int i = 0; i < 100000; i++) {
+        uint64_t bits = (uint64_t)next(seed) << 32 | next(seed);
+        double value;
+        memcpy(&value, &bits, sizeof(value));
+        if (isnan(value) || isinf(value)) continue;
+        std::string text = streamed(value);
+        TEST_ASSERT_TRUE_MESSAGE(strtod(text.c_str(), nullptr) == value, text.c_str());
+    }
+}
+
+static void test_numbers_stay_short() {
+    TEST_ASSERT_EQUAL_STRING("0.1", streamed(0.1f).c_str());
+    TEST_ASSERT_EQUAL_STRING("0.1", streamed(0.1).c_str());
+    TEST_ASSERT_EQUAL_STRING("1", streamed(1.0f).c_str());
+    TEST_ASSERT_EQUAL_STRING("0.33333334", streamed(1.0f / 3).c_str());
+    TEST_ASSERT_EQUAL_STRING("1714000000.125", streamed(1714000000.125).c_str());
+    TEST_ASSERT_EQUAL_STRING("null", streamed(NAN).c_str());
+}
+
+static void test_abort_drops_the_rest() {
+    StringPrint out;
+    JsonStreamWriter json(out);
+    json.beginObject();
+    json.value("steps", 12);
+    json.abort();
+    json.value("times", 0.5f);
+    json.endObject();
+    TEST_ASSERT_TRUE(json.aborted());
+    TEST_ASSERT_EQUAL_STRING("{\"steps\":12", out.text.c_str());
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_floats_read_back_exactly);
+    RUN_TEST(test_doubles_read_back_exactly);
+    RUN_TEST(test_numbers_stay_short);
+    RUN_TEST(test_abort_drops_the_rest);
+    return UNITY_END();
+}
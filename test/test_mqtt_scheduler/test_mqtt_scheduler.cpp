@@ -0,0 +1,166 @@
+#include <string>
+#include <unity.h>
+#include <vector>
+
+#include <mqtt_scheduler.cpp>
+#include <mqtt_spool.cpp>
+
+// The scheduler worker publishing through the client stand-in, with the default rates and slots
+
+using namespace mqtt_scheduler;
+
+static PsychicMqttClient client;
+
+static Queue queue(Priority priority) {
+    xSemaphoreTake(mutex, portMAX_DELAY);
+    Queue copy = queues[priority];
+    xSemaphoreGive(mutex);
+    return copy;
+}
+
+// Drops whatever a test left queued
+static void clearQueues() {
+    xSemaphoreTake(mutex, portMAX_DELAY);
+    for (Queue &queue : queues) {
+        while (queue.head) release(pop(queue));
+    }
+    xSemaphoreGive(mutex);
+}
+
+template <typename Condition>
+static bool waitFor(Condition condition, uint32_t ms = 2000) {
+    uint32_t start = millis();
+    while (!condition()) {
+        if (millis() - start > ms) return false;
+        delay(1);
+    }
+    return true;
+}
+
+// Collects what the client published until there are count messages
+static void receive(std::vector<PsychicMqttClient::Message> &messages, size_t count) {
+    waitFor([&] {
+        for (auto &message : client.take()) messages.push_back(message);
+        return messages.size() >= count;
+    });
+}
+
+static bool send(Priority priority, const std::string &topic, const std::string &payload) {
+    return mqtt_scheduler::publish(priority, topic.c_str(), 0, false, payload.c_str(), payload.size());
+}
+
+void setUp() {}
+void tearDown() { clearQueues(); }
+
+static void test_coalesces_state_by_topic() {
+    client.disconnect();
+    for (int i = 0; i < 100; i++) {
+        TEST_ASSERT_TRUE(send(PRIORITY_STATE, "state/" + std::to_string(i % 3), "value " + std::to_string(i)));
+    }
+    TEST_ASSERT_EQUAL_size_t(3, queue(PRIORITY_STATE).depth);
+    TEST_ASSERT_EQUAL_UINT32(97, queue(PRIORITY_STATE).coalesced);
+
+    // the latest payload of each topic, in the order the topics were first queued
+    client.connect();
+    std::vector<PsychicMqttClient::Message> messages;
+    receive(messages, 3);
+    TEST_ASSERT_EQUAL_size_t(3, messages.size());
+    TEST_ASSERT_EQUAL_STRING("state/0", messages[0].topic.c_str());
+    TEST_ASSERT_EQUAL_STRING("value 99", messages[0].payload.c_str());
+    TEST_ASSERT_EQUAL_STRING("value 97", messages[1].payload.c_str());
+    TEST_ASSERT_EQUAL_STRING("value 98", messages[2].payload.c_str());
+}
+
+static void test_higher_class_first() {
+    client.disconnect();
+    TEST_ASSERT_TRUE(send(PRIORITY_DIAGNOSTICS, "diagnostics", "queued first"));
+    TEST_ASSERT_TRUE(send(PRIORITY_STATE, "state", "queued second"));
+    client.connect();
+    std::vector<PsychicMqttClient::Message> messages;
+    receive(messages, 2);
+    TEST_ASSERT_EQUAL_size_t(2, messages.size());
+    TEST_ASSERT_EQUAL_STRING("state", messages[0].topic.c_str());
+    TEST_ASSERT_EQUAL_STRING("diagnostics", messages[1].topic.c_str());
+}
+
+static void test_refused_publish_counts_failed() {
+    uint32_t failed = queue(PRIORITY_STATE).failed, published = queue(PRIORITY_STATE).published;
+    client.refuse = true;
+    TEST_ASSERT_TRUE(send(PRIORITY_STATE, "state", "refused"));
+    TEST_ASSERT_TRUE(waitFor([&] { return queue(PRIORITY_STATE).failed == failed + 1; }));
+    client.refuse = false;
+    TEST_ASSERT_EQUAL_UINT32(published, queue(PRIORITY_STATE).published);
+    TEST_ASSERT_EQUAL_size_t(0, queue(PRIORITY_STATE).depth);
+}
+
+static void test_token_bucket_caps_the_rate() {
+    // a full bucket, then a burst of ten topics
+    delay(1000 * MQTT_SCHEDULER_STATE_BURST / MQTT_SCHEDULER_STATE_RATE + 100);
+    uint32_t start = millis();
+    for (int i = 0; i < 10; i++) TEST_ASSERT_TRUE(send(PRIORITY_STATE, "state/" + std::to_string(i), "value"));
+    delay(100);
+    std::vector<PsychicMqttClient::Message> messages = client.take();
+    TEST_ASSERT_TRUE(messages.size() >= MQTT_SCHEDULER_STATE_BURST);
+    TEST_ASSERT_TRUE(messages.size() <= MQTT_SCHEDULER_STATE_BURST + 1);
+
+    // the other five at the rate
+    receive(messages, 10);
+    TEST_ASSERT_EQUAL_size_t(10, messages.size());
+    TEST_ASSERT_TRUE(millis() - start >= 1000 * (10 - MQTT_SCHEDULER_STATE_BURST) / MQTT_SCHEDULER_STATE_RATE - 100);
+}
+
+static void test_full_queue_pushes_out_lower_classes() {
+    client.disconnect();
+    uint32_t dropped = queue(PRIORITY_DIAGNOSTICS).dropped;
+    for (int i = 0; i < MQTT_SCHEDULER_SLOTS; i++) {
+        TEST_ASSERT_TRUE(send(PRIORITY_DIAGNOSTICS, "diagnostics/" + std::to_string(i), "value"));
+    }
+    // nothing below diagnostics to push out
+    TEST_ASSERT_FALSE(send(PRIORITY_DIAGNOSTICS, "diagnostics/full", "value"));
+    TEST_ASSERT_EQUAL_UINT32(dropped + 1, queue(PRIORITY_DIAGNOSTICS).dropped);
+
+    // state takes the slot of the oldest diagnostics message
+    TEST_ASSERT_TRUE(send(PRIORITY_STATE, "state", "value"));
+    Queue diagnostics = queue(PRIORITY_DIAGNOSTICS);
+    TEST_ASSERT_EQUAL_UINT32(dropped + 2, diagnostics.dropped);
+    TEST_ASSERT_EQUAL_size_t(MQTT_SCHEDULER_SLOTS - 1, diagnostics.depth);
+    TEST_ASSERT_EQUAL_STRING("diagnostics/1", diagnostics.head->data);
+    TEST_ASSERT_EQUAL_size_t(1, queue(PRIORITY_STATE).depth);
+
+    // coalescing needs no slot
+    TEST_ASSERT_TRUE(send(PRIORITY_DIAGNOSTICS, "diagnostics/5", "newer"));
+}
+
+static void test_telemetry_is_spooled_offline() {
+    client.disconnect();
+    uint32_t published = queue(PRIORITY_TELEMETRY).published;
+    TEST_ASSERT_TRUE(send(PRIORITY_TELEMETRY, "steps", "value"));
+    TEST_ASSERT_TRUE(waitFor([&] { return queue(PRIORITY_TELEMETRY).published == published + 1; }));
+    TEST_ASSERT_TRUE(client.take().empty());
+    TEST_ASSERT_FALSE(mqtt_spool::empty());
+
+    client.connect();
+    std::vector<PsychicMqttClient::Message> messages;
+    TEST_ASSERT_TRUE(waitFor([&] {
+        mqtt_spool::loop();
+        messages = client.take();
+        return !messages.empty();
+    }));
+    TEST_ASSERT_EQUAL_STRING("steps", messages[0].topic.c_str());
+    client.acknowledge(messages[0].msgId);
+    mqtt_spool::loop();
+    TEST_ASSERT_TRUE(mqtt_spool::empty());
+}
+
+int main(int argc, char **argv) {
+    mqtt_spool::begin(&client);
+    mqtt_scheduler::begin(&client);
+    UNITY_BEGIN();
+    RUN_TEST(test_coalesces_state_by_topic);
+    RUN_TEST(test_higher_class_first);
+    RUN_TEST(test_refused_publish_counts_failed);
+    RUN_TEST(test_token_bucket_caps_the_rate);
+    RUN_TEST(test_full_queue_pushes_out_lower_classes);
+    RUN_TEST(test_telemetry_is_spooled_offline);
+    return UNITY_END();
+}
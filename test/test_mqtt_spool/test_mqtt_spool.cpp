@@ -0,0 +1,238 @@
+#include <string>
+#include <unity.h>
+#include <vector>
+
+// Small spools, so a few messages overflow the RAM and the file, and acks time out quickly
+#define MQTT_SPOOL_RAM_SIZE 128
+#define MQTT_SPOOL_FILE_SIZE 512
+#define MQTT_SPOOL_DRAIN_INTERVAL 0
+#define MQTT_SPOOL_ACK_TIMEOUT 50
+
+#include <mqtt_spool.cpp>
+
+// The ring of spooled messages on a buffer, and the spool publishing through the client stand-in
+
+using mqtt_spool::Header;
+using mqtt_spool::Ring;
+
+struct BufferStorage {
+    uint8_t data[64];
+    bool fail {false};
+
+    bool read(size_t offset, void *out, size_t len) {
+        memcpy(out, data + offset, len);
+        return !fail;
+    }
+
+    bool write(size_t offset, const void *in, size_t len) {
+        if (fail) return false;
+        memcpy(data + offset, in, len);
+        return true;
+    }
+};
+
+// sizeof(Header) + 1 + 9 bytes, four of them fill the buffer
+static std::string payload(int i) {
+    char text[10];
+    snprintf(text, sizeof(text), "message%02d", i);
+    return text;
+}
+
+static bool push(Ring<BufferStorage> &ring, int i) {
+    std::string text = payload(i);
+    return ring.push({1, (uint16_t)text.size(), false}, "t", text.c_str());
+}
+
+// Payload of the oldest message, which is popped
+static std::string pop(Ring<BufferStorage> &ring) {
+    Header header;
+    char buffer[64];
+    if (!ring.front(header, buffer)) return "";
+    ring.pop();
+    return std::string(buffer + header.topicLen, header.payloadLen);
+}
+
+static PsychicMqttClient client;
+
+static void publish(int i, int qos = 0) {
+    std::string text = payload(i) + std::string(15, '.'); // 32 bytes spooled, four fit in RAM
+    TEST_ASSERT_TRUE(mqtt_spool::publish("t", qos, false, text.c_str(), text.size()));
+}
+
+// Runs the drain, acknowledging every message, and adds the payloads to sent in the order they were sent
+static void drain(std::vector<std::string> &sent) {
+    for (int i = 0; i < 1000; i++) {
+        mqtt_spool::loop();
+        std::vector<PsychicMqttClient::Message> messages = client.take();
+        if (messages.empty()) {
+            if (mqtt_spool::empty()) break;
+            continue;
+        }
+        for (const auto &message : messages) {
+            TEST_ASSERT_EQUAL_INT(1, message.qos);
+            sent.push_back(message.payload.substr(0, 9));
+            client.acknowledge(message.msgId);
+        }
+    }
+    TEST_ASSERT_TRUE(mqtt_spool::empty());
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_ring_keeps_the_order() {
+    BufferStorage storage;
+    Ring<BufferStorage> ring(storage, sizeof(storage.data));
+    for (int i = 0; i < 3; i++) TEST_ASSERT_TRUE(push(ring, i));
+    TEST_ASSERT_EQUAL_size_t(3, ring.count());
+    TEST_ASSERT_EQUAL_size_t(3 * (sizeof(Header) + 10), ring.bytes());
+    for (int i = 0; i < 3; i++) TEST_ASSERT_EQUAL_STRING(payload(i).c_str(), pop(ring).c_str());
+    TEST_ASSERT_EQUAL_size_t(0, ring.count());
+    TEST_ASSERT_EQUAL_size_t(0, ring.bytes());
+    TEST_ASSERT_EQUAL_STRING("", pop(ring).c_str());
+}
+
+static void test_ring_wraps() {
+    BufferStorage storage;
+    Ring<BufferStorage> ring(storage, sizeof(storage.data));
+    for (int i = 0; i < 4; i++) TEST_ASSERT_TRUE(push(ring, i));
+    TEST_ASSERT_EQUAL_STRING(payload(0).c_str(), pop(ring).c_str());
+    TEST_ASSERT_EQUAL_STRING(payload(1).c_str(), pop(ring).c_str());
+
+    // starts over at 0 in front of the oldest message
+    TEST_ASSERT_TRUE(push(ring, 4));
+    TEST_ASSERT_TRUE(push(ring, 5));
+    for (int i = 2; i < 6; i++) TEST_ASSERT_EQUAL_STRING(payload(i).c_str(), pop(ring).c_str());
+
+    // after the end of the data was reached the ring is used from 0 again
+    for (int i = 6; i < 10; i++) TEST_ASSERT_TRUE(push(ring, i));
+    for (int i = 6; i < 10; i++) TEST_ASSERT_EQUAL_STRING(payload(i).c_str(), pop(ring).c_str());
+}
+
+static void test_ring_refuses_when_full() {
+    BufferStorage storage;
+    Ring<BufferStorage> ring(storage, sizeof(storage.data));
+    for (int i = 0; i < 4; i++) TEST_ASSERT_TRUE(push(ring, i));
+    TEST_ASSERT_FALSE(push(ring, 4));
+
+    // wrapped, the head runs into the oldest message
+    pop(ring);
+    TEST_ASSERT_TRUE(push(ring, 4));
+    TEST_ASSERT_FALSE(push(ring, 5));
+    TEST_ASSERT_EQUAL_size_t(4, ring.count());
+    for (int i = 1; i < 5; i++) TEST_ASSERT_EQUAL_STRING(payload(i).c_str(), pop(ring).c_str());
+
+    // a message larger than the ring never fits
+    std::string large(sizeof(storage.data), 'x');
+    TEST_ASSERT_FALSE(ring.push({1, (uint16_t)large.size(), false}, "t", large.c_str()));
+}
+
+static void test_ring_storage_failure() {
+    BufferStorage storage;
+    Ring<BufferStorage> ring(storage, sizeof(storage.data));
+    TEST_ASSERT_TRUE(push(ring, 0));
+    storage.fail = true;
+    TEST_ASSERT_FALSE(push(ring, 1));
+    TEST_ASSERT_EQUAL_size_t(1, ring.count());
+    // a message which can't be read back is not sent, the ring starts over
+    Header header;
+    char buffer[64];
+    TEST_ASSERT_FALSE(ring.front(header, buffer));
+    ring.pop();
+    TEST_ASSERT_EQUAL_size_t(0, ring.count());
+}
+
+static void test_publishes_directly_while_connected() {
+    mqtt_spool::begin(&client);
+    client.connect();
+    publish(0, 0);
+    publish(1, 1);
+    std::vector<PsychicMqttClient::Message> messages = client.take();
+    TEST_ASSERT_EQUAL_size_t(2, messages.size());
+    TEST_ASSERT_EQUAL_INT(0, messages[0].qos);
+    TEST_ASSERT_EQUAL_INT(1, messages[1].qos);
+    TEST_ASSERT_TRUE(mqtt_spool::empty());
+}
+
+static void test_drains_in_order_with_qos_1() {
+    client.disconnect();
+    for (int i = 0; i < 3; i++) publish(i);
+    TEST_ASSERT_TRUE(client.take().empty());
+
+    // one at a time, the next one only once the previous one was acknowledged
+    client.connect();
+    mqtt_spool::loop();
+    std::vector<PsychicMqttClient::Message> messages = client.take();
+    TEST_ASSERT_EQUAL_size_t(1, messages.size());
+    mqtt_spool::loop();
+    TEST_ASSERT_TRUE(client.take().empty());
+    client.acknowledge(messages[0].msgId);
+
+    // new messages queue up behind the spooled ones
+    publish(3);
+    std::vector<std::string> sent;
+    drain(sent);
+    TEST_ASSERT_EQUAL_size_t(3, sent.size());
+    for (int i = 0; i < 3; i++) TEST_ASSERT_EQUAL_STRING(payload(i + 1).c_str(), sent[i].c_str());
+}
+
+static void test_resends_without_ack() {
+    client.disconnect();
+    publish(0);
+    client.connect();
+    mqtt_spool::loop();
+    std::vector<PsychicMqttClient::Message> first = client.take();
+    TEST_ASSERT_EQUAL_size_t(1, first.size());
+
+    // an ack of another message doesn't count
+    client.acknowledge(first[0].msgId + 100);
+    delay(MQTT_SPOOL_ACK_TIMEOUT + 10);
+    mqtt_spool::loop();
+    std::vector<PsychicMqttClient::Message> again = client.take();
+    TEST_ASSERT_EQUAL_size_t(1, again.size());
+    TEST_ASSERT_EQUAL_STRING(first[0].payload.c_str(), again[0].payload.c_str());
+    client.acknowledge(again[0].msgId);
+    std::vector<std::string> sent;
+    drain(sent);
+    TEST_ASSERT_TRUE(sent.empty());
+}
+
+static void test_refused_publish_is_spooled() {
+    client.refuse = true;
+    publish(0);
+    TEST_ASSERT_FALSE(mqtt_spool::empty());
+    // refused while draining as well, counted and sent again after the ack timeout
+    mqtt_spool::loop();
+    TEST_ASSERT_EQUAL_UINT32(1, mqtt_spool::failed);
+    client.refuse = false;
+    delay(MQTT_SPOOL_ACK_TIMEOUT + 10);
+    std::vector<std::string> sent;
+    drain(sent);
+    TEST_ASSERT_EQUAL_size_t(1, sent.size());
+}
+
+static void test_overflow_drops_the_oldest_in_the_file() {
+    // 4 messages fit in RAM and 16 in the file, the first 10 in the file are dropped
+    client.disconnect();
+    for (int i = 0; i < 30; i++) publish(i);
+    client.connect();
+    std::vector<std::string> sent;
+    drain(sent);
+    TEST_ASSERT_EQUAL_size_t(20, sent.size());
+    for (int i = 0; i < 4; i++) TEST_ASSERT_EQUAL_STRING(payload(i).c_str(), sent[i].c_str());
+    for (int i = 4; i < 20; i++) TEST_ASSERT_EQUAL_STRING(payload(i + 10).c_str(), sent[i].c_str());
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_ring_keeps_the_order);
+    RUN_TEST(test_ring_wraps);
+    RUN_TEST(test_ring_refuses_when_full);
+    RUN_TEST(test_ring_storage_failure);
+    RUN_TEST(test_publishes_directly_while_connected);
+    RUN_TEST(test_drains_in_order_with_qos_1);
+    RUN_TEST(test_resends_without_ack);
+    RUN_TEST(test_refused_publish_is_spooled);
+    RUN_TEST(test_overflow_drops_the_oldest_in_the_file);
+    return UNITY_END();
+}
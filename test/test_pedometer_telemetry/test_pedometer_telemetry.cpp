@@ -0,0 +1,129 @@
+#include <algorithm>
+#include <string>
+#include <unity.h>
+#include <vector>
+
+#define PEDOMETER_TELEMETRY_TOPIC "pedometer/test"
+
+#include <mqtt_scheduler.cpp>
+#include <mqtt_spool.cpp>
+#include <pedometer_telemetry.cpp>
+
+// Steps batched into compact messages through the scheduler and the client stand-in, with the clock moved
+// ahead instead of walking, and the snapshot requests
+
+#define STEPS 1000
+#define CADENCE_MS 300
+
+// The topic has no placeholders, the device id isn't known on the host
+String SettingValue::format(String value) { return value; }
+
+static PsychicMqttClient client;
+static PedoMeterTelemetry telemetry;
+static StepEventLog<256> events;
+
+template <typename Condition>
+static bool waitFor(Condition condition, uint32_t ms = 2000) {
+    uint32_t start = millis();
+    while (!condition()) {
+        if (millis() - start > ms) return false;
+        delay(1);
+    }
+    return true;
+}
+
+// Waits until the scheduler handed the queued telemetry to the client
+static void sent() {
+    waitFor([] {
+        xSemaphoreTake(mqtt_scheduler::mutex, portMAX_DELAY);
+        bool empty = !mqtt_scheduler::queues[mqtt_scheduler::PRIORITY_TELEMETRY].head;
+        xSemaphoreGive(mqtt_scheduler::mutex);
+        return empty;
+    });
+}
+
+static std::vector<PsychicMqttClient::Message> on(const std::vector<PsychicMqttClient::Message> &messages,
+                                                  const char *topic) {
+    std::vector<PsychicMqttClient::Message> matching;
+    for (const auto &message : messages) {
+        if (message.topic == topic) matching.push_back(message);
+    }
+    return matching;
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_steps_are_batched() {
+    client.take();
+    telemetry.add(events.append(StepEventType::SESSION_START, 1700000000));
+    for (int i = 0; i < STEPS; i++) {
+        hostClockAhead += CADENCE_MS;
+        telemetry.loop();
+        telemetry.add(events.append(StepEventType::STEP, 1700000000 + i, 0.3f + (i % 50) * 0.2f));
+        sent();
+    }
+    hostClockAhead += PEDOMETER_TELEMETRY_FLUSH_MS;
+    telemetry.loop();
+    telemetry.add(events.append(StepEventType::SESSION_END, 1700001000));
+    sent();
+
+    std::vector<PsychicMqttClient::Message> messages = client.take();
+    std::vector<PsychicMqttClient::Message> steps = on(messages, "pedometer/test/steps");
+    std::vector<PsychicMqttClient::Message> sessions = on(messages, "pedometer/test/session");
+    size_t bytes = 0, counted = 0;
+    for (const auto &message : steps) {
+        TEST_ASSERT_EQUAL_INT(0, message.qos);
+        bytes += message.payload.size();
+        counted += std::count(message.payload.begin(), message.payload.end(), ',') - 1;
+    }
+    printf("%d steps every %d ms: %u messages, %u bytes, %.1f bytes per step\n", STEPS, CADENCE_MS,
+           (unsigned)steps.size(), (unsigned)bytes, (double)bytes / STEPS);
+
+    // a message at the latest after the flush time, every step in one of them
+    TEST_ASSERT_EQUAL_size_t(STEPS, counted);
+    TEST_ASSERT_TRUE(steps.size() <= STEPS * CADENCE_MS / PEDOMETER_TELEMETRY_FLUSH_MS + 1);
+    TEST_ASSERT_TRUE(bytes <= STEPS * 12);
+    TEST_ASSERT_EQUAL_size_t(2, sessions.size());
+    TEST_ASSERT_EQUAL_INT(1, sessions[1].qos);
+    TEST_ASSERT_TRUE(sessions[1].payload.find("\"steps\":1000}") != std::string::npos);
+}
+
+static void test_full_batch_is_sent_right_away() {
+    client.take();
+    for (int i = 0; i < PEDOMETER_TELEMETRY_BATCH; i++) {
+        telemetry.add(events.append(StepEventType::STEP, 1700002000, 0.5f));
+    }
+    sent();
+    std::vector<PsychicMqttClient::Message> steps = on(client.take(), "pedometer/test/steps");
+    TEST_ASSERT_EQUAL_size_t(1, steps.size());
+    TEST_ASSERT_TRUE(steps[0].payload.find("[500,500,") != std::string::npos);
+}
+
+static void test_snapshot_requested_once() {
+    // subscribed on connect
+    TEST_ASSERT_EQUAL_size_t(1, client.subscriptions.size());
+    TEST_ASSERT_EQUAL_STRING("pedometer/test/snapshot/get", client.subscriptions[0].c_str());
+
+    client.receive("pedometer/test/snapshot/get", "");
+    TEST_ASSERT_TRUE(telemetry.snapshotRequested());
+    TEST_ASSERT_FALSE(telemetry.snapshotRequested());
+
+    // retained requests and other topics don't count
+    client.receive("pedometer/test/snapshot/get", "", true);
+    client.receive("pedometer/test/snapshot", "");
+    client.receive("pedometer/other/snapshot/get", "");
+    TEST_ASSERT_FALSE(telemetry.snapshotRequested());
+}
+
+int main(int argc, char **argv) {
+    mqtt_spool::begin(&client);
+    mqtt_scheduler::begin(&client);
+    telemetry.begin(&client);
+    client.connect();
+    UNITY_BEGIN();
+    RUN_TEST(test_steps_are_batched);
+    RUN_TEST(test_full_batch_is_sent_right_away);
+    RUN_TEST(test_snapshot_requested_once);
+    return UNITY_END();
+}
@@ -0,0 +1,118 @@
+#include <StatefulService.h>
+#include <freertos/task.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <unity.h>
+#include <vector>
+
+#include <update_dispatcher.cpp>
+
+// Readers against one writer for each lock policy, every reader checks it never sees half an update.
+// The numbers are printed for comparison, only torn reads fail the test.
+
+#define READERS 3
+#define RUN_MS 500
+#define WRITE_PAUSE_US 200
+
+// Like the pedometer totals, all members are written in one update
+struct Counters {
+    uint32_t a {0};
+    uint32_t b {0};
+    float c {0};
+    uint32_t d {0};
+
+    bool consistent() const { return a == b && b == d && c == (float)a; }
+};
+
+struct Result {
+    uint64_t reads {0};
+    uint32_t torn {0};
+    uint64_t writes {0};
+    uint64_t writerWaitMaxUs {0};
+    uint64_t writerWaitTotalUs {0};
+};
+
+template <typename Lock>
+static Result run() {
+    StatefulService<Counters, Lock> service;
+    std::atomic<bool> stop {false};
+    std::vector<Result> readers(READERS);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < READERS; i++) {
+        threads.emplace_back([&service, &stop, &result = readers[i]] {
+            while (!stop.load(std::memory_order_relaxed)) {
+                service.read([&](Counters &state) {
+                    if (!state.consistent()) result.torn++;
+                });
+                result.reads++;
+            }
+        });
+    }
+
+    Result result;
+    auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(RUN_MS);
+    while (std::chrono::steady_clock::now() < end) {
+        auto start = std::chrono::steady_clock::now();
+        service.updateWithoutPropagation([&](Counters &state) {
+            // the wait is until the writer is inside, the update itself is not timed
+            auto wait = std::chrono::steady_clock::now() - start;
+            uint64_t waited = std::chrono::duration_cast<std::chrono::microseconds>(wait).count();
+            result.writerWaitMaxUs = std::max(result.writerWaitMaxUs, waited);
+            result.writerWaitTotalUs += waited;
+            state.a++;
+            state.b++;
+            state.c = (float)state.a;
+            state.d++;
+            return StateUpdateResult::CHANGED;
+        });
+        result.writes++;
+        std::this_thread::sleep_for(std::chrono::microseconds(WRITE_PAUSE_US));
+    }
+    stop = true;
+    for (auto &thread : threads) thread.join();
+    for (const Result &reader : readers) {
+        result.reads += reader.reads;
+        result.torn += reader.torn;
+    }
+    return result;
+}
+
+static void report(const char *policy, const Result &result) {
+    printf("%-18s %10llu reads/s  %6llu writes  writer wait avg %5llu us  max %6llu us  torn %llu\n", policy,
+           (unsigned long long)(result.reads * 1000 / RUN_MS), (unsigned long long)result.writes,
+           (unsigned long long)(result.writes ? result.writerWaitTotalUs / result.writes : 0),
+           (unsigned long long)result.writerWaitMaxUs, (unsigned long long)result.torn);
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_recursive_lock() {
+    Result result = run<RecursiveStateLock>();
+    report("RecursiveStateLock", result);
+    TEST_ASSERT_EQUAL_UINT32(0, result.torn);
+    TEST_ASSERT_TRUE(result.reads > 0);
+}
+
+static void test_shared_lock() {
+    Result result = run<SharedStateLock>();
+    report("SharedStateLock", result);
+    TEST_ASSERT_EQUAL_UINT32(0, result.torn);
+    TEST_ASSERT_TRUE(result.reads > 0);
+}
+
+static void test_seq_lock() {
+    Result result = run<SeqStateLock>();
+    report("SeqStateLock", result);
+    TEST_ASSERT_EQUAL_UINT32(0, result.torn);
+    TEST_ASSERT_TRUE(result.reads > 0);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_recursive_lock);
+    RUN_TEST(test_shared_lock);
+    RUN_TEST(test_seq_lock);
+    return UNITY_END();
+}
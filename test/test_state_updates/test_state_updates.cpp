@@ -0,0 +1,145 @@
+#include <StatefulService.h>
+#include <atomic>
+#include <json_pool.h>
+#include <unity.h>
+
+#include <json_pool.cpp>
+#include <update_dispatcher.cpp>
+
+// Counts the calls into the C heap, which new and delete go through as well
+#ifdef __GLIBC__
+extern "C" void *__libc_malloc(size_t size);
+extern "C" void *__libc_calloc(size_t count, size_t size);
+extern "C" void *__libc_realloc(void *pointer, size_t size);
+extern "C" void __libc_free(void *pointer);
+
+static std::atomic<bool> counting {false};
+static std::atomic<size_t> heapCalls {0};
+
+extern "C" void *malloc(size_t size) {
+    if (counting) heapCalls++;
+    return __libc_malloc(size);
+}
+
+extern "C" void *calloc(size_t count, size_t size) {
+    if (counting) heapCalls++;
+    return __libc_calloc(count, size);
+}
+
+extern "C" void *realloc(void *pointer, size_t size) {
+    if (counting) heapCalls++;
+    return __libc_realloc(pointer, size);
+}
+
+extern "C" void free(void *pointer) { __libc_free(pointer); }
+#endif
+
+struct Light {
+    bool on {false};
+    uint8_t brightness {0};
+
+    static void read(Light &state, JsonObject &root) {
+        root["on"] = state.on;
+        root["brightness"] = state.brightness;
+    }
+
+    static StateUpdateResult update(JsonObject &root, Light &state) {
+        field_mask_t changed = 0;
+        updateField(state.on, root["on"] | state.on, 1, changed);
+        updateField(state.brightness, root["brightness"] | state.brightness, 2, changed);
+        return StateUpdateResult::changed(changed);
+    }
+};
+
+class LightService : public StatefulService<Light> {};
+
+// What EventEndpoint::syncState and MqttEndpoint::publish do with every propagated update
+struct Endpoint {
+    LightService *service;
+    JsonStateReader<Light> reader {Light::read};
+    size_t syncs {0};
+    char last[64] {};
+
+    void sync() {
+        JsonDocument doc(json_pool::allocator(json_pool::SITE_EVENT));
+        JsonObject root = doc.to<JsonObject>();
+        service->read(root, reader);
+        json_pool::Serialized payload(doc, json_pool::SITE_EVENT);
+        snprintf(last, sizeof(last), "%s", payload.c_str());
+        syncs++;
+    }
+};
+
+void setUp() {}
+void tearDown() {}
+
+static void test_update_path_allocates_nothing() {
+#ifndef __GLIBC__
+    TEST_IGNORE_MESSAGE("counting heap calls needs glibc");
+#else
+    LightService service;
+    Endpoint event {&service};
+    Endpoint mqtt {&service};
+    size_t hooks = 0;
+    service.addUpdateHandler([&event](origin_id_t originId, field_mask_t fields) { event.sync(); }, false);
+    service.addUpdateHandler([&mqtt](origin_id_t originId, field_mask_t fields) { mqtt.sync(); }, false);
+    service.addHookHandler([&hooks](origin_id_t originId, StateUpdateResult &result) { hooks++; });
+    JsonStateUpdater<Light> updater = Light::update;
+
+    xTaskGetCurrentTaskHandle(); // the stubbed task handle is created on first use
+    heapCalls = 0;
+    counting = true;
+    for (int i = 0; i < 100; i++) {
+        // an HTTP or socket update, parsed into a pooled document like the request bodies
+        JsonDocument request(json_pool::allocator(json_pool::SITE_HTTP));
+        deserializeJson(request, i % 2 ? "{\"on\":true,\"brightness\":42}" : "{\"on\":false,\"brightness\":7}");
+        JsonObject root = request.as<JsonObject>();
+        service.update(root, updater, ORIGIN_HTTP);
+
+        service.update(
+            [](Light &state) {
+                state.brightness++;
+                return StateUpdateResult::changed(2);
+            },
+            ORIGIN_MQTT);
+    }
+    counting = false;
+
+    TEST_ASSERT_EQUAL_size_t_MESSAGE(0, heapCalls, "heap calls on the update path");
+    TEST_ASSERT_EQUAL_size_t(200, event.syncs);
+    TEST_ASSERT_EQUAL_size_t(200, mqtt.syncs);
+    TEST_ASSERT_EQUAL_size_t(200, hooks);
+    TEST_ASSERT_EQUAL_STRING("{\"on\":true,\"brightness\":43}", event.last);
+    TEST_ASSERT_EQUAL_STRING(event.last, mqtt.last);
+#endif
+}
+
+static void test_unchanged_update_skips_handlers() {
+    LightService service;
+    size_t calls = 0;
+    service.addUpdateHandler([&calls](origin_id_t originId) { calls++; });
+    service.update([](Light &state) { return StateUpdateResult::UNCHANGED; }, ORIGIN_HTTP);
+    TEST_ASSERT_EQUAL_size_t(0, calls);
+    service.update([](Light &state) { return StateUpdateResult::CHANGED; }, ORIGIN_HTTP);
+    TEST_ASSERT_EQUAL_size_t(1, calls);
+    TEST_ASSERT_EQUAL_UINT32(1, service.version());
+}
+
+static void test_handler_tables_are_fixed() {
+    LightService service;
+    update_handler_id_t first = service.addUpdateHandler([](origin_id_t originId) {});
+    for (size_t i = 1; i < STATE_MAX_UPDATE_HANDLERS; i++) {
+        TEST_ASSERT_NOT_EQUAL(0, service.addUpdateHandler([](origin_id_t originId) {}));
+    }
+    TEST_ASSERT_EQUAL(0, service.addUpdateHandler([](origin_id_t originId) {}));
+    service.removeUpdateHandler(first);
+    TEST_ASSERT_NOT_EQUAL(0, service.addUpdateHandler([](origin_id_t originId) {}));
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_update_path_allocates_nothing);
+    RUN_TEST(test_unchanged_update_skips_handlers);
+    RUN_TEST(test_handler_tables_are_fixed);
+    return UNITY_END();
+}
@@ -0,0 +1,102 @@
+#include <string>
+#include <unity.h>
+#include <vector>
+
+#include <domain/step_aggregate.h>
+
+// The hourly rollups against the raw steps they sum up, and the buckets cut at the end of the range
+
+struct StringPrint : Print {
+    std::string text;
+
+    size_t write(const uint8_t *buffer, size_t size) override {
+        text.append((const char *)buffer, size);
+        return size;
+    }
+};
+
+struct Step {
+    long timestamp;
+    float interval;
+};
+
+// A step every 10 s for the given hours, from the start of firstHour on
+static std::vector<Step> steps(long firstHour, long hours) {
+    std::vector<Step> steps;
+    for (long t = firstHour * SECONDS_PER_HOUR; t < (firstHour + hours) * SECONDS_PER_HOUR; t += 10) {
+        steps.push_back({t, 0.5f});
+    }
+    return steps;
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_rollups_sum_the_hours() {
+    StepRollups rollups;
+    for (const Step &step : steps(1000, 3)) rollups.add(step.timestamp, step.interval);
+    for (long hour = 1000; hour < 1003; hour++) {
+        TEST_ASSERT_NOT_NULL(rollups.at(hour));
+        TEST_ASSERT_EQUAL_UINT32(360, rollups.at(hour)->steps);
+        TEST_ASSERT_EQUAL_FLOAT(180, rollups.at(hour)->seconds);
+    }
+    TEST_ASSERT_NULL(rollups.at(1003));
+}
+
+static void test_rollups_clear_the_hours_passed() {
+    StepRollups rollups;
+    rollups.add(1000 * SECONDS_PER_HOUR, 0.5f);
+    // the same slot a window later, the old hour is gone and the one in between is empty
+    rollups.add((1000 + STEP_ROLLUP_HOURS) * SECONDS_PER_HOUR, 0.5f);
+    TEST_ASSERT_FALSE(rollups.covers(1000));
+    TEST_ASSERT_NULL(rollups.at(1000));
+    TEST_ASSERT_EQUAL_UINT32(1, rollups.at(1000 + STEP_ROLLUP_HOURS)->steps);
+    TEST_ASSERT_TRUE(rollups.at(1001)->empty());
+
+    // far ahead every slot is cleared
+    rollups.add((1000 + 10 * STEP_ROLLUP_HOURS) * SECONDS_PER_HOUR, 0.5f);
+    TEST_ASSERT_TRUE(rollups.at(1000 + 10 * STEP_ROLLUP_HOURS - 1)->empty());
+}
+
+static void test_rollups_ignore_negative_hours() {
+    StepRollups rollups;
+    TEST_ASSERT_FALSE(rollups.covers(-1));
+    TEST_ASSERT_NULL(rollups.at(-1));
+    rollups.add(-SECONDS_PER_HOUR, 0.5f);
+    TEST_ASSERT_TRUE(rollups.at(0)->empty());
+}
+
+static void test_rollups_match_the_steps() {
+    std::vector<Step> all = steps(1000, 4);
+    StepRollups rollups;
+    for (const Step &step : all) rollups.add(step.timestamp, step.interval);
+
+    // from an hour to the middle of the last one, like a request up to now
+    long from = 1000 * SECONDS_PER_HOUR, to = 1003 * SECONDS_PER_HOUR + 1800;
+    StringPrint raw, rolled;
+    JsonStreamWriter rawJson(raw), rolledJson(rolled);
+    StepAggregator fromSteps(from, to, 2 * SECONDS_PER_HOUR, 0.6f, rawJson);
+    StepAggregator fromRollups(from, to, 2 * SECONDS_PER_HOUR, 0.6f, rolledJson);
+    for (const Step &step : all) fromSteps.addStep(step.timestamp, step.interval);
+    for (long hour = 1000; hour < to / SECONDS_PER_HOUR; hour++) {
+        fromRollups.addBucket(hour * SECONDS_PER_HOUR, *rollups.at(hour));
+    }
+    long lastHour = to / SECONDS_PER_HOUR * SECONDS_PER_HOUR;
+    for (const Step &step : all) {
+        if (step.timestamp >= lastHour) fromRollups.addStep(step.timestamp, step.interval);
+    }
+    fromSteps.finish();
+    fromRollups.finish();
+    TEST_ASSERT_EQUAL_STRING(raw.text.c_str(), rolled.text.c_str());
+    // the second bucket ends at to with half of its last hour
+    TEST_ASSERT_TRUE(raw.text.find("[3607200,324,270,") != std::string::npos);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_rollups_sum_the_hours);
+    RUN_TEST(test_rollups_clear_the_hours_passed);
+    RUN_TEST(test_rollups_ignore_negative_hours);
+    RUN_TEST(test_rollups_match_the_steps);
+    return UNITY_END();
+}
@@ -0,0 +1,178 @@
+#include <StatefulService.h>
+#include <algorithm>
+#include <atomic>
+#include <freertos/task.h>
+#include <mutex>
+#include <thread>
+#include <unity.h>
+#include <vector>
+
+#include <update_dispatcher.cpp>
+
+// Update handlers run inline before begin() and on the worker after it, with a handler as slow as a LittleFS
+// write, and bursts coalesced into a single dispatch which sees the final state
+
+#define HANDLER_MS 20
+#define CALLS 50
+
+struct Counter {
+    int value {0};
+};
+
+class CounterService : public StatefulService<Counter> {
+  public:
+    StateUpdateResult set(int value, origin_id_t originId, field_mask_t fields = 1) {
+        return update(
+            [&](Counter &state) {
+                state.value = value;
+                return StateUpdateResult::changed(fields);
+            },
+            originId);
+    }
+
+    int value() {
+        int value;
+        read([&](const Counter &state) { value = state.value; });
+        return value;
+    }
+};
+
+// What the handlers of a service saw
+struct Seen {
+    std::mutex mutex;
+    size_t calls {0};
+    int value {0};
+    origin_id_t originId {ORIGIN_NONE};
+    field_mask_t fields {0};
+    std::thread::id thread;
+
+    void record(CounterService &service, origin_id_t origin, field_mask_t changed) {
+        int current = service.value();
+        std::lock_guard<std::mutex> lock(mutex);
+        calls++;
+        value = current;
+        originId = origin;
+        fields = changed;
+        thread = std::this_thread::get_id();
+    }
+
+    size_t count() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return calls;
+    }
+};
+
+static CounterService slowService, burstService, gateService;
+static Seen slowSeen, burstSeen;
+static std::atomic<bool> gateOpen {true};
+
+template <typename Condition>
+static bool waitFor(Condition condition, uint32_t ms = 5000) {
+    uint32_t start = millis();
+    while (!condition()) {
+        if (millis() - start > ms) return false;
+        delay(1);
+    }
+    return true;
+}
+
+// us the calls to update() took, the 99th percentile of them
+static uint32_t p99(std::vector<uint32_t> times) {
+    std::sort(times.begin(), times.end());
+    return times[times.size() * 99 / 100];
+}
+
+// Sets the values first to first + CALLS - 1
+static std::vector<uint32_t> timeUpdates(CounterService &service, int first) {
+    std::vector<uint32_t> times;
+    for (int i = 0; i < CALLS; i++) {
+        uint32_t start = micros();
+        service.set(first + i, ORIGIN_HTTP);
+        times.push_back(micros() - start);
+    }
+    return times;
+}
+
+// Holds the worker in the handlers of the gate service until the gate opens, so updates queue up behind it
+static void closeGate() {
+    gateOpen = false;
+    gateService.set(gateService.value() + 1, ORIGIN_NONE);
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_inline_before_begin() {
+    size_t calls = slowSeen.count();
+    uint32_t latency = p99(timeUpdates(slowService, 0));
+    printf("inline: update() p99 %u us\n", (unsigned)latency);
+    TEST_ASSERT_TRUE(latency >= HANDLER_MS * 1000);
+    TEST_ASSERT_EQUAL_size_t(calls + CALLS, slowSeen.count());
+    TEST_ASSERT_TRUE(slowSeen.thread == std::this_thread::get_id());
+}
+
+static void test_deferred_after_begin() {
+    update_dispatcher::begin();
+    uint32_t latency = p99(timeUpdates(slowService, CALLS));
+    printf("deferred: update() p99 %u us\n", (unsigned)latency);
+    TEST_ASSERT_TRUE(latency < HANDLER_MS * 1000 / 4);
+
+    // the handlers ran on the worker and the last dispatch saw the final state
+    TEST_ASSERT_TRUE(waitFor([] {
+        std::lock_guard<std::mutex> lock(slowSeen.mutex);
+        return slowSeen.value == 2 * CALLS - 1;
+    }));
+    std::lock_guard<std::mutex> lock(slowSeen.mutex);
+    TEST_ASSERT_TRUE(slowSeen.thread != std::this_thread::get_id());
+    TEST_ASSERT_EQUAL_INT(2 * CALLS - 1, slowSeen.value);
+}
+
+static void test_burst_is_one_dispatch_with_the_final_state() {
+    closeGate();
+    size_t calls = burstSeen.count();
+    for (int i = 0; i < CALLS; i++) burstService.set(i + 1, i % 2 ? ORIGIN_HTTP : ORIGIN_MQTT, 1 << (i % 4));
+    gateOpen = true;
+
+    TEST_ASSERT_TRUE(waitFor([&] { return burstSeen.count() > calls; }));
+    delay(HANDLER_MS);
+    std::lock_guard<std::mutex> lock(burstSeen.mutex);
+    TEST_ASSERT_EQUAL_size_t(calls + 1, burstSeen.calls);
+    TEST_ASSERT_EQUAL_INT(CALLS, burstSeen.value);
+    TEST_ASSERT_EQUAL_INT(ORIGIN_NONE, burstSeen.originId);
+    TEST_ASSERT_EQUAL_UINT32(0xF, burstSeen.fields);
+}
+
+static void test_burst_from_one_origin_keeps_it() {
+    closeGate();
+    size_t calls = burstSeen.count();
+    for (int i = 0; i < CALLS; i++) burstService.set(i + 100, ORIGIN_MQTT);
+    gateOpen = true;
+
+    TEST_ASSERT_TRUE(waitFor([&] { return burstSeen.count() > calls; }));
+    delay(HANDLER_MS);
+    std::lock_guard<std::mutex> lock(burstSeen.mutex);
+    TEST_ASSERT_EQUAL_size_t(calls + 1, burstSeen.calls);
+    TEST_ASSERT_EQUAL_INT(CALLS + 99, burstSeen.value);
+    TEST_ASSERT_EQUAL_INT(ORIGIN_MQTT, burstSeen.originId);
+}
+
+int main(int argc, char **argv) {
+    slowService.addUpdateHandler([](origin_id_t originId, field_mask_t fields) {
+        delay(HANDLER_MS);
+        slowSeen.record(slowService, originId, fields);
+    });
+    burstService.addUpdateHandler([](origin_id_t originId, field_mask_t fields) {
+        burstSeen.record(burstService, originId, fields);
+    });
+    gateService.addUpdateHandler([](origin_id_t, field_mask_t) { waitFor([] { return gateOpen.load(); }); });
+    slowService.deferUpdateHandlers();
+    burstService.deferUpdateHandlers();
+    gateService.deferUpdateHandlers();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_inline_before_begin);
+    RUN_TEST(test_deferred_after_begin);
+    RUN_TEST(test_burst_is_one_dispatch_with_the_final_state);
+    RUN_TEST(test_burst_from_one_origin_keeps_it);
+    return UNITY_END();
+}